@@ -0,0 +1,833 @@
+/*
+	Benchmarks of the genetic algorithms on the example problems.
+
+	g++ -O2 -std=c++14 -fopenmp -m64 benchmarks/benchmarks.cpp -o benchmarks.out && ./benchmarks.out
+*/
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <stdio.h>
+#include <vector>
+#include <unordered_map>
+
+#include "../biopharma_scheduling/nsgaii.h"
+#include "../biopharma_scheduling/executor.h"
+#include "../biopharma_scheduling/heuristics.h"
+#include "../biopharma_scheduling/metrics.h"
+#include "../biopharma_scheduling/scheduling_models.h"
+#include "../biopharma_scheduling/single_objective_ga.h"
+#include "../biopharma_scheduling/small_vector.h"
+
+
+int num_threads = -1;
+int num_seeds = 10, max_gens = 200, popsize = 100;
+
+int starting_length = 1;
+
+double p_xo = 0.108198;
+double p_product_mut = 0.041373;
+double p_plus_batch_mut = 0.608130;
+double p_minus_batch_mut = 0.765819;
+double p_gene_swap = 0.471346;
+
+double seeded_ratio = 0.5;
+
+/*
+	Heap allocations of the whole program, see GeneContainer_Benchmark. The
+	replacements are not inlined, so that GCC does not pair the malloc of one
+	with the free of the other as a mismatched new and free.
+*/
+std::atomic<long long> num_allocations(0);
+
+__attribute__((noinline)) void* operator new(size_t size)
+{
+	++num_allocations;
+
+	if (void *p = std::malloc(size ? size : 1)) {
+		return p;
+	}
+
+	throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+
+deterministic::SingleSiteSimpleInputData SingleSiteSimpleExample(
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives,
+	std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> constraints
+)
+{
+	std::vector<std::vector<double>> kg_demand = {
+		{ 0.0,0.0,3.1,0.0,0.0,3.1,0.0,3.1,3.1,3.1,0.0,6.2,6.2,3.1,6.2,0.0,3.1,9.3,0.0,6.2,6.2,0.0,6.2,9.3,0.0,9.3,6.2,3.1,6.2,3.1,0.0,9.3,6.2,9.3,6.2,0.0 },
+		{ 0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,6.2,0.0,0.0,0.0,0.0,0.0,6.2,0.0,0.0,0.0,0.0,0.0,0.0,6.2 },
+		{ 0.0,0.0,0.0,0.0,0.0,0.0,4.9,4.9,0.0,0.0,0.0,9.8,4.9,0.0,4.9,0.0,0.0,4.9,9.8,0.0,0.0,0.0,4.9,4.9,0.0,9.8,0.0,0.0,4.9,9.8,9.8,0.0,4.9,9.8,4.9,0.0 },
+		{ 0.0,5.5,5.5,0.0,5.5,5.5,5.5,5.5,5.5,0.0,11.0,5.5,0.0,5.5,5.5,11.0,5.5,5.5,0.0,5.5,5.5,5.5,11.0,5.5,0.0,11.0,0.0,11.0,5.5,5.5,0.0,11.0,11.0,0.0,5.5,5.5 }
+	};
+
+	std::vector<std::vector<double>> kg_inventory_target = {
+		{ 6.2,6.2,9.3,9.3,12.4,12.4,15.5,21.7,21.7,24.8,21.7,24.8,27.9,21.7,24.8,24.8,24.8,27.9,27.9,27.9,31.0,31.0,34.1,34.1,27.9,27.9,27.9,27.9,34.1,34.1,31.0,31.0,21.7,15.5,6.2,0.0 },
+		{ 0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2 },
+		{ 0.0,4.9,9.8,9.8,9.8,9.8,19.6,19.6,14.7,19.6,19.6,19.6,14.7,19.6,19.6,14.7,14.7,19.6,19.6,9.8,19.6,19.6,19.6,19.6,24.5,34.3,24.5,29.4,39.2,39.2,29.4,19.6,19.6,14.7,4.9,0.0 },
+		{ 22.0,27.5,27.5,27.5,27.5,33.0,33.0,27.5,27.5,27.5,38.5,33.0,33.0,33.0,33.0,33.0,27.5,33.0,33.0,33.0,38.5,33.0,38.5,33.0,33.0,33.0,33.0,44.0,33.0,33.0,33.0,33.0,22.0,11.0,11.0,5.5 },
+	};
+
+	std::vector<int> days_per_period = {
+		31,31,28,31,30,31,30,31,31,30,31,30,31,31,28,31,30,31,30,31,31,30,31,30,31,31,28,31,30,31,30,31,31,30,31,30
+	};
+
+	std::vector<double> kg_yield_per_batch = { 3.1, 6.2, 4.9, 5.5 };
+	std::vector<double> kg_storage_limits = { 250, 250, 250, 250 };
+	std::vector<double> kg_opening_stock = { 18.6, 0, 19.6, 32.0 };
+
+	std::vector<double> costs = { 1, 1, 1, 1 };
+
+	std::vector<int> inoculation_days = { 20, 15, 20, 26 };
+	std::vector<int> seed_days = { 11, 7, 11, 9 };
+	std::vector<int> production_days = { 14, 14, 14, 14 };
+	std::vector<int> usp_days = { 45, 36, 45, 49 };
+	std::vector<int> dsp_days = { 7, 11, 7, 7 };
+	std::vector<int> shelf_life_days = { 730, 730, 730, 730 };
+	std::vector<int> approval_days = { 90, 90, 90, 90 };
+	std::vector<int> min_batches_per_campaign = { 2, 2, 2, 3 };
+	std::vector<int> max_batches_per_campaign = { 50, 50, 50, 30 };
+	std::vector<int> batches_multiples_of_per_campaign = { 1, 1, 1, 3 };
+
+	std::vector<std::vector<int>> changeover_days = {
+		{ 0,  10, 16, 20 },
+		{ 16,  0, 16, 20 },
+		{ 16, 10,  0, 20 },
+		{ 18, 10, 18,  0 }
+	};
+
+	return deterministic::SingleSiteSimpleInputData(
+		objectives,
+		kg_demand,
+		days_per_period,
+
+		kg_opening_stock,
+		kg_yield_per_batch,
+		kg_storage_limits,
+
+		costs, costs, costs, costs, costs, costs,
+
+		inoculation_days,
+		seed_days,
+		production_days,
+		usp_days,
+		dsp_days,
+		approval_days,
+		shelf_life_days,
+		min_batches_per_campaign,
+		max_batches_per_campaign,
+		batches_multiples_of_per_campaign,
+		changeover_days,
+
+		&kg_inventory_target,
+		&constraints
+	);
+}
+
+/*
+	The example with the demands and the yields varying by up to 20% around their 
+	deterministic values.
+*/
+stochastic::SingleSiteSimpleInputData StochasticSingleSiteSimpleExample(
+	std::unordered_map<stochastic::OBJECTIVES, int> objectives,
+	std::unordered_map<stochastic::OBJECTIVES, std::pair<int, double>> constraints,
+	int num_mc_sims
+)
+{
+	auto example = SingleSiteSimpleExample({}, {});
+	auto scale = [](std::vector<double> values, double factor) {
+		for (auto &value : values) {
+			value *= factor;
+		}
+
+		return values;
+	};
+
+	std::vector<std::vector<double>> kg_demand_min, kg_demand_max;
+
+	for (const auto &kg_demand : example.kg_demand) {
+		kg_demand_min.push_back(scale(kg_demand, 0.8));
+		kg_demand_max.push_back(scale(kg_demand, 1.2));
+	}
+
+	return stochastic::SingleSiteSimpleInputData(
+		1,
+		num_mc_sims,
+
+		objectives,
+		example.days_per_period,
+
+		kg_demand_min,
+		example.kg_demand,
+		kg_demand_max,
+
+		scale(example.kg_yield_per_batch, 0.8),
+		example.kg_yield_per_batch,
+		scale(example.kg_yield_per_batch, 1.2),
+
+		example.kg_opening_stock,
+		example.kg_storage_limits,
+
+		example.inventory_penalty_per_kg,
+		example.backlog_penalty_per_kg,
+		example.production_cost_per_kg,
+		example.storage_cost_per_kg,
+		example.waste_cost_per_kg,
+		example.sell_price_per_kg,
+
+		example.inoculation_days,
+		example.seed_days,
+		example.production_days,
+		example.usp_days,
+		example.dsp_days,
+		example.approval_days,
+		example.shelf_life_days,
+		example.min_batches_per_campaign,
+		example.max_batches_per_campaign,
+		example.batches_multiples_of_per_campaign,
+		example.changeover_days,
+
+		&example.kg_inventory_target,
+		&constraints
+	);
+}
+
+/*
+	Number of generations it takes for the single-objective GA to find a feasible
+	solution with at least 'target' kg throughput, with random and heuristic initial
+	populations.
+*/
+void Det_SingleSiteSimple_HeuristicInit_Benchmark(double target)
+{
+	typedef types::SingleObjectiveChromosome<types::SingleSiteSimpleGene> Chromosome;
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+
+	std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> constraints;
+	constraints.emplace(deterministic::TOTAL_KG_BACKLOG, std::make_pair(-1, 0));
+	constraints.emplace(deterministic::TOTAL_KG_WASTE, std::make_pair(-1, 0));
+
+	auto input_data = SingleSiteSimpleExample(objectives, constraints);
+	deterministic::SingleSiteSimpleModel model(input_data);
+
+	auto heuristic_seeds = heuristics::Seeds<Chromosome>(input_data);
+	printf("%d heuristic seeds, seeded ratio %.2f, target %.1f kg\n\n", (int)heuristic_seeds.size(), seeded_ratio, target);
+	printf("%-10s %8s %10s %10s %10s\n", "init", "reached", "mean gens", "best kg", "seconds");
+
+	for (int heuristic = 0; heuristic != 2; ++heuristic) {
+		int num_reached = 0, total_gens = 0;
+		double best = 0.0;
+		auto start = std::chrono::system_clock::now();
+
+		for (int seed = 1; seed <= num_seeds; ++seed) {
+			algorithms::SingleObjectiveGA<Chromosome, deterministic::SingleSiteSimpleModel> ga(model, seed, num_threads);
+			ga.SetSeededRatio(seeded_ratio);
+
+			if (heuristic) {
+				ga.Init(popsize, heuristic_seeds, starting_length, p_xo, p_gene_swap, input_data.num_products, p_product_mut, p_plus_batch_mut, p_minus_batch_mut);
+			}
+			else {
+				ga.Init(popsize, starting_length, p_xo, p_gene_swap, input_data.num_products, p_product_mut, p_plus_batch_mut, p_minus_batch_mut);
+			}
+
+			int gen = 0;
+
+			for (; gen != max_gens; ++gen) {
+				auto top = ga.Top();
+
+				if (top.constraints == utils::Approx(0.0) && -top.objective >= target) {
+					break;
+				}
+
+				ga.Update();
+			}
+
+			if (gen != max_gens) {
+				++num_reached;
+			}
+
+			total_gens += gen;
+			best = std::max(best, -ga.Top().objective);
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - start;
+
+		printf(
+			"%-10s %5d/%-2d %10.1f %10.1f %10.2f\n",
+			heuristic ? "heuristic" : "random",
+			num_reached,
+			num_seeds,
+			(double)total_gens / num_seeds,
+			best,
+			elapsed.count()
+		);
+	}
+}
+
+/*
+	Time it takes to compute the exact hypervolume of random non-dominated fronts 
+	with 'front_size' points on the unit simplex.
+*/
+void Metrics_Hypervolume_Benchmark(int front_size, int repeats)
+{
+	printf("%-10s %10s %12s\n", "objectives", "points", "ms per call");
+
+	for (int num_objectives = 2; num_objectives <= 5; ++num_objectives) {
+		metrics::Points front(front_size, metrics::Point(num_objectives));
+		metrics::Point ref(num_objectives, 1.1);
+
+		for (auto &point : front) {
+			double sum = 0.0;
+
+			for (auto &x : point) {
+				x = utils::random();
+				sum += x;
+			}
+
+			for (auto &x : point) {
+				x /= sum;
+			}
+		}
+
+		double hv = 0.0;
+		auto start = std::chrono::system_clock::now();
+
+		for (int r = 0; r != repeats; ++r) {
+			hv += metrics::Hypervolume(front, ref);
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - start;
+
+		printf("%-10d %10d %12.3f\n", num_objectives, front_size, elapsed.count() * 1000 / repeats);
+	}
+}
+
+/*
+	Time it takes to get the non-dominated front of 'num_solutions' random solutions,
+	incrementally with the archive and at once with NSGAII::TopFront.
+*/
+void NDTreeArchive_Benchmark(int num_solutions)
+{
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+
+	deterministic::SingleSiteSimpleModel model(SingleSiteSimpleExample(objectives, {}));
+	algorithms::NSGAII<Chromosome, deterministic::SingleSiteSimpleModel> nsgaii(model, 1, num_threads);
+
+	printf("%-10s %10s %12s %12s %12s\n", "objectives", "solutions", "front size", "archive s", "top front s");
+
+	for (int num_objectives = 2; num_objectives <= 4; ++num_objectives) {
+		std::vector<Chromosome> solutions(num_solutions);
+
+		for (auto &solution : solutions) {
+			double sum = 0.0;
+			solution.constraints = 0.0;
+			solution.objectives.resize(num_objectives);
+
+			for (auto &x : solution.objectives) {
+				x = utils::random();
+				sum += x;
+			}
+
+			for (auto &x : solution.objectives) {
+				x = x / sum + 0.1 * utils::random();
+			}
+		}
+
+		auto start = std::chrono::system_clock::now();
+		algorithms::NDTreeArchive<Chromosome> archive;
+
+		for (const auto &solution : solutions) {
+			archive.Update(solution);
+		}
+
+		auto front = archive.Front();
+		std::chrono::duration<double> archive_elapsed = std::chrono::system_clock::now() - start;
+
+		start = std::chrono::system_clock::now();
+		nsgaii.TopFront(solutions);
+		std::chrono::duration<double> top_front_elapsed = std::chrono::system_clock::now() - start;
+
+		printf(
+			"%-10d %10d %12d %12.3f %12.3f\n", 
+			num_objectives, 
+			num_solutions, 
+			(int)front.size(), 
+			archive_elapsed.count(), 
+			top_front_elapsed.count()
+		);
+	}
+}
+
+/*
+	Heap allocations and time per generation of the single-objective GA with the 
+	genes of the chromosomes in a std::vector and in a utils::SmallVector.
+*/
+template<class Chromosome>
+void GeneContainer_Run(const char *name, deterministic::SingleSiteSimpleModel &model, int num_products)
+{
+	algorithms::SingleObjectiveGA<Chromosome, deterministic::SingleSiteSimpleModel> ga(model, 1, num_threads);
+	ga.Init(popsize, starting_length, p_xo, p_gene_swap, num_products, p_product_mut, p_plus_batch_mut, p_minus_batch_mut);
+
+	long long start_allocations = num_allocations;
+	auto start = std::chrono::system_clock::now();
+
+	for (int gen = 0; gen != max_gens; ++gen) {
+		ga.Update();
+	}
+
+	std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - start;
+	long long allocations = num_allocations - start_allocations;
+
+	double num_genes = 0.0;
+	auto parents = ga.Parents();
+
+	for (const auto &parent : parents) {
+		num_genes += parent.genes.size();
+	}
+
+	printf(
+		"%-16s %10.1f %16.0f %12.3f\n", 
+		name, 
+		num_genes / parents.size(), 
+		(double)allocations / max_gens, 
+		elapsed.count() * 1000 / max_gens
+	);
+}
+
+void GeneContainer_Benchmark()
+{
+	typedef types::SingleSiteSimpleGene Gene;
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+
+	std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> constraints;
+	constraints.emplace(deterministic::TOTAL_KG_BACKLOG, std::make_pair(-1, 0));
+
+	auto input_data = SingleSiteSimpleExample(objectives, constraints);
+	deterministic::SingleSiteSimpleModel model(input_data);
+
+	printf("%-16s %10s %16s %12s\n", "genes", "mean size", "allocs per gen", "ms per gen");
+
+	GeneContainer_Run<types::SingleObjectiveChromosome<Gene>>("std::vector", model, input_data.num_products);
+	GeneContainer_Run<types::SingleObjectiveChromosome<Gene, utils::SmallVector<Gene, 16>>>("SmallVector<16>", model, input_data.num_products);
+	GeneContainer_Run<types::SingleObjectiveChromosome<Gene, utils::SmallVector<Gene, 32>>>("SmallVector<32>", model, input_data.num_products);
+}
+
+/*
+	Time it takes to sort 'num_solutions' random solutions into fronts with NSGAII::TopFront,
+	with the objectives in a std::vector and in a std::array of a FixedNSGAChromosome.
+*/
+template<class Chromosome>
+double TopFront_Run(int num_objectives, int num_solutions)
+{
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+
+	deterministic::SingleSiteSimpleModel model(SingleSiteSimpleExample(objectives, {}));
+	algorithms::NSGAII<Chromosome, deterministic::SingleSiteSimpleModel> nsgaii(model, 1, num_threads);
+
+	std::vector<Chromosome> solutions(num_solutions);
+
+	for (auto &solution : solutions) {
+		double sum = 0.0;
+		solution.constraints = 0.0;
+		types::ResizeObjectives(solution.objectives, num_objectives);
+
+		for (auto &x : solution.objectives) {
+			x = utils::random();
+			sum += x;
+		}
+
+		for (auto &x : solution.objectives) {
+			x = x / sum + 0.1 * utils::random();
+		}
+	}
+
+	auto start = std::chrono::system_clock::now();
+	nsgaii.TopFront(solutions);
+	std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - start;
+
+	return elapsed.count();
+}
+
+void FixedObjectives_Benchmark(int num_solutions)
+{
+	typedef types::SingleSiteSimpleGene Gene;
+
+	printf("%-10s %10s %12s %12s\n", "objectives", "solutions", "vector s", "array s");
+
+	printf(
+		"%-10d %10d %12.3f %12.3f\n", 2, num_solutions, 
+		TopFront_Run<types::NSGAChromosome<Gene>>(2, num_solutions), 
+		TopFront_Run<types::FixedNSGAChromosome<Gene, 2>>(2, num_solutions)
+	);
+	printf(
+		"%-10d %10d %12.3f %12.3f\n", 3, num_solutions, 
+		TopFront_Run<types::NSGAChromosome<Gene>>(3, num_solutions), 
+		TopFront_Run<types::FixedNSGAChromosome<Gene, 3>>(3, num_solutions)
+	);
+	printf(
+		"%-10d %10d %12.3f %12.3f\n", 4, num_solutions, 
+		TopFront_Run<types::NSGAChromosome<Gene>>(4, num_solutions), 
+		TopFront_Run<types::FixedNSGAChromosome<Gene, 4>>(4, num_solutions)
+	);
+}
+
+/*
+	Time it takes to compare every pair of 'num_solutions' random solutions with
+	each of the dominance kernels the CPU supports.
+*/
+void DominanceKernel_Benchmark(int num_solutions)
+{
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+
+	std::vector<std::pair<const char*, algorithms::CompareBlockFunction>> kernels = { { "scalar", algorithms::CompareBlockScalar } };
+
+#if defined(__DOMINANCE_SIMD__)
+	if (__builtin_cpu_supports("avx2")) {
+		kernels.emplace_back("AVX2", algorithms::CompareBlockAVX2);
+	}
+
+	if (__builtin_cpu_supports("avx512f")) {
+		kernels.emplace_back("AVX-512", algorithms::CompareBlockAVX512);
+	}
+#endif
+
+	printf("%-10s %10s %12s %12s\n", "objectives", "kernel", "dominations", "seconds");
+
+	for (int num_objectives = 2; num_objectives <= 4; ++num_objectives) {
+		std::vector<Chromosome> solutions(num_solutions);
+
+		for (auto &solution : solutions) {
+			solution.constraints = utils::random() < 0.5 ? 0.0 : utils::random();
+			solution.objectives.resize(num_objectives);
+
+			for (auto &x : solution.objectives) {
+				x = utils::random();
+			}
+		}
+
+		algorithms::DominancePoints points;
+		points.Assign(solutions);
+
+		for (const auto &kernel : kernels) {
+			long long num_dominations = 0;
+			auto start = std::chrono::system_clock::now();
+
+			for (int p = 0; p < num_solutions; ++p) {
+				for (int begin = p + 1; begin < num_solutions; begin += algorithms::DOMINANCE_BLOCK) {
+					uint32_t dominates, dominated;
+					kernel.second(points, p, begin, dominates, dominated);
+					num_dominations += __builtin_popcount(dominates | dominated);
+				}
+			}
+
+			std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - start;
+
+			printf("%-10d %10s %12lld %12.3f\n", num_objectives, kernel.first, num_dominations, elapsed.count());
+		}
+	}
+}
+
+/*
+	Thread utilization and time per generation of NSGA-II on the stochastic example
+	with the OpenMP loop and with a PoolExecutor. The chromosomes start with 1 to
+	'max_length' genes, so their evaluations take very different times.
+*/
+void Executor_Benchmark(int num_mc_sims, int max_length)
+{
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+	typedef stochastic::SingleSiteSimpleModel Model;
+
+	std::unordered_map<stochastic::OBJECTIVES, int> objectives;
+	objectives.emplace(stochastic::TOTAL_KG_THROUGHPUT_MEAN, 1);
+	objectives.emplace(stochastic::TOTAL_KG_INVENTORY_DEFICIT_MEAN, -1);
+
+	std::unordered_map<stochastic::OBJECTIVES, std::pair<int, double>> constraints;
+	constraints.emplace(stochastic::TOTAL_KG_BACKLOG_MEAN, std::make_pair(-1, 0));
+
+	auto input_data = StochasticSingleSiteSimpleExample(objectives, constraints, num_mc_sims);
+	Model model(input_data);
+
+	std::vector<std::pair<const char*, std::shared_ptr<algorithms::Executor>>> executors = {
+		{ "OpenMP", std::make_shared<algorithms::OpenMPExecutor>() },
+		{ "pool", std::make_shared<algorithms::PoolExecutor>(num_threads) }
+	};
+
+	int num_gens = 50;
+
+	printf("%-10s %8s %16s %16s %12s\n", "executor", "threads", "mean utilization", "min utilization", "ms per gen");
+
+	for (const auto &executor : executors) {
+		algorithms::NSGAII<Chromosome, Model> nsgaii(model, 1, num_threads);
+		nsgaii.SetExecutor(executor.second);
+
+		// Mutated seeds of every length make a population of mixed lengths
+		std::vector<Chromosome> seeds;
+
+		for (int length = 1; length <= max_length; ++length) {
+			seeds.push_back(Chromosome(length, p_xo, p_gene_swap, input_data.num_products, p_product_mut, p_plus_batch_mut, p_minus_batch_mut));
+		}
+
+		nsgaii.SetSeededRatio(1.0);
+		nsgaii.Init(popsize, seeds, starting_length, p_xo, p_gene_swap, input_data.num_products, p_product_mut, p_plus_batch_mut, p_minus_batch_mut);
+
+		double utilization = 0.0, min_utilization = 1.0, seconds = 0.0;
+
+		for (int gen = 0; gen != num_gens; ++gen) {
+			nsgaii.Update();
+
+			const auto &stats = executor.second->LastStats();
+			utilization += stats.Utilization();
+			min_utilization = std::min(min_utilization, stats.Utilization());
+			seconds += stats.seconds;
+		}
+
+		printf(
+			"%-10s %8d %16.3f %16.3f %12.3f\n",
+			executor.first,
+			executor.second->LastStats().num_threads,
+			utilization / num_gens,
+			min_utilization,
+			seconds * 1000 / num_gens
+		);
+	}
+}
+
+/*
+	Thread utilization and evaluations per second of NSGA-II on the stochastic example
+	with generational updates and with the steady-state UpdateAsync, both evaluating
+	on a PoolExecutor. The utilization is over the whole run, i.e. it includes the
+	time the workers wait for the ranking and the breeding.
+*/
+void SteadyState_Benchmark(int num_mc_sims, int max_length)
+{
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+	typedef stochastic::SingleSiteSimpleModel Model;
+
+	std::unordered_map<stochastic::OBJECTIVES, int> objectives;
+	objectives.emplace(stochastic::TOTAL_KG_THROUGHPUT_MEAN, 1);
+	objectives.emplace(stochastic::TOTAL_KG_INVENTORY_DEFICIT_MEAN, -1);
+
+	std::unordered_map<stochastic::OBJECTIVES, std::pair<int, double>> constraints;
+	constraints.emplace(stochastic::TOTAL_KG_BACKLOG_MEAN, std::make_pair(-1, 0));
+
+	auto input_data = StochasticSingleSiteSimpleExample(objectives, constraints, num_mc_sims);
+	Model model(input_data);
+
+	int num_gens = 50;
+
+	printf("%-12s %8s %12s %16s\n", "update", "threads", "utilization", "evaluations/s");
+
+	for (int steady = 0; steady < 2; ++steady) {
+		auto executor = std::make_shared<algorithms::PoolExecutor>(num_threads);
+		algorithms::NSGAII<Chromosome, Model> nsgaii(model, 1, num_threads);
+		nsgaii.SetExecutor(executor);
+
+		std::vector<Chromosome> seeds;
+
+		for (int length = 1; length <= max_length; ++length) {
+			seeds.push_back(Chromosome(length, p_xo, p_gene_swap, input_data.num_products, p_product_mut, p_plus_batch_mut, p_minus_batch_mut));
+		}
+
+		nsgaii.SetSeededRatio(1.0);
+		nsgaii.Init(popsize, seeds, starting_length, p_xo, p_gene_swap, input_data.num_products, p_product_mut, p_plus_batch_mut, p_minus_batch_mut);
+
+		double busy_seconds = executor->TotalStats().busy_seconds;
+		auto start = std::chrono::system_clock::now();
+
+		if (steady) {
+			nsgaii.UpdateAsync(num_gens * popsize);
+		}
+		else {
+			for (int gen = 0; gen != num_gens; ++gen) {
+				nsgaii.Update();
+			}
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - start;
+		busy_seconds = executor->TotalStats().busy_seconds - busy_seconds;
+
+		printf(
+			"%-12s %8d %12.3f %16.0f\n",
+			steady ? "steady" : "generational",
+			executor->NumThreads(),
+			busy_seconds / (elapsed.count() * executor->NumThreads()),
+			num_gens * popsize / elapsed.count()
+		);
+	}
+}
+
+void Cutoff_Benchmark(int num_mc_sims, int max_length)
+{
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+	typedef stochastic::SingleSiteSimpleModel Model;
+
+	std::unordered_map<stochastic::OBJECTIVES, int> objectives;
+	objectives.emplace(stochastic::TOTAL_KG_THROUGHPUT_MEAN, 1);
+	objectives.emplace(stochastic::TOTAL_KG_INVENTORY_DEFICIT_MEAN, -1);
+
+	std::unordered_map<stochastic::OBJECTIVES, std::pair<int, double>> constraints;
+	constraints.emplace(stochastic::TOTAL_KG_BACKLOG_MEAN, std::make_pair(-1, 0));
+
+	auto input_data = StochasticSingleSiteSimpleExample(objectives, constraints, num_mc_sims);
+	Model model(input_data);
+
+	int num_gens = 50;
+
+	printf("%-8s %12s %14s %12s\n", "cutoff", "cut off", "periods saved", "ms per gen");
+
+	for (int use_cutoff = 0; use_cutoff < 2; ++use_cutoff) {
+		algorithms::NSGAII<Chromosome, Model> nsgaii(model, 1, 1);
+		nsgaii.UseCutoff(use_cutoff);
+
+		std::vector<Chromosome> seeds;
+
+		for (int length = 1; length <= max_length; ++length) {
+			seeds.push_back(Chromosome(length, p_xo, p_gene_swap, input_data.num_products, p_product_mut, p_plus_batch_mut, p_minus_batch_mut));
+		}
+
+		nsgaii.SetSeededRatio(1.0);
+		nsgaii.Init(popsize, seeds, starting_length, p_xo, p_gene_swap, input_data.num_products, p_product_mut, p_plus_batch_mut, p_minus_batch_mut);
+
+		auto start = std::chrono::system_clock::now();
+
+		for (int gen = 0; gen != num_gens; ++gen) {
+			nsgaii.Update();
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::system_clock::now() - start;
+		const auto &stats = nsgaii.GetCutoffStats();
+
+		printf(
+			"%-8s %11.1f%% %13.1f%% %12.2f\n",
+			use_cutoff ? "on" : "off",
+			stats.num_evaluations ? 100.0 * stats.num_cut_off / stats.num_evaluations : 0.0,
+			100.0 * stats.SavedFraction(),
+			1000.0 * elapsed.count() / num_gens
+		);
+	}
+}
+
+/*
+	Time it takes the deterministic model to evaluate the mutants of the parents of a
+	run which differ from their parent in a single gene, from scratch and from the
+	snapshot of the parent, see deterministic::SingleSiteSimpleModel::UseDelta. The
+	gene is one of the 'last' genes of the parent.
+*/
+void Delta_Benchmark(int last, int repeats)
+{
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+	typedef deterministic::SingleSiteSimpleModel Model;
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+
+	auto input_data = SingleSiteSimpleExample(objectives, {});
+	Model model(input_data);
+
+	algorithms::NSGAII<Chromosome, Model> nsgaii(model, 1, 1);
+	nsgaii.Init(popsize, starting_length, p_xo, p_gene_swap, input_data.num_products, p_product_mut, p_plus_batch_mut, p_minus_batch_mut);
+
+	for (int gen = 0; gen != 50; ++gen) {
+		nsgaii.Update();
+	}
+
+	// The parents with their snapshots
+	Model::Workspace workspace;
+	auto parents = nsgaii.Parents();
+	model.UseDelta(true);
+	model.EvaluateBatch(parents.data(), parents.data() + parents.size(), workspace);
+
+	std::vector<Chromosome> mutants;
+
+	for (const auto &parent : parents) {
+		mutants.push_back(parent);
+
+		auto &gene = mutants.back().genes[std::max(0, (int)parent.genes.size() - utils::random_int(1, last))];
+		gene.num_batches += gene.num_batches > 1 && utils::random() < 0.5 ? -1 : 1;
+	}
+
+	printf("%-8s %16s %14s\n", "delta", "products reused", "ms per batch");
+
+	for (int use_delta = 0; use_delta < 2; ++use_delta) {
+		model.UseDelta(use_delta);
+		workspace.delta_stats = types::DeltaStats();
+
+		double seconds = 0.0;
+
+		for (int r = 0; r < repeats; ++r) {
+			auto batch = mutants;
+			auto start = std::chrono::system_clock::now();
+
+			model.EvaluateBatch(batch.data(), batch.data() + batch.size(), workspace);
+
+			seconds += std::chrono::duration<double>(std::chrono::system_clock::now() - start).count();
+		}
+
+		printf(
+			"%-8s %15.1f%% %14.2f\n",
+			use_delta ? "on" : "off",
+			100.0 * workspace.delta_stats.ReusedFraction(),
+			1000.0 * seconds / repeats
+		);
+	}
+}
+
+int main()
+{
+	printf("\nDeterministic SingleSiteSimple heuristic vs random initialisation\n\n");
+	Det_SingleSiteSimple_HeuristicInit_Benchmark(600.0);
+
+	printf("\nExact hypervolume of random fronts\n\n");
+	Metrics_Hypervolume_Benchmark(100, 10);
+
+	printf("\nNon-dominated archive vs non-dominated sorting\n\n");
+	NDTreeArchive_Benchmark(20000);
+
+	printf("\nNon-dominated sorting with a runtime vs a fixed number of objectives\n\n");
+	FixedObjectives_Benchmark(5000);
+
+	printf("\nDominance kernels\n\n");
+	DominanceKernel_Benchmark(10000);
+
+	printf("\nFitness evaluation with the OpenMP loop vs a PoolExecutor\n\n");
+	Executor_Benchmark(20, 40);
+
+	printf("\nGenerational vs steady-state NSGA-II\n\n");
+	SteadyState_Benchmark(20, 40);
+
+	printf("\nEvaluations stopped once an offspring cannot survive\n\n");
+	Cutoff_Benchmark(20, 40);
+
+	printf("\nSingle-gene mutants evaluated from scratch vs from the parent\n\n");
+	Delta_Benchmark(5, 20);
+
+	printf("\nGenes in a std::vector vs inline\n\n");
+	GeneContainer_Benchmark();
+
+	printf("\n");
+
+	return 0;
+}
@@ -0,0 +1,421 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __ARCHIVE_H__
+#define __ARCHIVE_H__
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "utils.h"
+
+
+namespace algorithms
+{
+	/*
+		External archive of non-dominated solutions based on ND-Tree
+		Jaszkiewicz, A. and Lust, T., 2018. ND-tree-based update: a fast algorithm for the dynamic nondominance problem. IEEE Transactions on Evolutionary Computation, 22(5), pp.778-791.
+		https://ieeexplore.ieee.org/document/8274915
+
+		Only the solutions with the lowest constraints value seen so far are kept.
+		Solutions with the same objectives (within utils::Approx) are kept only once.
+	*/
+	template<class Chromosome>
+	class NDTreeArchive
+	{
+		typedef std::vector<Chromosome> Population;
+
+		/*
+			Leaf nodes hold the solutions, internal nodes only the children. Ideal and
+			nadir points bound the objectives of all the solutions in the subtree. They are
+			not tightened when solutions are removed, which keeps them valid bounds.
+		*/
+		struct Node
+		{
+			std::vector<double> ideal, nadir;
+			Population solutions;
+			std::vector<std::unique_ptr<Node>> children;
+
+			Node() {}
+
+			Node(const Node &other) : ideal(other.ideal), nadir(other.nadir), solutions(other.solutions)
+			{
+				for (const auto &child : other.children) {
+					children.emplace_back(new Node(*child));
+				}
+			}
+
+			inline bool IsLeaf() const
+			{
+				return children.empty();
+			}
+		};
+
+		enum { NON_DOMINATED, DOMINATES, DOMINATED, EQUAL };
+
+		std::unique_ptr<Node> root;
+		int max_leaf_size, num_children, size;
+		double constraints;
+
+		/*
+			Compares the objectives of p and q, treating utils::Approx equal values as equal.
+			Not done with CompareBlock: it compares the objectives exactly and has no
+			EQUAL result, which the archive needs to keep a solution only once.
+		*/
+		template<class P, class Q>
+		static inline int Compare(const P &p, const Q &q)
+		{
+			bool p_better = false, q_better = false;
+
+			for (int m = 0; m != p.size(); ++m) {
+				if (p[m] == utils::Approx(q[m])) {
+					continue;
+				}
+
+				if (p[m] < q[m]) {
+					p_better = true;
+				}
+				else {
+					q_better = true;
+				}
+			}
+
+			if (p_better && !q_better) {
+				return DOMINATES;
+			}
+			else if (!p_better && q_better) {
+				return DOMINATED;
+			}
+			else if (!p_better && !q_better) {
+				return EQUAL;
+			}
+
+			return NON_DOMINATED;
+		}
+
+		template<class P, class Q>
+		static inline bool WeaklyDominates(const P &p, const Q &q)
+		{
+			for (int m = 0; m != p.size(); ++m) {
+				if (p[m] > q[m]) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		template<class P, class Q>
+		static inline bool WeaklyDominatesApprox(const P &p, const Q &q)
+		{
+			for (int m = 0; m != p.size(); ++m) {
+				if (p[m] > q[m] && p[m] != utils::Approx(q[m])) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		template<class P>
+		static inline double Distance(const P &p, const Node &node)
+		{
+			double d = 0.0;
+
+			for (int m = 0; m != p.size(); ++m) {
+				double midpoint = (node.ideal[m] + node.nadir[m]) / 2;
+				d += (p[m] - midpoint) * (p[m] - midpoint);
+			}
+
+			return d;
+		}
+
+		template<class Y>
+		static inline void UpdateBounds(Node &node, const Y &y)
+		{
+			if (node.ideal.empty()) {
+				node.ideal.assign(y.begin(), y.end());
+				node.nadir.assign(y.begin(), y.end());
+				return;
+			}
+
+			for (int m = 0; m != y.size(); ++m) {
+				node.ideal[m] = std::min(node.ideal[m], y[m]);
+				node.nadir[m] = std::max(node.nadir[m], y[m]);
+			}
+		}
+
+		static int Count(const Node &node)
+		{
+			int count = node.solutions.size();
+
+			for (const auto &child : node.children) {
+				count += Count(*child);
+			}
+
+			return count;
+		}
+
+		/*
+			Removes the solutions dominated by y from the subtree. Returns false if y
+			is dominated by or equal to a solution in the subtree.
+		*/
+		template<class Y>
+		bool UpdateNode(std::unique_ptr<Node> &node, const Y &y)
+		{
+			if (WeaklyDominates(node->nadir, y)) {
+				return false;
+			}
+
+			if (WeaklyDominates(y, node->ideal) && Compare(y, node->ideal) == DOMINATES) {
+				size -= Count(*node);
+				node.reset();
+				return true;
+			}
+
+			if (!WeaklyDominatesApprox(node->ideal, y) && !WeaklyDominatesApprox(y, node->nadir)) {
+				return true;
+			}
+
+			if (node->IsLeaf()) {
+				std::vector<bool> dominated(node->solutions.size(), false);
+
+				for (int i = 0; i < node->solutions.size(); ++i) {
+					int domination_flag = Compare(node->solutions[i].objectives, y);
+
+					if (domination_flag == DOMINATES || domination_flag == EQUAL) {
+						return false;
+					}
+
+					dominated[i] = (domination_flag == DOMINATED);
+				}
+
+				int i = 0;
+
+				node->solutions.erase(
+					std::remove_if(
+						node->solutions.begin(),
+						node->solutions.end(),
+						[&dominated, &i](const Chromosome &) { return dominated[i++]; }
+					),
+					node->solutions.end()
+				);
+
+				size -= dominated.size() - node->solutions.size();
+
+				if (node->solutions.empty()) {
+					node.reset();
+				}
+
+				return true;
+			}
+
+			for (auto &child : node->children) {
+				if (!UpdateNode(child, y)) {
+					return false;
+				}
+			}
+
+			node->children.erase(
+				std::remove(node->children.begin(), node->children.end(), nullptr),
+				node->children.end()
+			);
+
+			if (node->children.empty()) {
+				node.reset();
+			}
+			else if (node->children.size() == 1) {
+				std::unique_ptr<Node> child = std::move(node->children[0]);
+				node = std::move(child);
+			}
+
+			return true;
+		}
+
+		void Insert(Node &node, const Chromosome &solution)
+		{
+			UpdateBounds(node, solution.objectives);
+
+			if (node.IsLeaf()) {
+				node.solutions.push_back(solution);
+
+				if (node.solutions.size() > max_leaf_size) {
+					Split(node);
+				}
+
+				return;
+			}
+
+			auto closest = std::min_element(
+				node.children.begin(),
+				node.children.end(),
+				[&solution](const auto &c1, const auto &c2) {
+					return Distance(solution.objectives, *c1) < Distance(solution.objectives, *c2);
+				}
+			);
+
+			Insert(**closest, solution);
+		}
+
+		/*
+			Splits the leaf into children. The first child gets the solution furthest
+			from all the others, each next one the solution furthest from the previous
+			children. The remaining solutions go to the closest child.
+		*/
+		void Split(Node &node)
+		{
+			Population solutions = std::move(node.solutions);
+			node.solutions.clear();
+
+			int k = num_children ? num_children : solutions[0].objectives.size() + 1;
+			std::vector<bool> used(solutions.size(), false);
+			std::vector<double> d(solutions.size(), 0.0);
+
+			for (int i = 0; i < solutions.size(); ++i) {
+				for (int j = 0; j < solutions.size(); ++j) {
+					for (int m = 0; m != solutions[i].objectives.size(); ++m) {
+						d[i] += std::pow(solutions[i].objectives[m] - solutions[j].objectives[m], 2);
+					}
+				}
+			}
+
+			while (node.children.size() < k && node.children.size() < solutions.size()) {
+				int furthest = -1;
+
+				for (int i = 0; i < solutions.size(); ++i) {
+					if (!used[i] && (furthest == -1 || d[i] > d[furthest])) {
+						furthest = i;
+					}
+				}
+
+				used[furthest] = true;
+				node.children.emplace_back(new Node());
+				Insert(*node.children.back(), solutions[furthest]);
+
+				if (node.children.size() == 1) {
+					std::fill(d.begin(), d.end(), 0.0);
+				}
+
+				for (int i = 0; i < solutions.size(); ++i) {
+					d[i] += Distance(solutions[i].objectives, *node.children.back());
+				}
+			}
+
+			for (int i = 0; i < solutions.size(); ++i) {
+				if (!used[i]) {
+					Insert(node, solutions[i]);
+				}
+			}
+		}
+
+		void Collect(const Node &node, Population &front) const
+		{
+			front.insert(front.end(), node.solutions.begin(), node.solutions.end());
+
+			for (const auto &child : node.children) {
+				Collect(*child, front);
+			}
+		}
+
+	public:
+		NDTreeArchive(int max_leaf_size = 20, int num_children = 0)
+			:
+			max_leaf_size(max_leaf_size),
+			num_children(num_children),
+			size(0),
+			constraints(std::numeric_limits<double>::infinity())
+		{}
+
+		NDTreeArchive(const NDTreeArchive &other)
+			:
+			root(other.root ? new Node(*other.root) : nullptr),
+			max_leaf_size(other.max_leaf_size),
+			num_children(other.num_children),
+			size(other.size),
+			constraints(other.constraints)
+		{}
+
+		NDTreeArchive& operator=(NDTreeArchive other)
+		{
+			std::swap(root, other.root);
+			std::swap(max_leaf_size, other.max_leaf_size);
+			std::swap(num_children, other.num_children);
+			std::swap(size, other.size);
+			std::swap(constraints, other.constraints);
+			return *this;
+		}
+
+		/*
+			Adds the solution to the archive if it is not dominated by any of the
+			archived solutions and removes the archived solutions it dominates.
+			Returns true if the solution was added.
+		*/
+		bool Update(const Chromosome &solution)
+		{
+			if (root && solution.constraints != utils::Approx(constraints)) {
+				if (solution.constraints > constraints) {
+					return false;
+				}
+
+				Clear();
+			}
+
+			if (root && !UpdateNode(root, solution.objectives)) {
+				return false;
+			}
+
+			if (!root) {
+				root.reset(new Node());
+				constraints = solution.constraints;
+			}
+
+			Insert(*root, solution);
+			++size;
+
+			return true;
+		}
+
+		// Returns the archived solutions in the same order as NSGAII::TopFront.
+		Population Front() const
+		{
+			Population front;
+			front.reserve(size);
+
+			if (root) {
+				Collect(*root, front);
+			}
+
+			std::sort(
+				front.begin(),
+				front.end(),
+				[](const Chromosome &i1, const Chromosome &i2) {
+					return i1.objectives[0] > i2.objectives[0];
+				}
+			);
+
+			return front;
+		}
+
+		inline int Size() const
+		{
+			return size;
+		}
+
+		void Clear()
+		{
+			root.reset();
+			size = 0;
+			constraints = std::numeric_limits<double>::infinity();
+		}
+	};
+}
+
+#endif
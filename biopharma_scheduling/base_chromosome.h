@@ -8,6 +8,7 @@
 #ifndef __BASE_CHROMOSOME__
 #define __BASE_CHROMOSOME__
 
+#include <memory>
 #include <vector>
 #include <cstdlib>
 #include <utility>
@@ -16,20 +17,23 @@
 #include <cassert>
 
 #include "utils.h"
+#include "delta.h"
 
 
 namespace types
 {
 	/*
-		Base dynamic individual class. Not to be called directly.
+		Base dynamic individual class. Not to be called directly. 'GeneContainer' 
+		can be any vector-like type, e.g. utils::SmallVector<Gene, N>, which keeps
+		short chromosomes without a heap allocation.
 	*/
-	template<class Gene>
+	template<class Gene, class GeneContainer = std::vector<Gene>>
 	class BaseChromosome
 	{
 	public:
-		typedef std::vector<Gene> Genes;
+		typedef GeneContainer Genes;
 
-		explicit BaseChromosome() {}
+		explicit BaseChromosome() : p_xo(0.0), p_gene_swap(0.0) {}
 
 		template<class... GeneParams>
 		explicit BaseChromosome(
@@ -50,6 +54,37 @@ namespace types
 			assert(genes.size() >= 1);
 		}
 
+		/*
+			Re-creates an individual from the genes of a seed individual, e.g. a solution 
+			of a previous run. Takes the same parameters as the random constructor so that
+			both can be called with the same parameter pack; starting_length is not used. 
+			Genes which do not fit the current problem are dropped.
+		*/
+		template<class... GeneParams>
+		explicit BaseChromosome(
+			const Genes &seed_genes,
+			int /* starting_length */,
+			double p_xo,
+			double p_gene_swap,
+			GeneParams... params
+		) :
+			p_xo(p_xo),
+			p_gene_swap(p_gene_swap)
+
+		{
+			for (const auto &seed_gene : seed_genes) {
+				Gene gene(seed_gene, params...);
+
+				if (gene.IsValid()) {
+					genes.push_back(std::move(gene));
+				}
+			}
+
+			if (genes.empty()) {
+				genes.push_back(std::move(Gene(params...)));
+			}
+		}
+
 		inline void Cross(BaseChromosome &other) 
 		{
 			if (utils::random() > p_xo) {
@@ -99,6 +134,8 @@ namespace types
 		}
 
 		Genes genes;
+		bool truncated = false; // Not fully evaluated, as it could not survive, see types::Cutoff
+		std::shared_ptr<const ParentSnapshot> snapshot; // Of the last evaluation, inherited by the offspring, see BaseGA::Released
 
 	private:
 		inline void AddGene()
@@ -8,18 +8,42 @@
 #ifndef __BASE_GA_H__
 #define __BASE_GA_H__
 
-#include <omp.h>
+#include <cmath>
+#include <atomic>
+#include <chrono>
 #include <limits>
+#include <memory>
 #include <vector>
 #include <numeric>
+#include <thread>
 #include <cstdlib>
+#include <string>
+#include <stdexcept>
 #include <algorithm>
+#include <type_traits>
 
 #include "utils.h"
+#include "cutoff.h"
+#include "delta.h"
+#include "executor.h"
+#include "lock_free_queue.h"
 
 
 namespace algorithms
 {
+	// True if FitnessFunction evaluates batches of chromosomes, as the scheduling models do.
+	template<class FitnessFunction, class Chromosome, class = void>
+	struct HasEvaluateBatch : std::false_type {};
+
+	template<class FitnessFunction, class Chromosome>
+	struct HasEvaluateBatch<FitnessFunction, Chromosome, decltype(void(
+		std::declval<FitnessFunction&>().EvaluateBatch(
+			(Chromosome*)nullptr,
+			(Chromosome*)nullptr,
+			std::declval<typename FitnessFunction::Workspace&>()
+		)
+	))> : std::true_type {};
+
 	/*
 		Chromosome<Gene> class object is expected to have the following methods:
 
@@ -34,9 +58,160 @@ namespace algorithms
 		FitnessFunction fitness_function;
 		Population parents, offspring;
 		std::vector<int> indices;
+		double seeded_ratio = 0.5;
+		std::shared_ptr<Executor> executor;
+		std::vector<double> costs;
+		std::vector<int> chunk_ends;
+		Population in_flight;
+		bool use_cutoff = false;
+		types::CutoffStats cutoff_stats;
+		std::vector<types::CutoffStats> chunk_cutoff_stats;
+		types::DeltaStats delta_stats;
+		std::vector<types::DeltaStats> chunk_delta_stats;
 
 		virtual bool Tournament(const Chromosome &p, const Chromosome &q) = 0;
 
+		/*
+			Evaluates the population with the executor, if there is one, and in the
+			calling thread otherwise. The cost of a chromosome is its number of genes, the
+			Monte Carlo simulations of the stochastic models are the same for all of them.
+			A fitness function with batches stops the evaluations at 'cutoff', if the GA
+			uses one, see UseCutoff.
+		*/
+		inline void Evaluate(Population &population, const types::Cutoff &cutoff = types::Cutoff())
+		{
+			Evaluate(population, use_cutoff ? cutoff : types::Cutoff(), HasEvaluateBatch<FitnessFunction, Chromosome>());
+		}
+
+		// Workspace of the calling thread, kept for the later generations.
+		template<class Workspace>
+		static Workspace& ThreadWorkspace()
+		{
+			static thread_local Workspace workspace;
+			return workspace;
+		}
+
+		/*
+			Individuals which leave the GA, e.g. the results and the archived solutions,
+			without the snapshots of their evaluations, which only their offspring use.
+		*/
+		static inline Chromosome Released(Chromosome individual)
+		{
+			individual.snapshot.reset();
+			return individual;
+		}
+
+		static inline Population Released(Population population)
+		{
+			for (auto &individual : population) {
+				individual.snapshot.reset();
+			}
+
+			return population;
+		}
+
+		/*
+			Splits the population into contiguous chunks of about the same cost, a few
+			per thread, and evaluates each of them as a batch in the workspace of the
+			thread, which is kept for the later generations. The workspace holds the
+			cutoff of the batch and counts the work it saved, by the cutoff and by the
+			snapshots of the parents it reused.
+		*/
+		void Evaluate(Population &population, const types::Cutoff &cutoff, std::true_type)
+		{
+			typedef typename FitnessFunction::Workspace Workspace;
+
+			Chromosome *chromosomes = population.data();
+
+			if (!executor) {
+				auto &workspace = ThreadWorkspace<Workspace>();
+				workspace.cutoff = cutoff;
+				workspace.stats = types::CutoffStats();
+				workspace.delta_stats = types::DeltaStats();
+				fitness_function.EvaluateBatch(chromosomes, chromosomes + population.size(), workspace);
+				cutoff_stats += workspace.stats;
+				delta_stats += workspace.delta_stats;
+				return;
+			}
+
+			double total_cost = 0.0;
+
+			for (const auto &chromosome : population) {
+				total_cost += 1.0 + chromosome.genes.size();
+			}
+
+			int num_chunks = std::min((int)population.size(), 4 * executor->NumThreads());
+			double chunk_cost = total_cost / std::max(1, num_chunks), cost = 0.0;
+
+			costs.resize(0);
+			chunk_ends.resize(0);
+
+			for (int i = 0; i < population.size(); ++i) {
+				cost += 1.0 + population[i].genes.size();
+
+				if (cost >= chunk_cost || i + 1 == population.size()) {
+					chunk_ends.push_back(i + 1);
+					costs.push_back(cost);
+					cost = 0.0;
+				}
+			}
+
+			chunk_cutoff_stats.assign(chunk_ends.size(), types::CutoffStats());
+			chunk_delta_stats.assign(chunk_ends.size(), types::DeltaStats());
+
+			executor->Run(chunk_ends.size(), costs, [this, chromosomes, &cutoff](int c) {
+				auto &workspace = ThreadWorkspace<Workspace>();
+				workspace.cutoff = cutoff;
+				workspace.stats = types::CutoffStats();
+				workspace.delta_stats = types::DeltaStats();
+				fitness_function.EvaluateBatch(chromosomes + (c ? chunk_ends[c - 1] : 0), chromosomes + chunk_ends[c], workspace);
+				chunk_cutoff_stats[c] = workspace.stats;
+				chunk_delta_stats[c] = workspace.delta_stats;
+			});
+
+			for (int c = 0; c < chunk_ends.size(); ++c) {
+				cutoff_stats += chunk_cutoff_stats[c];
+				delta_stats += chunk_delta_stats[c];
+			}
+		}
+
+		/*
+			Evaluates the chromosomes from 'begin' to 'end' in the calling thread without a
+			cutoff, in its workspace if the fitness function has batches, see Steady.
+		*/
+		void EvaluateRange(Chromosome *begin, Chromosome *end, std::true_type)
+		{
+			auto &workspace = ThreadWorkspace<typename FitnessFunction::Workspace>();
+			workspace.cutoff = types::Cutoff();
+			fitness_function.EvaluateBatch(begin, end, workspace);
+		}
+
+		void EvaluateRange(Chromosome *begin, Chromosome *end, std::false_type)
+		{
+			for (; begin != end; ++begin) {
+				fitness_function(*begin);
+			}
+		}
+
+		void Evaluate(Population &population, const types::Cutoff & /* cutoff */, std::false_type)
+		{
+			if (!executor) {
+				for (int i = 0; i < population.size(); ++i) {
+					fitness_function(population[i]);
+				}
+
+				return;
+			}
+
+			costs.resize(population.size());
+
+			for (int i = 0; i < population.size(); ++i) {
+				costs[i] = 1.0 + population[i].genes.size();
+			}
+
+			executor->Run(population.size(), costs, [this, &population](int i) { fitness_function(population[i]); });
+		}
+
 		inline void Select()
 		{
 			int p;
@@ -80,8 +255,209 @@ namespace algorithms
 			}
 		}
 
+		inline const Chromosome& TournamentWinner()
+		{
+			const auto &p = parents[utils::random_int(0, parents.size() - 1)];
+			const auto &q = parents[utils::random_int(0, parents.size() - 1)];
+
+			return Tournament(p, q) ? p : q;
+		}
+
+		// Two offspring of tournament winners, as Select and Reproduce make them for a generation.
+		inline void Breed(Chromosome &first, Chromosome &second)
+		{
+			first = TournamentWinner();
+			second = TournamentWinner();
+
+			first.Cross(second);
+			first.Mutate();
+			second.Mutate();
+		}
+
+		/*
+			Steady-state evolution: offspring are bred two at a time from the current
+			parents and 'insert' is called with at least 'batch_size' of the ones evaluated
+			since its last call in 'offspring', which it has to merge into the parents,
+			until at least 'num_evaluations' have been inserted.
+
+			With a PoolExecutor, the calling thread breeds and inserts while the workers
+			of the pool take the offspring from a lock-free queue, evaluate them and hand
+			them back through another one. Up to four offspring per worker are in flight,
+			so the workers do not wait for the slowest evaluation or the inserts, and a
+			semaphore per queue puts the threads to sleep while there is nothing to take.
+			The results then depend on the order the evaluations finish in. Otherwise
+			every batch is evaluated and inserted in turn.
+		*/
+		template<class Insert>
+		void Steady(int num_evaluations, int batch_size, Insert insert)
+		{
+			typedef std::chrono::steady_clock Clock;
+			typedef HasEvaluateBatch<FitnessFunction, Chromosome> Batches;
+
+			utils::ThreadPool *pool = executor ? executor->Pool() : nullptr;
+			int num_inserted = 0;
+
+			offspring.resize(0);
+
+			if (!pool) {
+				while (num_inserted < num_evaluations) {
+					while (offspring.size() < batch_size && num_inserted + offspring.size() < num_evaluations) {
+						offspring.resize(offspring.size() + 2);
+						Breed(offspring[offspring.size() - 2], offspring.back());
+					}
+
+					EvaluateRange(offspring.data(), offspring.data() + offspring.size(), Batches());
+
+					num_inserted += offspring.size();
+					insert();
+					offspring.resize(0);
+				}
+
+				return;
+			}
+
+			int num_threads = pool->NumThreads(), num_slots = 4 * num_threads;
+			utils::LockFreeQueue<int> ready(num_slots), done(num_slots);
+			utils::Semaphore num_ready, num_done;
+			utils::Latch finished(num_threads);
+
+			std::vector<int> free_slots(num_slots);
+			std::iota(free_slots.begin(), free_slots.end(), 0);
+			in_flight.resize(num_slots);
+
+			std::atomic<bool> stop(false), failed(false);
+			std::atomic<long long> busy_nanoseconds(0);
+			auto start = Clock::now();
+
+			for (int t = 0; t < num_threads; ++t) {
+				pool->Submit([&]() {
+					int slot;
+
+					while (true) {
+						num_ready.Acquire();
+
+						if (stop) {
+							break;
+						}
+
+						if (!ready.TryPop(slot)) {
+							continue;
+						}
+
+						auto evaluation_start = Clock::now();
+
+						try {
+							EvaluateRange(&in_flight[slot], &in_flight[slot] + 1, Batches());
+						}
+						catch (...) {
+							finished.Fail(std::current_exception());
+							failed = true;
+							num_done.Release(); // Wakes the calling thread
+							break;
+						}
+
+						busy_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - evaluation_start).count();
+						done.TryPush(slot);
+						num_done.Release();
+					}
+
+					finished.CountDown();
+				});
+			}
+
+			int num_submitted = 0, slot;
+
+			while (num_inserted < num_evaluations && !failed) {
+				while (num_submitted < num_evaluations && free_slots.size() >= 2) {
+					int first = free_slots.back();
+					free_slots.pop_back();
+					int second = free_slots.back();
+					free_slots.pop_back();
+
+					Breed(in_flight[first], in_flight[second]);
+
+					// There are as many cells as slots, so the pushes cannot fail
+					ready.TryPush(first);
+					ready.TryPush(second);
+					num_ready.Release(2);
+					num_submitted += 2;
+				}
+
+				// Sleeps until at least one evaluation is handed back
+				num_done.Acquire();
+
+				do {
+					if (done.TryPop(slot)) {
+						offspring.push_back(std::move(in_flight[slot]));
+						free_slots.push_back(slot);
+					}
+				} while (num_done.TryAcquire());
+
+				if (failed || (offspring.size() < batch_size && num_inserted + offspring.size() < num_evaluations)) {
+					continue;
+				}
+
+				num_inserted += offspring.size();
+				insert();
+				offspring.resize(0);
+			}
+
+			stop = true;
+			num_ready.Release(num_threads);
+			finished.Wait(); // Rethrows the exception of a failed evaluation
+
+			executor->Record(num_threads, std::chrono::duration<double>(Clock::now() - start).count(), busy_nanoseconds * 1e-9);
+		}
+
+		/*
+			Creates the parent population from seed individuals, e.g. solutions of a 
+			previous run on a shifted horizon, an earlier checkpoint or heuristics. 
+			Mutated copies of the seeds fill the population up to the seeded ratio 
+			and the rest are random individuals.
+		*/
+		template<class... ChromosomeParams>
+		void Seed(
+			int popsize,
+			const Population &seeds,
+			ChromosomeParams... params
+		)
+		{
+			indices.resize(popsize);
+			std::iota(indices.begin(), indices.end(), 0);
+			parents.reserve(popsize);
+			offspring.reserve(popsize);
+			parents.resize(0);
+
+			for (const auto &seed : seeds) {
+				if (parents.size() == popsize) {
+					break;
+				}
+
+				parents.push_back(std::move(Chromosome(seed.genes, params...)));
+			}
+
+			int num_seeds = parents.size();
+			int num_seeded = num_seeds ? std::min(popsize, std::max(num_seeds, (int)std::lround(seeded_ratio * popsize))) : 0;
+
+			for (int i = 0; parents.size() < num_seeded; ++i) {
+				parents.push_back(parents[i % num_seeds]);
+				parents.back().Mutate();
+			}
+
+			while (parents.size() < popsize) {
+				parents.push_back(std::move(Chromosome(params...)));
+			}
+		}
+
 	public:
 		explicit BaseGA() {}
+
+		/*
+			The GA owns a PoolExecutor with 'num_procs' threads, or all the hardware
+			threads if 'num_procs' is not positive or more than there are, the same as
+			the OpenMP default 0 and -1 used to leave, and with 1 thread evaluates in the
+			calling thread. The process-wide OpenMP settings are left alone.
+		*/
 		explicit BaseGA(
 			FitnessFunction fitness_function,
 			int seed,
@@ -91,13 +467,80 @@ namespace algorithms
 		{
 			utils::set_seed(seed);
 
-			int actual_num_threads = omp_get_num_procs();
+			int actual_num_threads = std::max(1u, std::thread::hardware_concurrency());
+			int num_threads = num_procs >= 1 && num_procs <= actual_num_threads ? num_procs : actual_num_threads;
 
-			if (num_procs >= 1 && num_procs <= actual_num_threads) {
-				omp_set_dynamic(0);
-				omp_set_num_threads(num_procs);
+			if (num_threads > 1) {
+				executor = std::make_shared<PoolExecutor>(num_threads);
 			}
 		}
+
+		// Sets the fraction of the population created from the seeds passed to Init, in [0, 1].
+		void SetSeededRatio(double seeded_ratio)
+		{
+			if (!(seeded_ratio >= 0.0 && seeded_ratio <= 1.0)) {
+				throw std::invalid_argument("Seeded ratio must be in [0, 1], is " + std::to_string(seeded_ratio) + ".");
+			}
+
+			this->seeded_ratio = seeded_ratio;
+		}
+
+		/*
+			Evaluates the chromosomes with 'executor' from now on, e.g. a PoolExecutor
+			pinned to some of the CPUs. GAs running on separate threads can share one,
+			as every call to Executor::Run waits for its own tasks only, and nullptr
+			makes the GA evaluate in the calling thread.
+		*/
+		void SetExecutor(std::shared_ptr<Executor> executor)
+		{
+			this->executor = executor;
+		}
+
+		inline std::shared_ptr<Executor> GetExecutor() const
+		{
+			return executor;
+		}
+
+		/*
+			If 'use_cutoff' is true, the fitness functions with batches, i.e. the
+			scheduling models, stop evaluating an offspring as soon as it cannot survive
+			the generation, see types::Cutoff. It is then marked as truncated and keeps
+			the objectives and constraints of the periods simulated so far. The
+			deterministic models end up with the same parents either way, the stochastic
+			ones draw fewer random numbers. Update is the only one to use it.
+		*/
+		void UseCutoff(bool use_cutoff)
+		{
+			this->use_cutoff = use_cutoff;
+		}
+
+		// Work of the evaluations with a cutoff so far.
+		inline const types::CutoffStats& GetCutoffStats() const
+		{
+			return cutoff_stats;
+		}
+
+		/*
+			If 'use_delta' is true, the offspring are evaluated from the snapshots of
+			their parents, see deterministic::SingleSiteSimpleModel::UseDelta, the only
+			fitness function to support it.
+		*/
+		void UseDelta(bool use_delta)
+		{
+			fitness_function.UseDelta(use_delta);
+		}
+
+		// Evaluations from the snapshot of a parent so far.
+		inline const types::DeltaStats& GetDeltaStats() const
+		{
+			return delta_stats;
+		}
+
+		// Returns the current parent population, e.g. to checkpoint a run.
+		Population Parents() const
+		{
+			return Released(parents);
+		}
 	};
 }
 
@@ -0,0 +1,316 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __BATCH_RUNNER_H__
+#define __BATCH_RUNNER_H__
+
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "nsgaii.h"
+#include "input_data.h"
+#include "thread_pool.h"
+#include "single_objective_ga.h"
+
+
+namespace algorithms
+{
+	// Top solution of the current population, i.e. what a run contributes to the result.
+	template<class Chromosome, class FitnessFunction>
+	std::vector<Chromosome> Front(SingleObjectiveGA<Chromosome, FitnessFunction> &ga)
+	{
+		return { ga.Top() };
+	}
+
+	template<class Chromosome, class FitnessFunction>
+	std::vector<Chromosome> Front(NSGAII<Chromosome, FitnessFunction> &ga)
+	{
+		return ga.TopFront();
+	}
+
+	// Top solution(s) out of the solutions of all the runs.
+	template<class Chromosome, class FitnessFunction>
+	std::vector<Chromosome> Best(SingleObjectiveGA<Chromosome, FitnessFunction> &ga, const std::vector<Chromosome> &solutions)
+	{
+		return { ga.Top(solutions) };
+	}
+
+	template<class Chromosome, class FitnessFunction>
+	std::vector<Chromosome> Best(NSGAII<Chromosome, FitnessFunction> &ga, const std::vector<Chromosome> &solutions)
+	{
+		return ga.TopFront(solutions);
+	}
+
+	// GA settings of a scenario, the defaults are the same as in the Python models.
+	struct GAParams
+	{
+		int num_runs = 10;
+		int num_gens = 1000;
+		int popsize = 100;
+		int starting_length = 1;
+		int seed = 7; // Run 'r' is seeded with 'seed + r'
+
+		double p_xo = 0.131266;
+		double p_gene_swap = 0.131266;
+		double p_product_mut = 0.131266;
+		double p_usp_suite_mut = 0.131266;
+		double p_plus_batch_mut = 0.131266;
+		double p_minus_batch_mut = 0.131266;
+		double seeded_ratio = 0.5;
+	};
+
+	template<class GA>
+	inline void InitPopulation(GA &ga, const GAParams &params, const deterministic::SingleSiteSimpleInputData &input_data)
+	{
+		ga.Init(
+			params.popsize,
+			params.starting_length,
+			params.p_xo,
+			params.p_gene_swap,
+			input_data.num_products,
+			params.p_product_mut,
+			params.p_plus_batch_mut,
+			params.p_minus_batch_mut
+		);
+	}
+
+	template<class GA>
+	inline void InitPopulation(GA &ga, const GAParams &params, const deterministic::SingleSiteMultiSuiteInputData &input_data)
+	{
+		ga.Init(
+			params.popsize,
+			params.starting_length,
+			params.p_xo,
+			params.p_gene_swap,
+			input_data.num_products,
+			input_data.num_usp_suites,
+			params.p_product_mut,
+			params.p_usp_suite_mut,
+			params.p_plus_batch_mut,
+			params.p_minus_batch_mut
+		);
+	}
+
+	/*
+		What-if variant of a site. Scenarios share the base input data, which is
+		copied only for the scenarios which 'modify' it, e.g. to scale the demand
+		or to add a suite. The copy is made once and shared by all the runs.
+	*/
+	template<class InputData>
+	struct Scenario
+	{
+		std::string name;
+		std::shared_ptr<const InputData> input_data;
+		std::function<void(InputData&)> modify;
+		GAParams params;
+	};
+
+	template<class Chromosome>
+	struct ScenarioResult
+	{
+		int scenario_num;
+		std::string name;
+		std::vector<Chromosome> solutions;
+		long long num_evaluations;
+		double seconds; // From the start of the batch until the last run of the scenario finished
+	};
+
+	/*
+		Fitness function of the GAs of the runs of a scenario, which share one model
+		and so one copy of its input data. The models only read their input data
+		while evaluating, so that the runs can share one from separate threads.
+	*/
+	template<class Model>
+	struct SharedModel
+	{
+		typedef typename Model::Workspace Workspace;
+
+		std::shared_ptr<Model> model;
+
+		template<class Chromosome>
+		inline void operator()(Chromosome &individual)
+		{
+			(*model)(individual);
+		}
+
+		template<class Chromosome>
+		inline void EvaluateBatch(Chromosome *begin, Chromosome *end, Workspace &workspace)
+		{
+			model->EvaluateBatch(begin, end, workspace);
+		}
+	};
+
+	/*
+		Runs the scenarios on a shared ThreadPool, with every run of every scenario
+		being a separate task. Each run uses its own GA, with a single OpenMP thread
+		for the evaluations and its own random sequence, i.e. the results do not
+		depend on the number of threads or the order in which the runs finish.
+		GA is either SingleObjectiveGA or NSGAII.
+	*/
+	template<template<class, class> class GA, class Chromosome, class Model, class InputData>
+	class BatchRunner
+	{
+		typedef std::chrono::steady_clock Clock;
+
+		struct State
+		{
+			std::mutex mutex;
+			std::shared_ptr<const InputData> input_data;
+			SharedModel<Model> model;
+			std::vector<std::vector<Chromosome>> fronts;
+			int num_remaining;
+			bool failed = false;
+		};
+
+		utils::ThreadPool &pool;
+
+	public:
+		typedef std::function<void(const ScenarioResult<Chromosome>&)> Callback;
+
+		explicit BatchRunner(utils::ThreadPool &pool) : pool(pool) {}
+
+		/*
+			Returns the results in the order of 'scenarios'. 'on_result' is called
+			as soon as a scenario has finished, one call at a time, from a worker,
+			and at once for the scenarios without runs, which have no solutions.
+			Waits for the tasks of this call only, so that other callers can share
+			the pool, and must not be called from a task of the pool. Rethrows the
+			first exception of a scenario once all the others finish; a scenario
+			which failed gets no result.
+		*/
+		std::vector<ScenarioResult<Chromosome>> Run(const std::vector<Scenario<InputData>> &scenarios, Callback on_result = nullptr)
+		{
+			auto start = Clock::now();
+
+			std::vector<ScenarioResult<Chromosome>> results(scenarios.size());
+			std::vector<std::unique_ptr<State>> states;
+			std::mutex callback_mutex;
+			int num_scenarios = 0;
+
+			for (int s = 0; s < scenarios.size(); ++s) {
+				states.emplace_back(new State());
+				states[s]->fronts.resize(scenarios[s].params.num_runs);
+				states[s]->num_remaining = scenarios[s].params.num_runs;
+
+				results[s].scenario_num = s;
+				results[s].name = scenarios[s].name;
+				results[s].num_evaluations = 0;
+				results[s].seconds = 0.0;
+
+				if (scenarios[s].params.num_runs > 0) {
+					++num_scenarios;
+				}
+				else if (on_result) {
+					on_result(results[s]);
+				}
+			}
+
+			// Counts down once per scenario with runs, after its last run
+			utils::Latch finished(num_scenarios);
+
+			for (int s = 0; s < scenarios.size(); ++s) {
+				if (scenarios[s].params.num_runs <= 0) {
+					continue;
+				}
+
+				pool.Submit([&, s]() {
+					const auto &scenario = scenarios[s];
+					auto &state = *states[s];
+
+					try {
+						if (scenario.modify) {
+							auto input_data = std::make_shared<InputData>(*scenario.input_data);
+							scenario.modify(*input_data);
+							state.input_data = input_data;
+						}
+						else {
+							state.input_data = scenario.input_data;
+						}
+
+						state.model.model = std::make_shared<Model>(*state.input_data);
+					}
+					catch (...) {
+						finished.Fail(std::current_exception());
+						finished.CountDown();
+						return;
+					}
+
+					for (int run = 0; run < scenario.params.num_runs; ++run) {
+						// Captures only the batch's locals, which outlive the tasks
+						pool.Submit([&scenarios, &states, &results, &callback_mutex, &on_result, &finished, start, s, run]() {
+							const auto &params = scenarios[s].params;
+							auto &state = *states[s];
+							bool counted = false;
+
+							try {
+								GA<Chromosome, SharedModel<Model>> ga(state.model, params.seed + run, 1);
+
+								ga.SetSeededRatio(params.seeded_ratio);
+								InitPopulation(ga, params, *state.input_data);
+
+								for (int gen = 0; gen < params.num_gens; ++gen) {
+									ga.Update();
+								}
+
+								auto front = Front(ga);
+								std::unique_lock<std::mutex> lock(state.mutex);
+
+								state.fronts[run] = std::move(front);
+								results[s].num_evaluations += (long long)params.popsize * (params.num_gens + 1);
+								counted = true;
+
+								if (--state.num_remaining) {
+									return;
+								}
+
+								if (!state.failed) {
+									// Last run of the scenario, the fronts are merged in the order of the runs
+									std::vector<Chromosome> solutions;
+
+									for (const auto &run_front : state.fronts) {
+										solutions.insert(solutions.end(), run_front.begin(), run_front.end());
+									}
+
+									state.fronts.clear();
+									results[s].solutions = Best(ga, solutions);
+									results[s].seconds = std::chrono::duration<double>(Clock::now() - start).count();
+									lock.unlock();
+
+									if (on_result) {
+										std::lock_guard<std::mutex> callback_lock(callback_mutex);
+										on_result(results[s]);
+									}
+								}
+							}
+							catch (...) {
+								finished.Fail(std::current_exception());
+								std::lock_guard<std::mutex> lock(state.mutex);
+								state.failed = true;
+
+								if (counted ? state.num_remaining : --state.num_remaining) {
+									return;
+								}
+							}
+
+							finished.CountDown();
+						});
+					}
+				});
+			}
+
+			finished.Wait();
+
+			return results;
+		}
+	};
+}
+
+#endif
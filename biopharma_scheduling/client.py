@@ -0,0 +1,336 @@
+'''
+    Client of the solver daemon, see 'biopharma_scheduling/daemon.cpp' and 'protocol.h'
+    for the messages. Only the standard library is imported, i.e. a short-lived process
+    can submit jobs without loading pandas or the models.
+
+    Example:
+
+        with SolverClient('/tmp/biopharma_scheduling.sock') as client:
+            settings = {
+                'model': 'simple',
+                'data_dir': 'tests/data/deterministic_single_site_simple',
+                'start_date': '2016-12-01',
+                'objectives': { 'total_kg_throughput': 1, 'total_kg_inventory_deficit': -1 },
+                'constraints': { 'total_kg_backlog': [-1, 0] }
+            }
+
+            for event, data in client.fit(dict(settings, num_runs=2, num_gens=100)):
+                if event == 'result':
+                    data['objectives'] # num solutions x num objectives list
+
+            client.evaluate(settings, [[('A', 10), ('B', 5)], [('C', 20)]])
+'''
+import socket
+import struct
+import itertools
+from collections import deque
+
+
+FIT_REQUEST = 1
+EVALUATE_REQUEST = 2
+CANCEL_REQUEST = 3
+
+INSTANCE_REPLY = 16
+PROGRESS_REPLY = 17
+FRONT_REPLY = 18
+RESULT_REPLY = 19
+OBJECTIVES_REPLY = 20
+DONE_REPLY = 21
+ERROR_REPLY = 22
+
+# In the order of deterministic::OBJECTIVES
+OBJECTIVES = [
+    'total_kg_inventory_deficit',
+    'total_kg_throughput',
+    'total_kg_backlog',
+    'total_kg_supply',
+    'total_kg_waste',
+    'total_batch_inventory_deficit',
+    'total_batch_throughput',
+    'total_batch_backlog',
+    'total_batch_supply',
+    'total_batch_waste',
+    'total_inventory_penalty',
+    'total_changeover_cost',
+    'total_backlog_penalty',
+    'total_production_cost',
+    'total_storage_cost',
+    'total_waste_cost',
+    'total_revenue',
+    'total_profit',
+    'total_cost'
+]
+
+
+class SolverError(Exception):
+    pass
+
+
+def _write_varint(value, buffer):
+    while value >= 0x80:
+        buffer.append((value & 0x7F) | 0x80)
+        value >>= 7
+
+    buffer.append(value)
+
+
+def _write_string(value, buffer):
+    data = value.encode()
+    _write_varint(len(data), buffer)
+    buffer += data
+
+
+class _Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self):
+        value = shift = 0
+
+        while True:
+            if self.pos >= len(self.data):
+                raise SolverError('Truncated message')
+
+            byte = self.data[self.pos]
+            self.pos += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+
+            if not byte & 0x80:
+                return value
+
+    def zigzag(self):
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def double(self):
+        value, = struct.unpack_from('=d', self.data, self.pos)
+        self.pos += 8
+        return value
+
+    def string(self):
+        length = self.varint()
+        self.pos += length
+        return bytes(self.data[self.pos - length:self.pos]).decode()
+
+    def frame(self):
+        '''
+            History frame as a dictionary with the same keys as 'HistoryFile.front'.
+        '''
+        self.varint()
+        run, gen, num_solutions, num_objectives, num_fields = [self.varint() for _ in range(5)]
+        frame = { 'run': run, 'gen': gen, 'constraints': [], 'objectives': [], 'genes': [] }
+
+        for _ in range(num_solutions):
+            frame['constraints'].append(self.double())
+            frame['objectives'].append([self.double() for _ in range(num_objectives)])
+            fields = [self.zigzag() for _ in range(self.varint() * num_fields)]
+            frame['genes'].append([fields[i:i + num_fields] for i in range(0, len(fields), num_fields)])
+
+        return frame
+
+
+def _format_settings(settings):
+    '''
+        Converts the settings into 'key = value' lines, 'objectives' and 'constraints'
+        are dictionaries as in the 'fit' method of the models.
+    '''
+    lines = []
+
+    for key, value in settings.items():
+        if key == 'objectives':
+            value = ', '.join('{}: {}'.format(obj, coef) for obj, coef in value.items())
+        elif key == 'constraints':
+            value = ', '.join('{}: {}: {}'.format(cons, coef, bound) for cons, (coef, bound) in value.items())
+        elif isinstance(value, bool):
+            value = 'true' if value else 'false'
+
+        lines.append('{} = {}'.format(key, value))
+
+    return '\n'.join(lines)
+
+
+class SolverClient:
+    '''
+        Connection to the solver daemon. Jobs of the same client can run at the same
+        time, e.g. from several threads, as long as each of them is read by one thread.
+    '''
+    def __init__(self, path: str='/tmp/biopharma_scheduling.sock'):
+        self.socket = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.socket.connect(path)
+        self.buffer = bytearray()
+        self.replies = {}
+        self.cancelled = set()
+        self.job_ids = itertools.count(1)
+
+    def close(self):
+        self.socket.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __send(self, message_type, job_id, payload=b''):
+        header = bytearray()
+        _write_varint(message_type, header)
+        _write_varint(job_id, header)
+
+        message = bytearray()
+        _write_varint(len(header) + len(payload), message)
+        self.socket.sendall(bytes(message + header + payload))
+
+    def __receive(self, job_id):
+        '''
+            Returns the next reply of the job, keeping the replies of the other jobs.
+        '''
+        while not self.replies.get(job_id):
+            data = self.socket.recv(1 << 16)
+
+            if not data:
+                raise SolverError('The daemon has closed the connection')
+
+            self.buffer += data
+
+            while True:
+                reader = _Reader(self.buffer)
+
+                try:
+                    size = reader.varint()
+                except SolverError:
+                    break
+
+                if len(self.buffer) - reader.pos < size:
+                    break
+
+                end = reader.pos + size
+                message_type, reply_job_id = reader.varint(), reader.varint()
+
+                if reply_job_id in self.cancelled:
+                    if message_type in (DONE_REPLY, ERROR_REPLY):
+                        self.cancelled.discard(reply_job_id)
+                else:
+                    self.replies.setdefault(reply_job_id, deque()).append((message_type, self.buffer[reader.pos:end]))
+
+                del self.buffer[:end]
+
+        return self.replies[job_id].popleft()
+
+    def __submit(self, message_type, settings, tables=None):
+        job_id = next(self.job_ids)
+        payload = bytearray()
+        _write_string(_format_settings(settings), payload)
+
+        if tables is not None:
+            payload += tables
+
+        self.__send(message_type, job_id, payload)
+        return job_id
+
+    def __events(self, job_id):
+        while True:
+            message_type, payload = self.__receive(job_id)
+            reader = _Reader(payload)
+
+            if message_type == ERROR_REPLY:
+                self.replies.pop(job_id, None)
+                raise SolverError(reader.string())
+
+            if message_type == DONE_REPLY:
+                self.replies.pop(job_id, None)
+                return
+
+            if message_type == INSTANCE_REPLY:
+                objectives = [(reader.string(), reader.zigzag()) for _ in range(reader.varint())]
+                yield 'instance', {
+                    'objectives': objectives,
+                    'product_labels': [reader.string() for _ in range(reader.varint())]
+                }
+            elif message_type == PROGRESS_REPLY:
+                yield 'progress', {
+                    'run': reader.varint(),
+                    'gen': reader.varint(),
+                    'num_evaluations': reader.varint(),
+                    'seconds': reader.double()
+                }
+            elif message_type in (FRONT_REPLY, RESULT_REPLY):
+                yield 'front' if message_type == FRONT_REPLY else 'result', reader.frame()
+            elif message_type == OBJECTIVES_REPLY:
+                num_tables, num_values = reader.varint(), reader.varint()
+                yield 'objectives', [[reader.double() for _ in range(num_values)] for _ in range(num_tables)]
+
+    def fit(self, settings: dict):
+        '''
+            Runs the GA with the settings of the command line solver (see examples/solver.cfg)
+            and yields (event, data) pairs as they arrive:
+
+                'instance': objectives with their coefficients and the product labels
+                'progress': run, gen, num_evaluations and seconds since the submission
+                'front': front of a finished run as in 'HistoryFile.front', with 'run' and 'gen'
+                'result': best solutions of all the runs
+
+            The objectives in the fronts are minimised, i.e. multiplied by their coefficient
+            and -1. Raises SolverError if the job fails. Closing the generator early cancels
+            the job.
+        '''
+        job_id = self.__submit(FIT_REQUEST, settings)
+        finished = False
+
+        try:
+            for event in self.__events(job_id):
+                yield event
+
+            finished = True
+        finally:
+            if not finished:
+                self.cancel(job_id)
+
+    def evaluate(self, settings: dict, campaigns_list: list):
+        '''
+            Evaluates the campaign tables, which are lists of (product, batches) pairs for
+            the 'simple' model or (product, USP suite, batches) triplets for 'multi_suite',
+            or tables with the 'Product', ['Suite',] and 'Batches' columns. Campaigns in
+            DSP suites are skipped as they follow from the USP ones. Returns a dictionary
+            per table with the values of all the OBJECTIVES.
+        '''
+        multi_suite = settings.get('model') == 'multi_suite'
+        tables = bytearray()
+        _write_varint(len(campaigns_list), tables)
+
+        for campaigns in campaigns_list:
+            if hasattr(campaigns, 'Product'):
+                campaigns = zip(campaigns.Product, campaigns.Suite, campaigns.Batches) if multi_suite else \
+                    zip(campaigns.Product, campaigns.Batches)
+
+            if multi_suite:
+                campaigns = [c for c in campaigns if not str(c[1]).startswith('DSP')]
+            else:
+                campaigns = list(campaigns)
+
+            _write_varint(len(campaigns), tables)
+
+            for campaign in campaigns:
+                _write_string(str(campaign[0]), tables)
+
+                if multi_suite:
+                    _write_string(str(campaign[1]), tables)
+
+                _write_varint(int(campaign[-1]), tables)
+
+        job_id = self.__submit(EVALUATE_REQUEST, settings, tables)
+
+        for event, data in self.__events(job_id):
+            if event == 'objectives':
+                results = [dict(zip(OBJECTIVES, values)) for values in data]
+
+        return results
+
+    def cancel(self, job_id: int):
+        '''
+            Stops the job, its remaining replies are dropped.
+        '''
+        self.__send(CANCEL_REQUEST, job_id)
+        self.replies.pop(job_id, None)
+        self.cancelled.add(job_id)
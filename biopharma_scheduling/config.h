@@ -0,0 +1,280 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __CONFIG_H__
+#define __CONFIG_H__
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+#include <istream>
+#include <utility>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "input_data.h"
+
+
+namespace io
+{
+	// Names of the objectives, the same as AVAILABLE_OBJECTIVES of the Python models.
+	inline const std::vector<std::pair<std::string, deterministic::OBJECTIVES>>& ObjectiveNames()
+	{
+		static const std::vector<std::pair<std::string, deterministic::OBJECTIVES>> names = {
+			{ "total_kg_inventory_deficit", deterministic::TOTAL_KG_INVENTORY_DEFICIT },
+			{ "total_kg_throughput", deterministic::TOTAL_KG_THROUGHPUT },
+			{ "total_kg_backlog", deterministic::TOTAL_KG_BACKLOG },
+			{ "total_kg_supply", deterministic::TOTAL_KG_SUPPLY },
+			{ "total_kg_waste", deterministic::TOTAL_KG_WASTE },
+			{ "total_batch_inventory_deficit", deterministic::TOTAL_BATCH_INVENTORY_DEFICIT },
+			{ "total_batch_throughput", deterministic::TOTAL_BATCH_THROUGHPUT },
+			{ "total_batch_backlog", deterministic::TOTAL_BATCH_BACKLOG },
+			{ "total_batch_supply", deterministic::TOTAL_BATCH_SUPPLY },
+			{ "total_batch_waste", deterministic::TOTAL_BATCH_WASTE },
+			{ "total_inventory_penalty", deterministic::TOTAL_INVENTORY_PENALTY },
+			{ "total_changeover_cost", deterministic::TOTAL_CHANGEOVER_COST },
+			{ "total_backlog_penalty", deterministic::TOTAL_BACKLOG_PENALTY },
+			{ "total_production_cost", deterministic::TOTAL_PRODUCTION_COST },
+			{ "total_storage_cost", deterministic::TOTAL_STORAGE_COST },
+			{ "total_waste_cost", deterministic::TOTAL_WASTE_COST },
+			{ "total_revenue", deterministic::TOTAL_REVENUE },
+			{ "total_profit", deterministic::TOTAL_PROFIT },
+			{ "total_cost", deterministic::TOTAL_COST }
+		};
+
+		return names;
+	}
+
+	inline const std::string& ObjectiveName(deterministic::OBJECTIVES objective)
+	{
+		for (const auto &name : ObjectiveNames()) {
+			if (name.second == objective) return name.first;
+		}
+
+		throw std::out_of_range("Unknown objective " + std::to_string((int)objective) + ".");
+	}
+
+	inline deterministic::OBJECTIVES ParseObjective(const std::string &objective)
+	{
+		for (const auto &name : ObjectiveNames()) {
+			if (name.first == objective) return name.second;
+		}
+
+		throw std::runtime_error("'" + objective + "' is not allowed as an objective.");
+	}
+
+	/*
+		Flat 'key = value' settings, one per line, with '#' starting a comment.
+		Later settings override the earlier ones, e.g. command line arguments
+		override a config file.
+	*/
+	class Config
+	{
+		std::map<std::string, std::string> values;
+
+		static std::string Trim(const std::string &str)
+		{
+			size_t begin = str.find_first_not_of(" \t\r\n");
+			size_t end = str.find_last_not_of(" \t\r\n");
+
+			return begin == std::string::npos ? "" : str.substr(begin, end - begin + 1);
+		}
+
+		static std::vector<std::string> Split(const std::string &str, char sep)
+		{
+			std::vector<std::string> items;
+			size_t begin = 0, end;
+
+			do {
+				end = str.find(sep, begin);
+				items.push_back(Trim(str.substr(begin, end == std::string::npos ? end : end - begin)));
+				begin = end + 1;
+			} while (end != std::string::npos);
+
+			return items;
+		}
+
+		const std::string& Value(const std::string &key) const
+		{
+			auto it = values.find(key);
+
+			if (it == values.end()) {
+				throw std::runtime_error("Missing '" + key + "' setting.");
+			}
+
+			return it->second;
+		}
+
+		template<class T>
+		T Convert(const std::string &key, T (*convert)(const char*, char**)) const
+		{
+			const auto &value = Value(key);
+			char *end = nullptr;
+			T converted = convert(value.c_str(), &end);
+
+			if (value.empty() || *end) {
+				throw std::runtime_error("'" + key + "' must be a number, is '" + value + "'.");
+			}
+
+			return converted;
+		}
+
+		static long ToLong(const char *str, char **end)
+		{
+			return std::strtol(str, end, 10);
+		}
+
+	public:
+		Config() {}
+
+		// Throws std::runtime_error if the file cannot be read or a line has no '='.
+		explicit Config(const std::string &path)
+		{
+			std::ifstream file(path);
+
+			if (!file) {
+				throw std::runtime_error("Cannot open '" + path + "'");
+			}
+
+			Parse(file, path);
+		}
+
+		// Reads the lines of a config file, 'source' names it in the errors.
+		void Parse(std::istream &lines, const std::string &source)
+		{
+			std::string line;
+
+			for (int line_num = 1; std::getline(lines, line); ++line_num) {
+				line = Trim(line.substr(0, line.find('#')));
+
+				if (line.empty()) {
+					continue;
+				}
+
+				if (!Set(line)) {
+					throw std::runtime_error(source + ":" + std::to_string(line_num) + ": expected 'key = value'.");
+				}
+			}
+		}
+
+		// Sets a 'key = value' pair, returns false if there is no '='.
+		bool Set(const std::string &setting)
+		{
+			size_t sep = setting.find('=');
+
+			if (sep == std::string::npos || !sep) {
+				return false;
+			}
+
+			values[Trim(setting.substr(0, sep))] = Trim(setting.substr(sep + 1));
+
+			return true;
+		}
+
+		inline bool Has(const std::string &key) const
+		{
+			return values.count(key);
+		}
+
+		std::vector<std::string> Keys() const
+		{
+			std::vector<std::string> keys;
+
+			for (const auto &it : values) {
+				keys.push_back(it.first);
+			}
+
+			return keys;
+		}
+
+		inline std::string String(const std::string &key, const std::string &default_value) const
+		{
+			return Has(key) ? Value(key) : default_value;
+		}
+
+		inline int Int(const std::string &key, int default_value) const
+		{
+			return Has(key) ? (int)Convert<long>(key, ToLong) : default_value;
+		}
+
+		inline double Double(const std::string &key, double default_value) const
+		{
+			return Has(key) ? Convert<double>(key, std::strtod) : default_value;
+		}
+
+		bool Bool(const std::string &key, bool default_value) const
+		{
+			if (!Has(key)) {
+				return default_value;
+			}
+
+			const auto &value = Value(key);
+
+			if (value == "true" || value == "1" || value == "yes") return true;
+			if (value == "false" || value == "0" || value == "no") return false;
+
+			throw std::runtime_error("'" + key + "' must be true or false, is '" + value + "'.");
+		}
+
+		/*
+			Objectives with their coefficients, the same as the 'objectives' dict of
+			the Python models, e.g. 'total_kg_throughput: 1, total_kg_backlog: -1'.
+		*/
+		std::unordered_map<deterministic::OBJECTIVES, int> Objectives(const std::string &key) const
+		{
+			std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+
+			for (const auto &item : Split(Value(key), ',')) {
+				auto parts = Split(item, ':');
+
+				if (parts.size() != 2 || (parts[1] != "1" && parts[1] != "-1")) {
+					throw std::runtime_error("'" + key + "' expects 'objective: 1 or -1' items, found '" + item + "'.");
+				}
+
+				objectives[ParseObjective(parts[0])] = std::stoi(parts[1]);
+			}
+
+			return objectives;
+		}
+
+		/*
+			Constraints with their coefficients and bounds, the same as the 'constraints'
+			dict of the Python models, e.g. 'total_kg_backlog: -1: 0' for backlog <= 0.
+		*/
+		std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> Constraints(const std::string &key) const
+		{
+			std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> constraints;
+
+			if (!Has(key) || Value(key).empty()) {
+				return constraints;
+			}
+
+			for (const auto &item : Split(Value(key), ',')) {
+				auto parts = Split(item, ':');
+				char *end = nullptr;
+
+				if (parts.size() != 3 || (parts[1] != "1" && parts[1] != "-1")) {
+					throw std::runtime_error("'" + key + "' expects 'constraint: 1 or -1: bound' items, found '" + item + "'.");
+				}
+
+				double bound = std::strtod(parts[2].c_str(), &end);
+
+				if (parts[2].empty() || *end) {
+					throw std::runtime_error("'" + key + "' has a bound which is not a number in '" + item + "'.");
+				}
+
+				constraints[ParseObjective(parts[0])] = std::make_pair(std::stoi(parts[1]), bound);
+			}
+
+			return constraints;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,75 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __CUTOFF_H__
+#define __CUTOFF_H__
+
+#include <cmath>
+#include <limits>
+
+#include "utils.h"
+
+
+namespace types
+{
+	/*
+		Bounds beyond which an individual cannot survive the generation, see
+		BaseGA::UseCutoff. 'constraints' bounds the constraints value and 'objective'
+		the objective of a single-objective chromosome. The constraint violations of
+		the objectives which only accumulate over the periods, e.g. the backlog, and
+		such an objective if it is minimised, are lower bounds of their final values
+		at any point of a simulation, so the models stop simulating an individual as
+		soon as one of them exceeds its bound.
+	*/
+	struct Cutoff
+	{
+		double constraints = std::numeric_limits<double>::infinity();
+		double objective = std::numeric_limits<double>::infinity();
+
+		inline bool IsActive() const
+		{
+			return std::isfinite(constraints) || std::isfinite(objective);
+		}
+
+		/*
+			With a margin over the bound, as the GAs compare the constraints values
+			approximately and the objectives below utils::EPSILON are rounded to 0.
+		*/
+		static inline bool Exceeds(double value, double bound)
+		{
+			return value > bound + 1e-3 * std::fabs(bound) + utils::EPSILON;
+		}
+	};
+
+	// Work of the evaluations with a Cutoff, a period being that of one product.
+	struct CutoffStats
+	{
+		long long num_evaluations = 0;
+		long long num_cut_off = 0;
+		long long num_periods = 0;       // Simulated
+		long long num_periods_saved = 0; // Not simulated by the evaluations which were cut off
+
+		CutoffStats& operator+=(const CutoffStats &other)
+		{
+			num_evaluations += other.num_evaluations;
+			num_cut_off += other.num_cut_off;
+			num_periods += other.num_periods;
+			num_periods_saved += other.num_periods_saved;
+
+			return *this;
+		}
+
+		// Fraction of the periods of the full simulations which were not simulated.
+		inline double SavedFraction() const
+		{
+			long long total = num_periods + num_periods_saved;
+			return total ? (double)num_periods_saved / total : 0.0;
+		}
+	};
+}
+
+#endif
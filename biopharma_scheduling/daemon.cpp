@@ -0,0 +1,872 @@
+/*
+	Solver daemon of the deterministic single site models. Keeps the loaded instances
+	and a thread pool warm, and runs the fit and evaluate jobs of any number of clients
+	connected over a Unix domain socket, see protocol.h for the messages and client.py
+	for a Python client. POSIX only.
+
+	g++ -O2 -std=c++14 -fopenmp -m64 -pthread biopharma_scheduling/daemon.cpp -o biopharma_scheduling_daemon.out
+	./biopharma_scheduling_daemon.out /tmp/biopharma_scheduling.sock [num_jobs] [max_instances]
+
+	'num_jobs' jobs run at the same time (all the hardware threads by default), the
+	others wait in the queue. A fit uses 'num_threads' threads, 1 by default, or a thread
+	pinned to each CPU of 'cpus', e.g. '0-3,8', of a pool which the daemon keeps for the
+	later fits with the same threads. An evaluation uses 'num_threads' OpenMP threads of
+	its own, leaving the process-wide OpenMP settings alone. A client which does not read
+	its replies is disconnected once MAX_OUTPUT_SIZE bytes of them are queued.
+	Instances are cached by their settings, i.e. changes to the CSV files are picked
+	up only once they are evicted or the daemon is restarted.
+*/
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+
+#include "config.h"
+#include "loader.h"
+#include "protocol.h"
+#include "executor.h"
+#include "evaluation.h"
+#include "batch_runner.h"
+#include "thread_pool.h"
+#include "scheduling_models.h"
+
+
+typedef std::chrono::steady_clock Clock;
+
+const std::vector<std::string> INSTANCE_SETTINGS = {
+	"model", "data_dir", "start_date", "objectives", "constraints", "num_usp_suites", "num_dsp_suites"
+};
+
+const std::vector<std::string> FIT_SETTINGS = {
+	"num_runs", "num_gens", "popsize", "starting_length", "p_xo", "p_product_mut", "p_usp_suite_mut",
+	"p_plus_batch_mut", "p_minus_batch_mut", "p_gene_swap", "num_threads", "cpus", "random_state", "seeded_ratio",
+	"time_limit", "progress_interval"
+};
+
+const std::vector<std::string> EVALUATE_SETTINGS = { "num_threads" };
+
+// Replies queued for a client, over which it is disconnected
+const size_t MAX_OUTPUT_SIZE = 64 << 20;
+
+// Self-pipe which wakes up the event loop when a job has replies or a signal arrives
+int wake_fds[2] = { -1, -1 };
+volatile std::sig_atomic_t stopping = 0;
+
+inline void Wake()
+{
+	char byte = 0;
+	ssize_t written = write(wake_fds[1], &byte, 1);
+	(void)written;
+}
+
+void Stop(int)
+{
+	stopping = 1;
+	Wake();
+}
+
+inline double Seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+inline void SetNonBlocking(int fd)
+{
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+/*
+	Removes the socket left at 'path' by a previous daemon. Throws std::runtime_error
+	if anything other than a socket is there, e.g. the file of a mistyped path.
+*/
+void RemoveSocket(const std::string &path)
+{
+	struct stat status;
+
+	if (lstat(path.c_str(), &status)) {
+		if (errno == ENOENT) {
+			return;
+		}
+
+		throw std::runtime_error("Cannot stat '" + path + "': " + std::strerror(errno));
+	}
+
+	if (!S_ISSOCK(status.st_mode)) {
+		throw std::runtime_error("'" + path + "' exists and is not a socket.");
+	}
+
+	if (unlink(path.c_str())) {
+		throw std::runtime_error("Cannot remove '" + path + "': " + std::strerror(errno));
+	}
+}
+
+/*
+	Client connection. The jobs append their replies to 'output' from the workers
+	and the event loop writes them out as soon as the socket accepts them.
+*/
+struct Connection
+{
+	int fd;
+	io::MessageBuffer input;
+
+	std::mutex mutex;
+	std::string output;
+	bool closed = false;
+	bool overflowed = false; // The client did not read its replies, see MAX_OUTPUT_SIZE
+	std::map<uint64_t, std::shared_ptr<std::atomic<bool>>> jobs; // Cancellation flags of the jobs
+
+	explicit Connection(int fd) : fd(fd) {}
+
+	// Replies of a closed or overflowed connection are dropped.
+	void Send(int type, uint64_t job_id, const std::string &payload)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (closed || overflowed) {
+				return;
+			}
+
+			std::string message = io::EncodeMessage(type, job_id, payload);
+
+			if (output.size() + message.size() > MAX_OUTPUT_SIZE) {
+				overflowed = true;
+			}
+			else {
+				output += message;
+			}
+		}
+
+		Wake();
+	}
+};
+
+/*
+	Executors of the fits, kept for the later fits with the same threads. A fit
+	takes an idle executor of its threads, or a new one if they are all taken,
+	and hands it back once it finishes.
+*/
+class ExecutorCache
+{
+	std::mutex mutex;
+	std::map<std::string, std::vector<std::shared_ptr<algorithms::Executor>>> idle;
+
+public:
+	template<class Make>
+	std::shared_ptr<algorithms::Executor> Acquire(const std::string &key, Make make)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto &executors = idle[key];
+
+			if (!executors.empty()) {
+				auto executor = executors.back();
+				executors.pop_back();
+				return executor;
+			}
+		}
+
+		return make();
+	}
+
+	void Release(const std::string &key, std::shared_ptr<algorithms::Executor> executor)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		idle[key].push_back(std::move(executor));
+	}
+};
+
+// Executor of a fit, which is handed back to the cache when it goes out of scope.
+class ExecutorLease
+{
+	ExecutorCache &cache;
+	std::string key;
+	std::shared_ptr<algorithms::Executor> executor;
+
+public:
+	/*
+		A pool with a thread pinned to each CPU of 'cpus' if it is not empty, else
+		with 'num_threads' threads, or all the hardware threads if it is not
+		positive or more than there are. No executor for a single thread.
+	*/
+	ExecutorLease(ExecutorCache &cache, int num_threads, const std::vector<int> &cpus) : cache(cache)
+	{
+		int actual_num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+		if (num_threads < 1 || num_threads > actual_num_threads) {
+			num_threads = actual_num_threads;
+		}
+
+		if (cpus.empty() && num_threads == 1) {
+			return;
+		}
+
+		key = cpus.empty() ? "threads " + std::to_string(num_threads) : "cpus";
+
+		for (int cpu : cpus) {
+			key += " " + std::to_string(cpu);
+		}
+
+		executor = cache.Acquire(key, [&]() {
+			return cpus.empty() ?
+				std::make_shared<algorithms::PoolExecutor>(num_threads) :
+				std::make_shared<algorithms::PoolExecutor>(cpus.size(), 4, cpus);
+		});
+	}
+
+	ExecutorLease(const ExecutorLease&) = delete;
+	ExecutorLease& operator=(const ExecutorLease&) = delete;
+
+	~ExecutorLease()
+	{
+		if (executor) {
+			cache.Release(key, std::move(executor));
+		}
+	}
+
+	inline std::shared_ptr<algorithms::Executor> Get() const
+	{
+		return executor;
+	}
+};
+
+template<class Instance, class Model>
+struct Warm
+{
+	Instance instance;
+	Model model;
+
+	explicit Warm(Instance &&loaded) : instance(std::move(loaded)), model(instance.input_data) {}
+};
+
+/*
+	Loaded instances with their models, keyed by the settings they were loaded with.
+	The least recently used ones are dropped once there are more than 'max_size' of
+	them, the jobs which still use them keep them alive until they finish.
+*/
+template<class Instance, class Model>
+class InstanceCache
+{
+	struct Entry
+	{
+		std::shared_ptr<Warm<Instance, Model>> warm;
+		uint64_t last_used;
+	};
+
+	std::mutex mutex;
+	std::map<std::string, Entry> entries;
+	uint64_t num_uses = 0;
+	size_t max_size;
+
+public:
+	explicit InstanceCache(size_t max_size) : max_size(std::max<size_t>(1, max_size)) {}
+
+	template<class Load>
+	std::shared_ptr<Warm<Instance, Model>> Get(const std::string &key, Load load)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto it = entries.find(key);
+
+			if (it != entries.end()) {
+				it->second.last_used = ++num_uses;
+				return it->second.warm;
+			}
+		}
+
+		// Loaded without the lock, i.e. the jobs of the other instances are not held up
+		auto warm = std::make_shared<Warm<Instance, Model>>(load());
+
+		std::lock_guard<std::mutex> lock(mutex);
+		entries[key] = Entry{ warm, ++num_uses };
+
+		while (entries.size() > max_size) {
+			auto oldest = entries.begin();
+
+			for (auto it = entries.begin(); it != entries.end(); ++it) {
+				if (it->second.last_used < oldest->second.last_used) oldest = it;
+			}
+
+			entries.erase(oldest);
+		}
+
+		return warm;
+	}
+};
+
+std::string InstanceKey(const io::Config &config)
+{
+	std::string key;
+
+	for (const auto &setting : INSTANCE_SETTINGS) {
+		key += setting + "=" + config.String(setting, "") + "\n";
+	}
+
+	return key;
+}
+
+template<class Instance>
+std::string InstancePayload(const Instance &instance)
+{
+	std::string payload;
+
+	io::WriteVarint(instance.input_data.objectives.size(), payload);
+
+	for (const auto &objective : instance.input_data.objectives) {
+		io::WriteString(io::ObjectiveName(objective.first), payload);
+		io::WriteZigZag(objective.second, payload);
+	}
+
+	io::WriteVarint(instance.product_labels.size(), payload);
+
+	for (const auto &label : instance.product_labels) {
+		io::WriteString(label, payload);
+	}
+
+	return payload;
+}
+
+algorithms::GAParams ReadParams(const io::Config &config)
+{
+	algorithms::GAParams params;
+
+	params.num_runs = config.Int("num_runs", params.num_runs);
+	params.num_gens = config.Int("num_gens", params.num_gens);
+	params.popsize = config.Int("popsize", params.popsize);
+	params.starting_length = config.Int("starting_length", params.starting_length);
+	params.seed = config.Int("random_state", std::random_device{}());
+	params.p_xo = config.Double("p_xo", params.p_xo);
+	params.p_gene_swap = config.Double("p_gene_swap", params.p_gene_swap);
+	params.p_product_mut = config.Double("p_product_mut", params.p_product_mut);
+	params.p_usp_suite_mut = config.Double("p_usp_suite_mut", params.p_usp_suite_mut);
+	params.p_plus_batch_mut = config.Double("p_plus_batch_mut", params.p_plus_batch_mut);
+	params.p_minus_batch_mut = config.Double("p_minus_batch_mut", params.p_minus_batch_mut);
+	params.seeded_ratio = config.Double("seeded_ratio", params.seeded_ratio);
+
+	return params;
+}
+
+int ProductNum(const std::vector<std::string> &product_labels, const std::string &label)
+{
+	auto it = std::find(product_labels.begin(), product_labels.end(), label);
+
+	if (it == product_labels.end()) {
+		throw std::runtime_error("Unknown product '" + label + "'.");
+	}
+
+	return it - product_labels.begin() + 1;
+}
+
+inline void ReadGene(io::PayloadReader &reader, const io::SingleSiteSimpleInstance &instance, types::SingleSiteSimpleGene &gene)
+{
+	gene.product_num = ProductNum(instance.product_labels, reader.String());
+	gene.num_batches = types::GeneField(reader.Varint());
+}
+
+inline void ReadGene(io::PayloadReader &reader, const io::SingleSiteMultiSuiteInstance &instance, types::SingleSiteMultiSuiteGene &gene)
+{
+	gene.product_num = ProductNum(instance.product_labels, reader.String());
+
+	std::string suite = reader.String();
+	char *end = nullptr;
+	long suite_num = suite.compare(0, 3, "USP") ? 0 : std::strtol(suite.c_str() + 3, &end, 10);
+
+	if (suite_num < 1 || suite_num > instance.input_data.num_usp_suites || *end) {
+		throw std::runtime_error("Unknown USP suite '" + suite + "'.");
+	}
+
+	gene.usp_suite_num = suite_num;
+	gene.num_batches = types::GeneField(reader.Varint());
+}
+
+/*
+	Runs the GA like the command line solver, streaming the progress every
+	'progress_interval' generations and the front of every run as it finishes.
+*/
+template<template<class, class> class GA, class Chromosome, class Instance, class Model>
+void Fit(Connection &connection, uint64_t job_id, const io::Config &config, Warm<Instance, Model> &warm, ExecutorCache &executors, const std::atomic<bool> &cancelled, Clock::time_point received)
+{
+	auto params = ReadParams(config);
+	int progress_interval = config.Int("progress_interval", 10);
+	double time_limit = config.Double("time_limit", 0.0);
+
+	std::vector<int> cpus;
+
+	if (config.Has("cpus")) {
+		cpus = utils::ParseCpuList(config.String("cpus", ""));
+	}
+
+	// Created with a single thread, i.e. without a pool of its own
+	ExecutorLease executor(executors, config.Int("num_threads", 1), cpus);
+	GA<Chromosome, Model> ga(warm.model, params.seed, 1);
+	ga.SetExecutor(executor.Get());
+	ga.SetSeededRatio(params.seeded_ratio);
+
+	std::vector<Chromosome> solutions;
+	std::string frame, body, payload;
+	long long num_evaluations = 0;
+	bool stopped = false;
+	int run = 0;
+
+	for (; run < params.num_runs && !stopped; ++run) {
+		algorithms::InitPopulation(ga, params, warm.instance.input_data);
+		num_evaluations += params.popsize;
+
+		int gen = 0;
+
+		while (gen < params.num_gens && !stopped) {
+			ga.Update();
+			num_evaluations += params.popsize;
+			++gen;
+
+			stopped = cancelled || (time_limit > 0.0 && Seconds(received) >= time_limit);
+
+			if (progress_interval > 0 && (gen % progress_interval == 0 || gen == params.num_gens || stopped)) {
+				payload.clear();
+				io::WriteVarint(run, payload);
+				io::WriteVarint(gen, payload);
+				io::WriteVarint(num_evaluations, payload);
+				io::WriteDouble(Seconds(received), payload);
+				connection.Send(io::PROGRESS_REPLY, job_id, payload);
+			}
+		}
+
+		// TopFront of NSGAII moves the front out, i.e. it is taken only once per run
+		auto front = algorithms::Front(ga);
+
+		io::EncodeFrame(run, gen, front, frame, body);
+		connection.Send(io::FRONT_REPLY, job_id, frame);
+
+		solutions.insert(solutions.end(), front.begin(), front.end());
+	}
+
+	io::EncodeFrame(run, 0, algorithms::Best(ga, solutions), frame, body);
+	connection.Send(io::RESULT_REPLY, job_id, frame);
+}
+
+template<class Gene, class Schedule, class Instance, class Model>
+void Evaluate(Connection &connection, uint64_t job_id, const io::Config &config, io::PayloadReader &reader, Warm<Instance, Model> &warm)
+{
+	std::vector<types::NSGAChromosome<Gene>> chromosomes;
+	uint64_t num_tables = reader.Varint();
+
+	// The counts are not trusted for the allocations, a truncated request throws instead
+	for (uint64_t t = 0; t < num_tables; ++t) {
+		uint64_t num_campaigns = reader.Varint();
+		chromosomes.emplace_back();
+
+		for (uint64_t c = 0; c < num_campaigns; ++c) {
+			chromosomes.back().genes.emplace_back();
+			ReadGene(reader, warm.instance, chromosomes.back().genes.back());
+		}
+	}
+
+	if (!reader.AtEnd()) {
+		throw std::runtime_error("Unexpected data after the campaign tables.");
+	}
+
+	std::vector<std::vector<double>> objectives;
+	deterministic::EvaluateObjectives<Schedule>(warm.model, chromosomes, objectives, std::max(1, config.Int("num_threads", 1)));
+
+	std::string payload;
+	io::WriteVarint(objectives.size(), payload);
+	io::WriteVarint(deterministic::NUM_OBJECTIVES, payload);
+
+	for (const auto &values : objectives) {
+		for (double value : values) {
+			io::WriteDouble(value, payload);
+		}
+	}
+
+	connection.Send(io::OBJECTIVES_REPLY, job_id, payload);
+}
+
+class Daemon
+{
+	utils::ThreadPool pool;
+	ExecutorCache executors;
+	InstanceCache<io::SingleSiteSimpleInstance, deterministic::SingleSiteSimpleModel> simple_instances;
+	InstanceCache<io::SingleSiteMultiSuiteInstance, deterministic::SingleSiteMultiSuiteModel> multi_suite_instances;
+	std::vector<std::shared_ptr<Connection>> connections;
+
+	static io::Config ReadSettings(io::PayloadReader &reader, const std::vector<std::string> &allowed)
+	{
+		io::Config config;
+		std::istringstream lines(reader.String());
+
+		config.Parse(lines, "settings");
+
+		for (const auto &key : config.Keys()) {
+			if (std::find(INSTANCE_SETTINGS.begin(), INSTANCE_SETTINGS.end(), key) == INSTANCE_SETTINGS.end() &&
+				std::find(allowed.begin(), allowed.end(), key) == allowed.end()) {
+				throw std::runtime_error("Unknown setting '" + key + "'.");
+			}
+		}
+
+		return config;
+	}
+
+	template<class Gene, class Schedule, class Instance, class Model>
+	void Run(Connection &connection, const io::Message &message, io::PayloadReader &reader, const io::Config &config, Warm<Instance, Model> &warm, const std::atomic<bool> &cancelled, Clock::time_point received)
+	{
+		connection.Send(io::INSTANCE_REPLY, message.job_id, InstancePayload(warm.instance));
+
+		if (message.type == io::EVALUATE_REQUEST) {
+			Evaluate<Gene, Schedule>(connection, message.job_id, config, reader, warm);
+		}
+		else if (warm.instance.input_data.objectives.size() == 1) {
+			Fit<algorithms::SingleObjectiveGA, types::SingleObjectiveChromosome<Gene>>(connection, message.job_id, config, warm, executors, cancelled, received);
+		}
+		else {
+			// Chromosomes with a fixed number of objectives for the common cases
+			switch (warm.instance.input_data.objectives.size()) {
+			case 2:
+				Fit<algorithms::NSGAII, types::FixedNSGAChromosome<Gene, 2>>(connection, message.job_id, config, warm, executors, cancelled, received);
+				break;
+			case 3:
+				Fit<algorithms::NSGAII, types::FixedNSGAChromosome<Gene, 3>>(connection, message.job_id, config, warm, executors, cancelled, received);
+				break;
+			case 4:
+				Fit<algorithms::NSGAII, types::FixedNSGAChromosome<Gene, 4>>(connection, message.job_id, config, warm, executors, cancelled, received);
+				break;
+			default:
+				Fit<algorithms::NSGAII, types::NSGAChromosome<Gene>>(connection, message.job_id, config, warm, executors, cancelled, received);
+			}
+		}
+	}
+
+	void RunJob(Connection &connection, const io::Message &message, const std::atomic<bool> &cancelled, Clock::time_point received)
+	{
+		try {
+			if (cancelled) {
+				throw std::runtime_error("Cancelled.");
+			}
+
+			io::PayloadReader reader(message.payload);
+			auto config = ReadSettings(reader, message.type == io::FIT_REQUEST ? FIT_SETTINGS : EVALUATE_SETTINGS);
+			std::string model = config.String("model", "");
+
+			if (model == "simple") {
+				auto warm = simple_instances.Get(InstanceKey(config), [&config]() {
+					auto constraints = config.Constraints("constraints");
+
+					return io::LoadSingleSiteSimple(
+						config.String("data_dir", "."),
+						config.String("start_date", ""),
+						config.Objectives("objectives"),
+						&constraints
+					);
+				});
+
+				Run<types::SingleSiteSimpleGene, types::SingleSiteSimpleSchedule>(connection, message, reader, config, *warm, cancelled, received);
+			}
+			else if (model == "multi_suite") {
+				auto warm = multi_suite_instances.Get(InstanceKey(config), [&config]() {
+					auto constraints = config.Constraints("constraints");
+
+					return io::LoadSingleSiteMultiSuite(
+						config.String("data_dir", "."),
+						config.String("start_date", ""),
+						config.Objectives("objectives"),
+						config.Int("num_usp_suites", 1),
+						config.Int("num_dsp_suites", 1),
+						&constraints
+					);
+				});
+
+				Run<types::SingleSiteMultiSuiteGene, types::SingleSiteMultiSuiteSchedule>(connection, message, reader, config, *warm, cancelled, received);
+			}
+			else {
+				throw std::runtime_error("'model' must be 'simple' or 'multi_suite', is '" + model + "'.");
+			}
+
+			if (cancelled) {
+				throw std::runtime_error("Cancelled.");
+			}
+
+			std::string payload;
+			io::WriteDouble(Seconds(received), payload);
+			connection.Send(io::DONE_REPLY, message.job_id, payload);
+		}
+		catch (const std::exception &e) {
+			std::string payload;
+			io::WriteString(e.what(), payload);
+			connection.Send(io::ERROR_REPLY, message.job_id, payload);
+		}
+
+		std::lock_guard<std::mutex> lock(connection.mutex);
+		connection.jobs.erase(message.job_id);
+	}
+
+	void Dispatch(const std::shared_ptr<Connection> &connection, io::Message &message)
+	{
+		if (message.type == io::CANCEL_REQUEST) {
+			std::lock_guard<std::mutex> lock(connection->mutex);
+			auto it = connection->jobs.find(message.job_id);
+
+			if (it != connection->jobs.end()) {
+				*it->second = true;
+			}
+
+			return;
+		}
+
+		if (message.type != io::FIT_REQUEST && message.type != io::EVALUATE_REQUEST) {
+			std::string payload;
+			io::WriteString("Unknown request type " + std::to_string(message.type) + ".", payload);
+			connection->Send(io::ERROR_REPLY, message.job_id, payload);
+			return;
+		}
+
+		auto cancelled = std::make_shared<std::atomic<bool>>(false);
+
+		{
+			std::lock_guard<std::mutex> lock(connection->mutex);
+
+			if (!connection->jobs.emplace(message.job_id, cancelled).second) {
+				cancelled = nullptr;
+			}
+		}
+
+		if (!cancelled) {
+			std::string payload;
+			io::WriteString("Job " + std::to_string(message.job_id) + " is already running.", payload);
+			connection->Send(io::ERROR_REPLY, message.job_id, payload);
+			return;
+		}
+
+		auto received = Clock::now();
+
+		pool.Submit([this, connection, message, cancelled, received]() {
+			RunJob(*connection, message, *cancelled, received);
+		});
+	}
+
+	// Returns false once the client has disconnected or sent a corrupted stream.
+	bool Read(const std::shared_ptr<Connection> &connection)
+	{
+		char buffer[65536];
+		io::Message message;
+
+		while (true) {
+			ssize_t size = read(connection->fd, buffer, sizeof(buffer));
+
+			if (size == 0) {
+				return false;
+			}
+
+			if (size < 0) {
+				if (errno == EINTR) continue;
+				return errno == EAGAIN || errno == EWOULDBLOCK;
+			}
+
+			connection->input.Append(buffer, size);
+
+			try {
+				while (connection->input.Next(message)) {
+					Dispatch(connection, message);
+				}
+			}
+			catch (const std::exception &e) {
+				fprintf(stderr, "Closing a connection: %s\n", e.what());
+				return false;
+			}
+		}
+	}
+
+	// Returns false if the client has disconnected or does not read its replies.
+	bool Flush(Connection &connection)
+	{
+		std::lock_guard<std::mutex> lock(connection.mutex);
+		size_t begin = 0;
+
+		if (connection.overflowed) {
+			fprintf(stderr, "Closing a connection: over %zu bytes of replies were not read\n", MAX_OUTPUT_SIZE);
+			return false;
+		}
+
+		while (begin < connection.output.size()) {
+			ssize_t size = write(connection.fd, connection.output.data() + begin, connection.output.size() - begin);
+
+			if (size < 0) {
+				if (errno == EINTR) continue;
+				if (errno != EAGAIN && errno != EWOULDBLOCK) return false;
+				break;
+			}
+
+			begin += size;
+		}
+
+		connection.output.erase(0, begin);
+
+		return true;
+	}
+
+	void Close(Connection &connection)
+	{
+		std::lock_guard<std::mutex> lock(connection.mutex);
+
+		for (auto &job : connection.jobs) {
+			*job.second = true;
+		}
+
+		connection.closed = true;
+		connection.output.clear();
+		close(connection.fd);
+		connection.fd = -1;
+	}
+
+public:
+	Daemon(int num_jobs, int max_instances) : pool(num_jobs), simple_instances(max_instances), multi_suite_instances(max_instances) {}
+
+	/*
+		Serves the clients until SIGINT or SIGTERM, then cancels the running jobs
+		and waits for them to finish. Throws std::runtime_error if the socket
+		cannot be created.
+	*/
+	void Serve(const std::string &path)
+	{
+		sockaddr_un address;
+		std::memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+
+		if (path.size() >= sizeof(address.sun_path)) {
+			throw std::runtime_error("Socket path '" + path + "' is too long.");
+		}
+
+		std::strcpy(address.sun_path, path.c_str());
+
+		RemoveSocket(path);
+		int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+
+		if (listener < 0 || bind(listener, (sockaddr*)&address, sizeof(address)) || listen(listener, 64)) {
+			throw std::runtime_error("Cannot listen on '" + path + "': " + std::strerror(errno));
+		}
+
+		SetNonBlocking(listener);
+		fprintf(stderr, "Listening on '%s' with %d job threads\n", path.c_str(), pool.NumThreads());
+
+		std::vector<pollfd> fds;
+		char buffer[256];
+
+		while (!stopping) {
+			fds.clear();
+			fds.push_back(pollfd{ wake_fds[0], POLLIN, 0 });
+			fds.push_back(pollfd{ listener, POLLIN, 0 });
+
+			for (auto &connection : connections) {
+				std::lock_guard<std::mutex> lock(connection->mutex);
+				fds.push_back(pollfd{ connection->fd, (short)(connection->output.empty() ? POLLIN : POLLIN | POLLOUT), 0 });
+			}
+
+			if (poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR) {
+				throw std::runtime_error(std::string("poll failed: ") + std::strerror(errno));
+			}
+
+			if (fds[0].revents & POLLIN) {
+				while (read(wake_fds[0], buffer, sizeof(buffer)) > 0);
+			}
+
+			// Connections accepted below are polled from the next iteration on
+			size_t num_polled = fds.size() - 2;
+
+			if (fds[1].revents & POLLIN) {
+				int fd;
+
+				while ((fd = accept(listener, NULL, NULL)) >= 0) {
+					SetNonBlocking(fd);
+					connections.push_back(std::make_shared<Connection>(fd));
+				}
+			}
+
+			for (size_t i = 0; i < connections.size(); ++i) {
+				auto &connection = connections[i];
+				short revents = i < num_polled ? fds[i + 2].revents : 0;
+				bool open = true;
+
+				if (revents & (POLLIN | POLLHUP | POLLERR)) {
+					open = Read(connection);
+				}
+
+				// Replies are written as soon as they are queued, not only on POLLOUT
+				if (open) {
+					open = Flush(*connection);
+				}
+
+				if (!open) {
+					Close(*connection);
+				}
+			}
+
+			connections.erase(
+				std::remove_if(connections.begin(), connections.end(), [](const std::shared_ptr<Connection> &connection) {
+					return connection->fd < 0;
+				}),
+				connections.end()
+			);
+		}
+
+		for (auto &connection : connections) {
+			Close(*connection);
+		}
+
+		connections.clear();
+		pool.Wait();
+
+		close(listener);
+		RemoveSocket(path);
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2 || std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help") {
+		printf("Usage: %s socket_path [num_jobs] [max_instances]\n", argv[0]);
+		return argc < 2;
+	}
+
+	try {
+		int num_jobs = argc > 2 ? std::atoi(argv[2]) : -1;
+		int max_instances = argc > 3 ? std::atoi(argv[3]) : 8;
+
+		if (pipe(wake_fds)) {
+			throw std::runtime_error(std::string("Cannot create a pipe: ") + std::strerror(errno));
+		}
+
+		SetNonBlocking(wake_fds[0]);
+		SetNonBlocking(wake_fds[1]);
+
+		std::signal(SIGPIPE, SIG_IGN);
+		std::signal(SIGINT, Stop);
+		std::signal(SIGTERM, Stop);
+
+		Daemon daemon(num_jobs, max_instances);
+		daemon.Serve(argv[1]);
+	}
+	catch (const std::exception &e) {
+		fprintf(stderr, "Error: %s\n", e.what());
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,109 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __DELTA_H__
+#define __DELTA_H__
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <utility>
+
+
+namespace types
+{
+	/*
+		Evaluation of a chromosome which its offspring inherit, see BaseGA::UseDelta.
+		Holds what the periods of every product added to the objectives and the
+		campaigns they came from. The periods of a product only depend on its own
+		batches, which only depend on the start and the size of its campaigns, so an
+		offspring with the same campaigns of a product as its parent adds the same
+		values in the same order instead of simulating the periods, which leaves the
+		objectives the same to the last bit, and shares that product with the parent.
+		'model' is the id of the model which took it, see NewModelId.
+	*/
+	struct ParentSnapshot
+	{
+		struct Campaign
+		{
+			int num_batches;
+			double first_harvest;
+
+			inline bool operator==(const Campaign &other) const
+			{
+				return num_batches == other.num_batches && first_harvest == other.first_harvest;
+			}
+		};
+
+		struct Product
+		{
+			std::vector<Campaign> campaigns;
+			std::vector<std::pair<int, double>> increments; // Objective and value
+
+			// Whether the campaigns of the product, numbered from 1, are these.
+			template<class Campaigns>
+			bool SameCampaigns(int product_num, const Campaigns &other) const
+			{
+				auto it = campaigns.cbegin();
+
+				for (const auto &cmpgn : other) {
+					if (cmpgn.product_num != product_num) {
+						continue;
+					}
+
+					if (it == campaigns.cend() || !(*it == Campaign{ cmpgn.num_batches, cmpgn.first_harvest })) {
+						return false;
+					}
+
+					++it;
+				}
+
+				return it == campaigns.cend();
+			}
+		};
+
+		unsigned long long model = 0;
+		std::vector<std::shared_ptr<const Product>> products;
+	};
+
+	// Evaluations with the snapshot of a parent, a product being all of its periods.
+	struct DeltaStats
+	{
+		long long num_evaluations = 0;
+		long long num_with_parent = 0; // Which had a snapshot of the same model
+		long long num_products = 0;
+		long long num_products_reused = 0;
+
+		DeltaStats& operator+=(const DeltaStats &other)
+		{
+			num_evaluations += other.num_evaluations;
+			num_with_parent += other.num_with_parent;
+			num_products += other.num_products;
+			num_products_reused += other.num_products_reused;
+
+			return *this;
+		}
+
+		// Fraction of the products whose periods were not simulated.
+		inline double ReusedFraction() const
+		{
+			return num_products ? (double)num_products_reused / num_products : 0.0;
+		}
+	};
+
+	/*
+		Id of a new model. Copies of a model keep its id, as they evaluate the same
+		input data.
+	*/
+	inline unsigned long long NewModelId()
+	{
+		static std::atomic<unsigned long long> next_id(1);
+		return next_id++;
+	}
+}
+
+#endif
@@ -0,0 +1,240 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __DOMINANCE_H__
+#define __DOMINANCE_H__
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define __DOMINANCE_SIMD__
+	#include <immintrin.h>
+#endif
+
+
+/*
+	Dominance of one solution against a block of others, as in NSGAII::CheckDominance:
+	the solution with the smaller constraints value dominates, unless the values are
+	equal within utils::Approx, and then the objectives, which are all minimised, decide.
+	The block is compared with AVX-512 or AVX2 if the CPU has them, which is checked
+	once at runtime, and with a scalar loop otherwise. All of them give the same masks.
+*/
+namespace algorithms
+{
+	static const int DOMINANCE_BLOCK = 8;
+
+	/*
+		Objectives and constraints of a population as a structure of arrays, i.e.
+		objective m of solution i is at objectives[m * stride + i]. The arrays are
+		padded, so a block can be read from any solution.
+	*/
+	struct DominancePoints
+	{
+		int num_objectives = 0;
+		int size = 0;
+		int stride = 0;
+		std::vector<double> objectives;
+		std::vector<double> constraints;
+
+		// Keeps the capacity of the previous populations.
+		template<class Population>
+		void Assign(const Population &R)
+		{
+			size = R.size();
+			num_objectives = size ? R[0].objectives.size() : 0;
+			stride = size + DOMINANCE_BLOCK;
+
+			objectives.assign(num_objectives * stride, 0.0);
+			constraints.assign(stride, 0.0);
+
+			for (int i = 0; i < size; ++i) {
+				constraints[i] = R[i].constraints;
+
+				for (int m = 0; m < num_objectives; ++m) {
+					objectives[m * stride + i] = R[i].objectives[m];
+				}
+			}
+		}
+	};
+
+	/*
+		Sets bit k of 'dominates' if solution p dominates solution begin + k and bit k
+		of 'dominated' if it is dominated by it, for the solutions of the block which
+		exist.
+	*/
+	typedef void (*CompareBlockFunction)(const DominancePoints &points, int p, int begin, uint32_t &dominates, uint32_t &dominated);
+
+	// Margin of utils::Approx with its default settings
+	static const double DOMINANCE_EPSILON = std::numeric_limits<float>::epsilon() * 100;
+
+	inline uint32_t BlockMask(const DominancePoints &points, int begin)
+	{
+		int count = points.size - begin;
+		return count >= DOMINANCE_BLOCK ? (1u << DOMINANCE_BLOCK) - 1 : (1u << count) - 1;
+	}
+
+	inline void CompareBlockScalar(const DominancePoints &points, int p, int begin, uint32_t &dominates, uint32_t &dominated)
+	{
+		dominates = dominated = 0;
+
+		double p_constraints = points.constraints[p];
+
+		for (int k = 0; k < DOMINANCE_BLOCK && begin + k < points.size; ++k) {
+			int q = begin + k;
+			double q_constraints = points.constraints[q], margin = DOMINANCE_EPSILON * std::fabs(q_constraints);
+
+			bool equal = p_constraints == q_constraints ||
+				(q_constraints + margin >= p_constraints && p_constraints + margin >= q_constraints);
+
+			if (!equal) {
+				(p_constraints < q_constraints ? dominates : dominated) |= 1u << k;
+				continue;
+			}
+
+			bool p_dominates = false, q_dominates = false;
+
+			for (int m = 0; m < points.num_objectives; ++m) {
+				const double *objective = &points.objectives[m * points.stride];
+				p_dominates |= objective[p] < objective[q];
+				q_dominates |= objective[p] > objective[q];
+			}
+
+			dominates |= (uint32_t)(p_dominates && !q_dominates) << k;
+			dominated |= (uint32_t)(q_dominates && !p_dominates) << k;
+		}
+	}
+
+#if defined(__DOMINANCE_SIMD__)
+	__attribute__((target("avx2")))
+	inline void CompareBlockAVX2(const DominancePoints &points, int p, int begin, uint32_t &dominates, uint32_t &dominated)
+	{
+		const __m256d sign = _mm256_set1_pd(-0.0), epsilon = _mm256_set1_pd(DOMINANCE_EPSILON);
+		const __m256d p_constraints = _mm256_set1_pd(points.constraints[p]);
+
+		dominates = dominated = 0;
+
+		for (int half = 0; half < DOMINANCE_BLOCK; half += 4) {
+			__m256d q_constraints = _mm256_loadu_pd(&points.constraints[begin + half]);
+			__m256d margin = _mm256_mul_pd(epsilon, _mm256_andnot_pd(sign, q_constraints));
+
+			__m256d equal = _mm256_or_pd(
+				_mm256_cmp_pd(p_constraints, q_constraints, _CMP_EQ_OQ),
+				_mm256_and_pd(
+					_mm256_cmp_pd(_mm256_add_pd(q_constraints, margin), p_constraints, _CMP_GE_OQ),
+					_mm256_cmp_pd(_mm256_add_pd(p_constraints, margin), q_constraints, _CMP_GE_OQ)
+				)
+			);
+			__m256d p_feasible = _mm256_cmp_pd(p_constraints, q_constraints, _CMP_LT_OQ);
+
+			__m256d p_better = _mm256_setzero_pd(), q_better = _mm256_setzero_pd();
+
+			for (int m = 0; m < points.num_objectives; ++m) {
+				const double *objective = &points.objectives[m * points.stride];
+				__m256d p_objective = _mm256_set1_pd(objective[p]);
+				__m256d q_objective = _mm256_loadu_pd(objective + begin + half);
+
+				p_better = _mm256_or_pd(p_better, _mm256_cmp_pd(p_objective, q_objective, _CMP_LT_OQ));
+				q_better = _mm256_or_pd(q_better, _mm256_cmp_pd(p_objective, q_objective, _CMP_GT_OQ));
+			}
+
+			// Constraints decide unless they are equal, then the objectives
+			uint32_t e = _mm256_movemask_pd(equal), f = _mm256_movemask_pd(p_feasible);
+			uint32_t pb = _mm256_movemask_pd(p_better), qb = _mm256_movemask_pd(q_better);
+			uint32_t p_mask = ((~e & f) | (e & pb & ~qb)) & 0xF;
+			uint32_t q_mask = ((~e & ~f) | (e & qb & ~pb)) & 0xF;
+
+			dominates |= p_mask << half;
+			dominated |= q_mask << half;
+		}
+
+		uint32_t exists = BlockMask(points, begin);
+		dominates &= exists;
+		dominated &= exists;
+	}
+
+	/*
+		The additions and multiplications use the explicitly rounded forms, so that they
+		are not fused into FMAs and the margins are the same as in the other kernels.
+		Their zero-masked forms with every lane set are used, as the unmasked ones pass
+		an undefined vector which GCC warns about with -Wall.
+	*/
+	__attribute__((target("avx512f")))
+	inline void CompareBlockAVX512(const DominancePoints &points, int p, int begin, uint32_t &dominates, uint32_t &dominated)
+	{
+		const __mmask8 all = 0xFF;
+		const __m512d epsilon = _mm512_set1_pd(DOMINANCE_EPSILON);
+		const __m512d p_constraints = _mm512_set1_pd(points.constraints[p]);
+
+		__m512d q_constraints = _mm512_loadu_pd(&points.constraints[begin]);
+		__m512d margin = _mm512_maskz_mul_round_pd(all, epsilon, _mm512_abs_pd(q_constraints), _MM_FROUND_CUR_DIRECTION);
+
+		__mmask8 equal = _mm512_cmp_pd_mask(p_constraints, q_constraints, _CMP_EQ_OQ) | (
+			_mm512_cmp_pd_mask(_mm512_maskz_add_round_pd(all, q_constraints, margin, _MM_FROUND_CUR_DIRECTION), p_constraints, _CMP_GE_OQ) &
+			_mm512_cmp_pd_mask(_mm512_maskz_add_round_pd(all, p_constraints, margin, _MM_FROUND_CUR_DIRECTION), q_constraints, _CMP_GE_OQ)
+		);
+		__mmask8 p_feasible = _mm512_cmp_pd_mask(p_constraints, q_constraints, _CMP_LT_OQ);
+		__mmask8 p_better = 0, q_better = 0;
+
+		for (int m = 0; m < points.num_objectives; ++m) {
+			const double *objective = &points.objectives[m * points.stride];
+			__m512d p_objective = _mm512_set1_pd(objective[p]);
+			__m512d q_objective = _mm512_loadu_pd(objective + begin);
+
+			p_better |= _mm512_cmp_pd_mask(p_objective, q_objective, _CMP_LT_OQ);
+			q_better |= _mm512_cmp_pd_mask(p_objective, q_objective, _CMP_GT_OQ);
+		}
+
+		uint32_t exists = BlockMask(points, begin);
+		dominates = ((~equal & p_feasible) | (equal & p_better & ~q_better)) & exists;
+		dominated = ((~equal & ~p_feasible) | (equal & q_better & ~p_better)) & exists;
+	}
+#endif
+
+	// Index of the lowest set bit of a non-zero mask.
+	inline int LowestBit(uint32_t mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return index;
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
+
+	inline CompareBlockFunction SelectCompareBlock()
+	{
+#if defined(__DOMINANCE_SIMD__)
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx512f")) {
+			return CompareBlockAVX512;
+		}
+
+		if (__builtin_cpu_supports("avx2")) {
+			return CompareBlockAVX2;
+		}
+#endif
+
+		return CompareBlockScalar;
+	}
+
+	inline void CompareBlock(const DominancePoints &points, int p, int begin, uint32_t &dominates, uint32_t &dominated)
+	{
+		static const CompareBlockFunction compare_block = SelectCompareBlock();
+		compare_block(points, p, begin, dominates, dominated);
+	}
+}
+
+#endif
@@ -0,0 +1,84 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __EVALUATION_H__
+#define __EVALUATION_H__
+
+#include <omp.h>
+#include <vector>
+
+#include "records.h"
+
+
+namespace deterministic
+{
+	/*
+		Batched evaluation of chromosomes which do not come from a GA, e.g. candidate
+		plans built by hand. The chromosomes are decoded in parallel with 'num_threads'
+		threads, or all the hardware threads if it is not positive, the same as the
+		offspring of a generation. The process-wide OpenMP settings are left alone.
+	*/
+
+	inline int NumThreads(int num_threads)
+	{
+		return num_threads > 0 ? num_threads : omp_get_num_procs();
+	}
+
+	// Objectives and constraints of the chromosomes, the same as assigned by a GA.
+	template<class Model, class Chromosome>
+	inline void EvaluateBatch(Model &model, std::vector<Chromosome> &chromosomes, int num_threads = -1)
+	{
+		#pragma omp parallel num_threads(NumThreads(num_threads))
+		{
+			// A contiguous range per thread, decoded in one workspace
+			typename Model::Workspace workspace;
+
+			int team_size = omp_get_num_threads(), thread = omp_get_thread_num();
+			int begin = chromosomes.size() * thread / team_size;
+			int end = chromosomes.size() * (thread + 1) / team_size;
+
+			model.EvaluateBatch(chromosomes.data() + begin, chromosomes.data() + end, workspace);
+		}
+	}
+
+	// All the objectives of every schedule indexed by OBJECTIVES, without keeping the schedules.
+	template<class Schedule, class Model, class Chromosome>
+	inline void EvaluateObjectives(Model &model, std::vector<Chromosome> &chromosomes, std::vector<std::vector<double>> &objectives, int num_threads = -1)
+	{
+		objectives.resize(chromosomes.size());
+
+		#pragma omp parallel num_threads(NumThreads(num_threads))
+		{
+			// Init of the deterministic schedules clears them, so a thread reuses one
+			Schedule schedule;
+
+			#pragma omp for
+			for (int i = 0; i < chromosomes.size(); ++i) {
+				model.CreateSchedule(chromosomes[i], schedule);
+				objectives[i] = schedule.objectives;
+			}
+		}
+	}
+
+	// Full schedules as records, 'records' has to hold a record per chromosome.
+	template<class Schedule, class Model, class Chromosome>
+	inline void CreateRecords(Model &model, std::vector<Chromosome> &chromosomes, std::vector<types::ScheduleRecords*> &records, int num_threads = -1)
+	{
+		#pragma omp parallel num_threads(NumThreads(num_threads))
+		{
+			Schedule schedule;
+
+			#pragma omp for
+			for (int i = 0; i < chromosomes.size(); ++i) {
+				model.CreateSchedule(chromosomes[i], schedule);
+				types::MakeRecords(schedule, *records[i]);
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,262 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __EXECUTOR_H__
+#define __EXECUTOR_H__
+
+#include <omp.h>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+
+#include "thread_pool.h"
+
+
+/*
+	Executors run the fitness evaluations of a generation, see BaseGA::SetExecutor.
+	Every task gets an estimate of its cost, e.g. the number of genes of the chromosome
+	it evaluates, which only has to be proportional to the actual run time. Both
+	executors record how busy their threads were, i.e. the time the threads spend
+	waiting for the slowest one. Run can be called from several threads at once, e.g.
+	by GAs sharing an executor, whose tasks then share its threads.
+*/
+namespace algorithms
+{
+	struct ExecutorStats
+	{
+		int num_threads = 0;
+		double seconds = 0.0;      // Wall time of the evaluations
+		double busy_seconds = 0.0; // Sum of the time the threads spent in the tasks
+
+		// Fraction of the thread time spent in the tasks.
+		inline double Utilization() const
+		{
+			return seconds > 0.0 && num_threads > 0 ? busy_seconds / (seconds * num_threads) : 1.0;
+		}
+	};
+
+	class Executor
+	{
+	protected:
+		typedef std::chrono::steady_clock Clock;
+
+		mutable std::mutex stats_mutex;
+		ExecutorStats last, total;
+
+		static inline double Seconds(Clock::time_point start, Clock::time_point end)
+		{
+			return std::chrono::duration<double>(end - start).count();
+		}
+
+	public:
+		virtual ~Executor() {}
+
+		virtual int NumThreads() const = 0;
+
+		// Threads which can be given long-running tasks, e.g. by BaseGA::Steady, if any.
+		virtual utils::ThreadPool* Pool()
+		{
+			return nullptr;
+		}
+
+		// Also called for the tasks which ran on the Pool outside Run.
+		void Record(int num_threads, double seconds, double busy_seconds)
+		{
+			std::lock_guard<std::mutex> lock(stats_mutex);
+
+			last.num_threads = total.num_threads = num_threads;
+			last.seconds = seconds;
+			last.busy_seconds = busy_seconds;
+			total.seconds += seconds;
+			total.busy_seconds += busy_seconds;
+		}
+
+		/*
+			Calls task(i) for every i in [0, num_tasks) and returns once all of them
+			have finished. 'costs' holds a cost per task or is empty if they are not
+			known.
+		*/
+		virtual void Run(int num_tasks, const std::vector<double> &costs, const std::function<void(int)> &task) = 0;
+
+		// Of the last call to Run.
+		inline ExecutorStats LastStats() const
+		{
+			std::lock_guard<std::mutex> lock(stats_mutex);
+			return last;
+		}
+
+		// Of all the calls to Run so far.
+		inline ExecutorStats TotalStats() const
+		{
+			std::lock_guard<std::mutex> lock(stats_mutex);
+			return total;
+		}
+	};
+
+	/*
+		OpenMP loop with the default schedule, i.e. the tasks are split into one
+		contiguous range per thread regardless of their costs.
+	*/
+	class OpenMPExecutor : public Executor
+	{
+	public:
+		int NumThreads() const override
+		{
+			return omp_get_max_threads();
+		}
+
+		void Run(int num_tasks, const std::vector<double> & /* costs */, const std::function<void(int)> &task) override
+		{
+			int num_threads = 1;
+			double busy_seconds = 0.0;
+			auto start = Clock::now();
+
+			#pragma omp parallel reduction(+:busy_seconds)
+			{
+				auto thread_start = Clock::now();
+
+				#pragma omp for nowait
+				for (int i = 0; i < num_tasks; ++i) {
+					task(i);
+				}
+
+				busy_seconds += Seconds(thread_start, Clock::now());
+
+				#pragma omp master
+				num_threads = omp_get_num_threads();
+			}
+
+			Record(num_threads, Seconds(start, Clock::now()), busy_seconds);
+		}
+	};
+
+	/*
+		Runs the tasks on a persistent utils::ThreadPool, so no threads are started
+		per generation. The tasks are sorted by decreasing cost and the workers take
+		them from that list as they become idle, i.e. the longest processing time
+		first rule, which leaves the cheap tasks to fill the gaps at the end. Cheap
+		tasks are taken in chunks of about 1 / (chunks_per_thread * num_threads) of
+		the total cost, so that a worker does not go back to the list per task.
+	*/
+	class PoolExecutor : public Executor
+	{
+		utils::ThreadPool pool;
+		int chunks_per_thread;
+		bool pinned = false;
+
+		// Ends of the chunks of 'order', each of about the same cost.
+		std::vector<int> Chunk(const std::vector<int> &order, const std::vector<double> &costs) const
+		{
+			double total_cost = 0.0;
+
+			for (int i : order) {
+				total_cost += costs.empty() ? 1.0 : costs[i];
+			}
+
+			double chunk_cost = total_cost / (chunks_per_thread * pool.NumThreads()), cost = 0.0;
+			std::vector<int> chunk_ends;
+
+			for (int k = 0; k < order.size(); ++k) {
+				cost += costs.empty() ? 1.0 : costs[order[k]];
+
+				if (cost >= chunk_cost || k + 1 == order.size()) {
+					chunk_ends.push_back(k + 1);
+					cost = 0.0;
+				}
+			}
+
+			return chunk_ends;
+		}
+
+	public:
+		/*
+			Uses all the hardware threads if 'num_threads' is not positive. The workers
+			are pinned to 'cpus' if it is not empty, e.g. to one NUMA node per fit with
+			utils::NumaNodeCpus, so that fits in the same process do not compete for
+			the same cores.
+		*/
+		explicit PoolExecutor(int num_threads = -1, int chunks_per_thread = 4, const std::vector<int> &cpus = {}) :
+			pool(num_threads),
+			chunks_per_thread(std::max(1, chunks_per_thread))
+		{
+			if (!cpus.empty()) {
+				pinned = pool.Pin(cpus);
+			}
+		}
+
+		int NumThreads() const override
+		{
+			return pool.NumThreads();
+		}
+
+		utils::ThreadPool* Pool() override
+		{
+			return &pool;
+		}
+
+		// True if the workers were pinned to the requested CPUs.
+		inline bool Pinned() const
+		{
+			return pinned;
+		}
+
+		/*
+			The tasks of a call are ordered and chunked in its own lists, and the call
+			waits for its own tasks only, so calls from several threads do not wait for
+			each other's work.
+		*/
+		void Run(int num_tasks, const std::vector<double> &costs, const std::function<void(int)> &task) override
+		{
+			auto start = Clock::now();
+
+			std::vector<int> order(num_tasks);
+			std::iota(order.begin(), order.end(), 0);
+
+			if (costs.size() == num_tasks) {
+				std::stable_sort(order.begin(), order.end(), [&costs](int i, int j) { return costs[i] > costs[j]; });
+			}
+
+			std::vector<int> chunk_ends = Chunk(order, costs);
+
+			std::atomic<int> next_chunk(0);
+			std::atomic<long long> busy_nanoseconds(0);
+			utils::Latch finished(pool.NumThreads());
+
+			for (int t = 0; t < pool.NumThreads(); ++t) {
+				pool.Submit([&]() {
+					auto thread_start = Clock::now();
+					int c;
+
+					try {
+						while ((c = next_chunk++) < chunk_ends.size()) {
+							for (int k = c ? chunk_ends[c - 1] : 0; k < chunk_ends[c]; ++k) {
+								task(order[k]);
+							}
+						}
+					}
+					catch (...) {
+						next_chunk = chunk_ends.size(); // The other workers stop after their chunk
+						finished.Fail(std::current_exception());
+					}
+
+					busy_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - thread_start).count();
+					finished.CountDown();
+				});
+			}
+
+			finished.Wait(); // Rethrows the exception of a failed task
+
+			Record(pool.NumThreads(), Seconds(start, Clock::now()), busy_nanoseconds * 1e-9);
+		}
+	};
+}
+
+#endif
@@ -8,16 +8,112 @@
 #ifndef  __GENE_H__
 #define __GENE_H__
 
+#include <mutex>
+#include <string>
+#include <cstdint>
 #include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
 
 #include "utils.h"
 
 
 namespace types
 {
+	/*
+		The mutation parameters are the same for every gene of a GA, so a gene
+		only holds its decision variables and a pointer to a shared config.
+		Configs are interned, i.e. genes constructed with equal parameters point
+		to the same config, which lives until the program exits.
+	*/
+	template<class Config>
+	const Config* InternConfig(const Config &config)
+	{
+		static std::mutex mutex;
+		static std::unordered_set<Config, typename Config::Hash> configs; // Does not move its elements
+		thread_local const Config *last = nullptr;
+
+		if (last && *last == config) {
+			return last;
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		last = &*configs.insert(config).first;
+
+		return last;
+	}
+
+	/*
+		Genes store their decision variables in 16 bits. Values which come from
+		outside the GA, e.g. a campaign table or a history file, are checked with
+		this instead of being truncated.
+	*/
+	inline int16_t GeneField(long long value)
+	{
+		if (value < INT16_MIN || value > INT16_MAX) {
+			throw std::out_of_range("Gene value " + std::to_string(value) + " does not fit in 16 bits.");
+		}
+
+		return (int16_t)value;
+	}
+
+	// Combines the hashes of the fields of a config, as boost::hash_combine does.
+	template<class T>
+	inline void HashCombine(size_t &seed, const T &value)
+	{
+		seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	}
+
+	struct SingleSiteMultiSuiteGeneConfig
+	{
+		int num_products;
+		int num_usp_suites;
+		double p_product_mut;
+		double p_usp_suite_mut;
+		double p_plus_batch_mut;
+		double p_minus_batch_mut;
+
+		inline bool operator==(const SingleSiteMultiSuiteGeneConfig &other) const
+		{
+			return num_products == other.num_products &&
+				num_usp_suites == other.num_usp_suites &&
+				p_product_mut == other.p_product_mut &&
+				p_usp_suite_mut == other.p_usp_suite_mut &&
+				p_plus_batch_mut == other.p_plus_batch_mut &&
+				p_minus_batch_mut == other.p_minus_batch_mut;
+		}
+
+		struct Hash
+		{
+			size_t operator()(const SingleSiteMultiSuiteGeneConfig &config) const
+			{
+				size_t seed = 0;
+				HashCombine(seed, config.num_products);
+				HashCombine(seed, config.num_usp_suites);
+				HashCombine(seed, config.p_product_mut);
+				HashCombine(seed, config.p_usp_suite_mut);
+				HashCombine(seed, config.p_plus_batch_mut);
+				HashCombine(seed, config.p_minus_batch_mut);
+
+				return seed;
+			}
+		};
+	};
+
 	struct SingleSiteMultiSuiteGene
 	{
-		SingleSiteMultiSuiteGene() {}
+		typedef SingleSiteMultiSuiteGeneConfig Config;
+
+		SingleSiteMultiSuiteGene() : config(nullptr) {}
+
+		explicit SingleSiteMultiSuiteGene(const Config *config) : config(config)
+		{
+			this->num_batches = 1;
+			this->product_num = utils::random_int(1, config->num_products);
+			this->usp_suite_num = utils::random_int(1, config->num_usp_suites);
+		}
 
 		SingleSiteMultiSuiteGene(
 			int num_products,
@@ -26,31 +122,56 @@ namespace types
 			double p_usp_suite_mut,
 			double p_plus_batch_mut,
 			double p_minus_batch_mut
-		) 
-		{
-			this->num_products = num_products,
-			this->num_usp_suites = num_usp_suites,
-			this->p_product_mut = p_product_mut,
-			this->p_usp_suite_mut = p_usp_suite_mut,
-			this->p_plus_batch_mut = p_plus_batch_mut,
-			this->p_minus_batch_mut = p_minus_batch_mut,
-			this->num_batches = 1;
-			this->product_num = utils::random_int(1, num_products);
-			this->usp_suite_num = utils::random_int(1, num_usp_suites);
-		}
-
-		SingleSiteMultiSuiteGene make_new()
-		{
-			return std::move(
-				SingleSiteMultiSuiteGene(
+		) :
+			SingleSiteMultiSuiteGene(
+				InternConfig(Config{ 
 					num_products, 
 					num_usp_suites, 
 					p_product_mut, 
 					p_usp_suite_mut, 
 					p_plus_batch_mut, 
-					p_minus_batch_mut
-				)
-			);
+					p_minus_batch_mut 
+				})
+			)
+		{}
+
+		/*
+			Copies the decision variables of the seed gene, e.g. a campaign
+			taken from a previous schedule, using the current mutation parameters.
+		*/
+		SingleSiteMultiSuiteGene(
+			const SingleSiteMultiSuiteGene &seed,
+			int num_products,
+			int num_usp_suites,
+			double p_product_mut,
+			double p_usp_suite_mut,
+			double p_plus_batch_mut,
+			double p_minus_batch_mut
+		)
+		{
+			this->config = InternConfig(Config{ 
+				num_products, 
+				num_usp_suites, 
+				p_product_mut, 
+				p_usp_suite_mut, 
+				p_plus_batch_mut, 
+				p_minus_batch_mut 
+			});
+			this->num_batches = (seed.num_batches > 0) ? seed.num_batches : 0;
+			this->product_num = seed.product_num;
+			this->usp_suite_num = seed.usp_suite_num;
+		}
+
+		// False if the gene refers to a product or a suite that does not exist.
+		inline bool IsValid() const
+		{
+			return product_num >= 1 && product_num <= config->num_products &&
+				usp_suite_num >= 1 && usp_suite_num <= config->num_usp_suites;
+		}
+
+		SingleSiteMultiSuiteGene make_new()
+		{
+			return SingleSiteMultiSuiteGene(config);
 		}
 
 		inline void Mutate()
@@ -60,90 +181,146 @@ namespace types
 			mutate_num_batches();
 		}
 
-		int product_num;
-		int usp_suite_num;
-		int num_batches;
+		inline const Config& GetConfig() const
+		{
+			return *config;
+		}
+
+	private:
+		const Config *config;
+
+	public:
+		int16_t product_num;
+		int16_t usp_suite_num;
+		int16_t num_batches;
 
 	private:
 		inline void mutate_product_num()
 		{
-			if (utils::random() >= p_product_mut) {
+			if (utils::random() >= config->p_product_mut) {
 				return;
 			}
 
 			int random_product_num = 0;
-			do { random_product_num = utils::random_int(1, num_products); }
+			do { random_product_num = utils::random_int(1, config->num_products); }
 			while (product_num == random_product_num);
 			product_num = random_product_num;
 		}
 
 		inline void mutate_usp_suite_num()
 		{
-			if (utils::random() >= p_usp_suite_mut) {
+			if (utils::random() >= config->p_usp_suite_mut) {
 				return;
 			}
 
 			int random_usp_suite_num = 0;
-			do { random_usp_suite_num = utils::random_int(1, num_usp_suites); } 
+			do { random_usp_suite_num = utils::random_int(1, config->num_usp_suites); } 
 			while (usp_suite_num == random_usp_suite_num);
 			usp_suite_num = random_usp_suite_num;
 		}
 
 		inline void mutate_num_batches()
 		{
-			if (utils::random() < p_plus_batch_mut) {
+			if (utils::random() < config->p_plus_batch_mut && num_batches < INT16_MAX) {
 				num_batches += 1;
 			}
 
-			if (num_batches > 0 && utils::random() < p_minus_batch_mut) {
+			if (num_batches > 0 && utils::random() < config->p_minus_batch_mut) {
 				num_batches -= 1;
 			}
 		}
+	};
+	
 
+	struct SingleSiteSimpleGeneConfig
+	{
 		int num_products;
-		int num_usp_suites;
 		double p_product_mut;
-		double p_usp_suite_mut;
 		double p_plus_batch_mut;
 		double p_minus_batch_mut;
+
+		inline bool operator==(const SingleSiteSimpleGeneConfig &other) const
+		{
+			return num_products == other.num_products &&
+				p_product_mut == other.p_product_mut &&
+				p_plus_batch_mut == other.p_plus_batch_mut &&
+				p_minus_batch_mut == other.p_minus_batch_mut;
+		}
+
+		struct Hash
+		{
+			size_t operator()(const SingleSiteSimpleGeneConfig &config) const
+			{
+				size_t seed = 0;
+				HashCombine(seed, config.num_products);
+				HashCombine(seed, config.p_product_mut);
+				HashCombine(seed, config.p_plus_batch_mut);
+				HashCombine(seed, config.p_minus_batch_mut);
+
+				return seed;
+			}
+		};
 	};
-	
 
 	struct SingleSiteSimpleGene
 	{
-		SingleSiteSimpleGene() {}
+		typedef SingleSiteSimpleGeneConfig Config;
+
+		SingleSiteSimpleGene() : config(nullptr) {}
+
+		explicit SingleSiteSimpleGene(const Config *config) : config(config)
+		{
+			this->num_batches = 1;
+			this->product_num = utils::random_int(1, config->num_products);
+		}
 
 		SingleSiteSimpleGene(
 			int num_products,
 			double p_product_mut,
 			double p_plus_batch_mut,
 			double p_minus_batch_mut
-		) 
-		// :
-		// 	num_products(num_products),
-		// 	num_batches(1),
-		// 	p_product_mut(p_product_mut),
-		// 	p_plus_batch_mut(p_plus_batch_mut),
-		// 	p_minus_batch_mut(p_minus_batch_mut)
-		{
-			this->num_products = num_products;
-			this->num_batches = 1;
-			this->p_product_mut = p_product_mut;
-			this->p_plus_batch_mut = p_plus_batch_mut;
-			this->p_minus_batch_mut = p_minus_batch_mut;
-			this->product_num = utils::random_int(1, num_products);
+		) :
+			SingleSiteSimpleGene(
+				InternConfig(Config{ 
+					num_products, 
+					p_product_mut, 
+					p_plus_batch_mut, 
+					p_minus_batch_mut 
+				})
+			)
+		{}
+
+		/*
+			Copies the decision variables of the seed gene, e.g. a campaign
+			taken from a previous schedule, using the current mutation parameters.
+		*/
+		SingleSiteSimpleGene(
+			const SingleSiteSimpleGene &seed,
+			int num_products,
+			double p_product_mut,
+			double p_plus_batch_mut,
+			double p_minus_batch_mut
+		)
+		{
+			this->config = InternConfig(Config{ 
+				num_products, 
+				p_product_mut, 
+				p_plus_batch_mut, 
+				p_minus_batch_mut 
+			});
+			this->num_batches = (seed.num_batches > 1) ? seed.num_batches : 1;
+			this->product_num = seed.product_num;
+		}
+
+		// False if the gene refers to a product that does not exist.
+		inline bool IsValid() const
+		{
+			return product_num >= 1 && product_num <= config->num_products;
 		}
 
 		SingleSiteSimpleGene make_new()
 		{
-			return std::move(
-				SingleSiteSimpleGene(
-					num_products,
-					p_product_mut, 
-					p_plus_batch_mut, 
-					p_minus_batch_mut
-				)
-			);
+			return SingleSiteSimpleGene(config);
 		}
 
 		inline void Mutate()
@@ -152,40 +329,42 @@ namespace types
 			mutate_num_batches();
 		}
 
-		int product_num;
-		int num_batches;
+		inline const Config& GetConfig() const
+		{
+			return *config;
+		}
+
+	private:
+		const Config *config;
+
+	public:
+		int16_t product_num;
+		int16_t num_batches;
 
 	private:
 		inline void mutate_product_num()
 		{
-			if (utils::random() >= p_product_mut) {
+			if (utils::random() >= config->p_product_mut) {
 				return;
 			}
 
 			int random_product_num = 0;
-			do { random_product_num = utils::random_int(1, num_products); }
+			do { random_product_num = utils::random_int(1, config->num_products); }
 			while (product_num == random_product_num);
 			product_num = random_product_num;
 		}
 
 		inline void mutate_num_batches()
 		{
-			if (utils::random() < p_plus_batch_mut) {
+			if (utils::random() < config->p_plus_batch_mut && num_batches < INT16_MAX) {
 				num_batches += 1;
 			}
 
-			if (num_batches > 1 && utils::random() < p_minus_batch_mut) {
+			if (num_batches > 1 && utils::random() < config->p_minus_batch_mut) {
 				num_batches -= 1;
 			}
 		}
-
-		int num_products;
-		double p_product_mut;
-		double p_plus_batch_mut;
-		double p_minus_batch_mut;
 	};
 }
 
 #endif 
-
-
@@ -1,9 +1,14 @@
+from libc.stdint cimport int16_t
+
+
 cdef extern from "gene.h" namespace "types":
     cdef struct SingleSiteMultiSuiteGene:
-        int product_num
-        int suite_num
-        int num_batches
+        int16_t product_num
+        int16_t usp_suite_num
+        int16_t num_batches
 
     cdef struct SingleSiteSimpleGene:
-        int product_num
-        int num_batches
\ No newline at end of file
+        int16_t product_num
+        int16_t num_batches
+
+    int16_t GeneField(long long value) except +
@@ -0,0 +1,383 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __HEURISTICS_H__
+#define __HEURISTICS_H__
+
+#include <cmath>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include "gene.h"
+#include "input_data.h"
+
+
+namespace heuristics
+{
+	/*
+		Campaign of a product due by the end of a period.
+	*/
+	struct Lot
+	{
+		int product_num;
+		int usp_suite_num;
+		int due_period;
+		int num_batches;
+	};
+
+	/*
+		Rounds up the number of batches to satisfy the campaign size limits.
+	*/
+	inline int RoundBatches(int num_batches, int min_batches, int max_batches, int batches_multiples_of)
+	{
+		if (num_batches < min_batches) {
+			num_batches = min_batches;
+		}
+
+		if (batches_multiples_of > 1 && num_batches % batches_multiples_of) {
+			num_batches += batches_multiples_of - num_batches % batches_multiples_of;
+		}
+
+		if (max_batches > 0 && num_batches > max_batches) {
+			num_batches = max_batches;
+		}
+
+		return num_batches;
+	}
+
+	/*
+		Splits the net demand of each product, i.e. demand not covered by the opening
+		stock, into lots over windows of 'window' periods. Number of batches in a lot
+		is proportional to the demand it covers, but no more than the storage holds.
+		Empty opening stock or storage limits mean none and no limit.
+	*/
+	template<class Demand, class Storage>
+	std::vector<Lot> DemandLots(
+		const std::vector<std::vector<Demand>> &demand,
+		const std::vector<double> &batch_size,
+		const std::vector<double> &opening_stock,
+		const std::vector<Storage> &storage_limits,
+		const std::vector<int> &min_batches,
+		const std::vector<int> &max_batches,
+		const std::vector<int> &batches_multiples_of,
+		int window
+	)
+	{
+		std::vector<Lot> lots;
+
+		for (int p = 0; p < demand.size(); ++p) {
+			double stock = opening_stock.empty() ? 0.0 : opening_stock[p];
+			double lot_demand = 0.0;
+			int due_period = -1;
+			int storage_batches = storage_limits.empty() || storage_limits[p] <= 0 ?
+				0 : std::max(1, (int)std::floor(storage_limits[p] / batch_size[p] + 1e-9));
+
+			for (int t = 0; t < demand[p].size(); ++t) {
+				double net_demand = demand[p][t];
+
+				if (stock > 0.0) {
+					double used = std::min(stock, net_demand);
+					stock -= used;
+					net_demand -= used;
+				}
+
+				if (net_demand > 0.0) {
+					if (due_period == -1) {
+						due_period = t;
+					}
+					lot_demand += net_demand;
+				}
+
+				if (due_period != -1 && ((t + 1) % window == 0 || t + 1 == demand[p].size())) {
+					int num_batches = RoundBatches(
+						(int)std::ceil(lot_demand / batch_size[p] - 1e-9),
+						min_batches[p],
+						max_batches[p],
+						batches_multiples_of[p]
+					);
+
+					// The batches over the storage limit would be wasted
+					if (storage_batches && num_batches > storage_batches) {
+						num_batches = storage_batches;
+					}
+
+					lots.push_back(Lot{ p + 1, 0, due_period, num_batches });
+
+					lot_demand = 0.0;
+					due_period = -1;
+				}
+			}
+		}
+
+		return lots;
+	}
+
+	/*
+		Sequences the lots in the order of their due dates. Consecutive lots of the
+		same product are merged into a single campaign.
+	*/
+	inline std::vector<Lot> EarliestDueDate(std::vector<Lot> lots)
+	{
+		std::stable_sort(
+			lots.begin(),
+			lots.end(),
+			[](const Lot &l1, const Lot &l2) { return l1.due_period < l2.due_period; }
+		);
+
+		std::vector<Lot> sequence;
+
+		for (const auto &lot : lots) {
+			if (!sequence.empty() && sequence.back().product_num == lot.product_num) {
+				sequence.back().num_batches += lot.num_batches;
+			}
+			else {
+				sequence.push_back(lot);
+			}
+		}
+
+		return sequence;
+	}
+
+	/*
+		Sequences the lots window by window. Within a window, the next product is
+		always the one with the shortest changeover from the previous one.
+	*/
+	template<class Changeovers>
+	std::vector<Lot> MinChangeover(std::vector<Lot> lots, const Changeovers &changeovers, int window)
+	{
+		std::stable_sort(
+			lots.begin(),
+			lots.end(),
+			[window](const Lot &l1, const Lot &l2) { return l1.due_period / window < l2.due_period / window; }
+		);
+
+		std::vector<Lot> sequence;
+		auto begin = lots.begin();
+
+		while (begin != lots.end()) {
+			auto end = std::find_if(
+				begin,
+				lots.end(),
+				[&](const Lot &lot) { return lot.due_period / window != begin->due_period / window; }
+			);
+
+			std::vector<Lot> block(begin, end);
+
+			while (!block.empty()) {
+				auto next = block.begin();
+
+				if (!sequence.empty()) {
+					int prev = sequence.back().product_num - 1;
+					next = std::min_element(
+						block.begin(),
+						block.end(),
+						[&](const Lot &l1, const Lot &l2) {
+							return changeovers[prev][l1.product_num - 1] < changeovers[prev][l2.product_num - 1];
+						}
+					);
+				}
+
+				if (!sequence.empty() && sequence.back().product_num == next->product_num) {
+					sequence.back().num_batches += next->num_batches;
+				}
+				else {
+					sequence.push_back(*next);
+				}
+
+				block.erase(next);
+			}
+
+			begin = end;
+		}
+
+		return sequence;
+	}
+
+	/*
+		Assigns each campaign to the USP suite that becomes free first.
+	*/
+	inline void AssignSuites(std::vector<Lot> &sequence, const deterministic::SingleSiteMultiSuiteInputData &input_data)
+	{
+		std::vector<double> suite_time(input_data.num_usp_suites, 0.0);
+		std::vector<int> suite_product(input_data.num_usp_suites, 0);
+
+		for (auto &lot : sequence) {
+			int s = std::min_element(suite_time.begin(), suite_time.end()) - suite_time.begin();
+
+			if (suite_product[s]) {
+				suite_time[s] += input_data.usp_changeovers[suite_product[s] - 1][lot.product_num - 1];
+			}
+
+			suite_time[s] += input_data.usp_days[lot.product_num - 1] * lot.num_batches;
+			suite_product[s] = lot.product_num;
+			lot.usp_suite_num = s + 1;
+		}
+	}
+
+	inline void SetGene(types::SingleSiteSimpleGene &gene, const Lot &lot)
+	{
+		gene.product_num = lot.product_num;
+		gene.num_batches = lot.num_batches;
+	}
+
+	inline void SetGene(types::SingleSiteMultiSuiteGene &gene, const Lot &lot)
+	{
+		gene.product_num = lot.product_num;
+		gene.usp_suite_num = lot.usp_suite_num;
+		gene.num_batches = lot.num_batches;
+	}
+
+	inline bool SameGene(const types::SingleSiteSimpleGene &g1, const types::SingleSiteSimpleGene &g2)
+	{
+		return g1.product_num == g2.product_num && g1.num_batches == g2.num_batches;
+	}
+
+	inline bool SameGene(const types::SingleSiteMultiSuiteGene &g1, const types::SingleSiteMultiSuiteGene &g2)
+	{
+		return g1.product_num == g2.product_num && g1.usp_suite_num == g2.usp_suite_num && g1.num_batches == g2.num_batches;
+	}
+
+	/*
+		Windows (in periods) used for building the seeds. Short windows follow
+		the demand closely, long windows produce fewer and larger campaigns.
+	*/
+	static const std::vector<int> WINDOWS = { 1, 2, 3, 4, 6, 12 };
+
+	template<class Chromosome, class Changeovers>
+	std::vector<Chromosome> MakeSeeds(
+		const std::vector<std::vector<Lot>> &lots_per_window,
+		const Changeovers &changeovers,
+		const deterministic::SingleSiteMultiSuiteInputData *multi_suite_input_data = NULL
+	)
+	{
+		std::vector<Chromosome> seeds;
+		std::vector<std::vector<Lot>> sequences;
+
+		for (int w = 0; w < lots_per_window.size(); ++w) {
+			if (lots_per_window[w].empty()) {
+				continue;
+			}
+
+			sequences.push_back(EarliestDueDate(lots_per_window[w]));
+			sequences.push_back(MinChangeover(lots_per_window[w], changeovers, WINDOWS[w]));
+		}
+
+		for (auto &sequence : sequences) {
+			if (multi_suite_input_data) {
+				AssignSuites(sequence, *multi_suite_input_data);
+			}
+
+			Chromosome seed;
+			seed.genes.resize(sequence.size());
+
+			for (int i = 0; i < sequence.size(); ++i) {
+				SetGene(seed.genes[i], sequence[i]);
+			}
+
+			bool duplicate = std::any_of(
+				seeds.begin(),
+				seeds.end(),
+				[&seed](const Chromosome &other) {
+					return std::equal(
+						seed.genes.begin(),
+						seed.genes.end(),
+						other.genes.begin(),
+						other.genes.end(),
+						[](const auto &g1, const auto &g2) { return SameGene(g1, g2); }
+					);
+				}
+			);
+
+			if (!duplicate) {
+				seeds.push_back(std::move(seed));
+			}
+		}
+
+		return seeds;
+	}
+
+	/*
+		Heuristic seed individuals, i.e. earliest due date and changeover minimising
+		campaign sequences with demand proportional batch counts, to be passed to
+		the Init(popsize, seeds, ...) overloads of the GAs.
+	*/
+	template<class Chromosome>
+	std::vector<Chromosome> Seeds(const deterministic::SingleSiteSimpleInputData &input_data)
+	{
+		std::vector<std::vector<Lot>> lots_per_window;
+
+		for (int window : WINDOWS) {
+			lots_per_window.push_back(
+				DemandLots(
+					input_data.kg_demand,
+					input_data.kg_yield_per_batch,
+					input_data.kg_opening_stock,
+					input_data.kg_storage_limits,
+					input_data.min_batches_per_campaign,
+					input_data.max_batches_per_campaign,
+					input_data.batches_multiples_of_per_campaign,
+					window
+				)
+			);
+		}
+
+		return MakeSeeds<Chromosome>(lots_per_window, input_data.changeover_days);
+	}
+
+	template<class Chromosome>
+	std::vector<Chromosome> Seeds(const stochastic::SingleSiteSimpleInputData &input_data)
+	{
+		std::vector<std::vector<Lot>> lots_per_window;
+
+		for (int window : WINDOWS) {
+			lots_per_window.push_back(
+				DemandLots(
+					input_data.kg_demand_mode,
+					input_data.kg_yield_per_batch_mode,
+					input_data.kg_opening_stock,
+					input_data.kg_storage_limits,
+					input_data.min_batches_per_campaign,
+					input_data.max_batches_per_campaign,
+					input_data.batches_multiples_of_per_campaign,
+					window
+				)
+			);
+		}
+
+		return MakeSeeds<Chromosome>(lots_per_window, input_data.changeover_days);
+	}
+
+	template<class Chromosome>
+	std::vector<Chromosome> Seeds(const deterministic::SingleSiteMultiSuiteInputData &input_data)
+	{
+		// Demand and storage are in batches. The model has no opening stock and no
+		// campaign size limits.
+		std::vector<std::vector<Lot>> lots_per_window;
+		std::vector<double> batch_size(input_data.num_products, 1.0);
+		std::vector<int> no_limit(input_data.num_products, 0);
+
+		for (int window : WINDOWS) {
+			lots_per_window.push_back(
+				DemandLots(
+					input_data.demand,
+					batch_size,
+					std::vector<double>(),
+					input_data.storage_cap,
+					no_limit,
+					no_limit,
+					no_limit,
+					window
+				)
+			);
+		}
+
+		return MakeSeeds<Chromosome>(lots_per_window, input_data.usp_changeovers, &input_data);
+	}
+}
+
+#endif
@@ -0,0 +1,611 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __HISTORY_H__
+#define __HISTORY_H__
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+#include <condition_variable>
+
+#include "gene.h"
+#include "mapped_file.h"
+#include "nsga_chromosome.h"
+#include "single_objective_chromosome.h"
+
+
+/*
+	Binary history of the fronts of every generation of every run.
+
+	The file starts with the 8 byte HISTORY_MAGIC and the names of the objectives
+	(varint count, then varint length and the characters of each name), followed
+	by the frames, each of them holding one front:
+
+		varint frame size (without this varint)
+		varint run, gen, num solutions, num objectives, num fields per gene
+		for each solution:
+			double constraints
+			double objectives[num objectives]
+			varint num genes
+			zigzag varint fields[num genes * num fields per gene]
+
+	Doubles are written in the byte order of the machine. When the writer is
+	closed, the index of the frames is appended:
+
+		varint num frames
+		for each frame: varint run, gen, offset of the frame
+		uint64 offset of the index
+		8 byte INDEX_MAGIC
+
+	If the index is missing, e.g. the process was killed, the reader recovers it
+	by skipping through the frames, ignoring a truncated last frame.
+*/
+namespace io
+{
+	static const char HISTORY_MAGIC[8] = { 'B', 'S', 'H', 'I', 'S', 'T', '0', '1' };
+	static const char INDEX_MAGIC[8] = { 'B', 'S', 'H', 'I', 'N', 'D', 'E', 'X' };
+
+	inline void WriteVarint(uint64_t value, std::string &buffer)
+	{
+		while (value >= 0x80) {
+			buffer.push_back((char)(value | 0x80));
+			value >>= 7;
+		}
+
+		buffer.push_back((char)value);
+	}
+
+	// Returns false if the varint does not end before 'end'.
+	inline bool ReadVarint(const char *&p, const char *end, uint64_t &value)
+	{
+		value = 0;
+
+		for (int shift = 0; p < end && shift < 64; shift += 7) {
+			uint8_t byte = *p++;
+			value |= (uint64_t)(byte & 0x7F) << shift;
+
+			if (!(byte & 0x80)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	inline void WriteZigZag(int64_t value, std::string &buffer)
+	{
+		WriteVarint(((uint64_t)value << 1) ^ (uint64_t)(value >> 63), buffer);
+	}
+
+	inline int64_t DecodeZigZag(uint64_t value)
+	{
+		return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+	}
+
+	inline void WriteDouble(double value, std::string &buffer)
+	{
+		buffer.append((const char*)&value, sizeof(double));
+	}
+
+	/*
+		Decision variables of the genes, i.e. the fields stored in the history.
+	*/
+	inline void GetFields(const types::SingleSiteSimpleGene &gene, std::vector<int> &fields)
+	{
+		fields.push_back(gene.product_num);
+		fields.push_back(gene.num_batches);
+	}
+
+	inline void GetFields(const types::SingleSiteMultiSuiteGene &gene, std::vector<int> &fields)
+	{
+		fields.push_back(gene.product_num);
+		fields.push_back(gene.usp_suite_num);
+		fields.push_back(gene.num_batches);
+	}
+
+	inline void SetFields(types::SingleSiteSimpleGene &gene, const int *fields)
+	{
+		gene.product_num = types::GeneField(fields[0]);
+		gene.num_batches = types::GeneField(fields[1]);
+	}
+
+	inline void SetFields(types::SingleSiteMultiSuiteGene &gene, const int *fields)
+	{
+		gene.product_num = types::GeneField(fields[0]);
+		gene.usp_suite_num = types::GeneField(fields[1]);
+		gene.num_batches = types::GeneField(fields[2]);
+	}
+
+	template<class Gene, class GeneContainer, class Objectives>
+	inline void GetObjectives(const types::NSGAChromosome<Gene, GeneContainer, Objectives> &chromosome, std::vector<double> &objectives)
+	{
+		objectives.assign(chromosome.objectives.begin(), chromosome.objectives.end());
+	}
+
+	template<class Gene, class GeneContainer>
+	inline void GetObjectives(const types::SingleObjectiveChromosome<Gene, GeneContainer> &chromosome, std::vector<double> &objectives)
+	{
+		objectives.assign(1, chromosome.objective);
+	}
+
+	template<class Gene, class GeneContainer, class Objectives>
+	inline void SetObjectives(types::NSGAChromosome<Gene, GeneContainer, Objectives> &chromosome, const std::vector<double> &objectives)
+	{
+		types::ResizeObjectives(chromosome.objectives, objectives.size());
+		std::copy(objectives.begin(), objectives.end(), chromosome.objectives.begin());
+	}
+
+	template<class Gene, class GeneContainer>
+	inline void SetObjectives(types::SingleObjectiveChromosome<Gene, GeneContainer> &chromosome, const std::vector<double> &objectives)
+	{
+		chromosome.objective = objectives.empty() ? 0.0 : objectives[0];
+	}
+
+	/*
+		Front of a single generation as stored in the history. 'fields' holds
+		num_fields values per gene of each solution.
+	*/
+	struct HistoryFrame
+	{
+		int run;
+		int gen;
+		int num_fields;
+		std::vector<double> constraints;
+		std::vector<std::vector<double>> objectives;
+		std::vector<std::vector<int>> fields;
+	};
+
+	/*
+		Encodes the front as a frame of the history, i.e. with its size first.
+		'body' is a scratch buffer which is reused between the calls.
+	*/
+	template<class Chromosome>
+	void EncodeFrame(int run, int gen, const std::vector<Chromosome> &front, std::string &frame, std::string &body)
+	{
+		std::vector<double> objectives;
+		std::vector<int> fields;
+		int num_objectives = 0, num_fields = 0;
+
+		if (!front.empty()) {
+			GetObjectives(front[0], objectives);
+			num_objectives = objectives.size();
+
+			for (const auto &i : front) {
+				if (!i.genes.empty()) {
+					GetFields(i.genes[0], fields);
+					num_fields = fields.size();
+					break;
+				}
+			}
+		}
+
+		body.resize(0);
+		WriteVarint(run, body);
+		WriteVarint(gen, body);
+		WriteVarint(front.size(), body);
+		WriteVarint(num_objectives, body);
+		WriteVarint(num_fields, body);
+
+		for (const auto &i : front) {
+			GetObjectives(i, objectives);
+			objectives.resize(num_objectives, 0.0);
+
+			WriteDouble(i.constraints, body);
+
+			for (double objective : objectives) {
+				WriteDouble(objective, body);
+			}
+
+			fields.resize(0);
+
+			for (const auto &gene : i.genes) {
+				GetFields(gene, fields);
+			}
+
+			WriteVarint(i.genes.size(), body);
+
+			for (int field : fields) {
+				WriteZigZag(field, body);
+			}
+		}
+
+		frame.resize(0);
+		WriteVarint(body.size(), frame);
+		frame += body;
+	}
+
+	/*
+		Decodes the frame at 'p', which is left at the end of the frame. Throws
+		std::runtime_error if the frame does not end before 'end'.
+	*/
+	inline HistoryFrame DecodeFrame(const char *&p, const char *end)
+	{
+		uint64_t frame_size, value, num_solutions, num_objectives, num_fields, num_genes;
+		HistoryFrame frame;
+
+		auto read = [&p, &end](uint64_t &value) {
+			if (!ReadVarint(p, end, value)) {
+				throw std::runtime_error("Corrupted history frame");
+			}
+		};
+
+		auto read_double = [&p, &end]() {
+			double value;
+
+			if (end - p < sizeof(double)) {
+				throw std::runtime_error("Corrupted history frame");
+			}
+
+			std::memcpy(&value, p, sizeof(double));
+			p += sizeof(double);
+			return value;
+		};
+
+		read(frame_size);
+
+		if (frame_size > end - p) {
+			throw std::runtime_error("Corrupted history frame");
+		}
+
+		end = p + frame_size;
+
+		read(value); frame.run = value;
+		read(value); frame.gen = value;
+		read(num_solutions);
+		read(num_objectives);
+		read(num_fields);
+		frame.num_fields = num_fields;
+
+		frame.constraints.resize(num_solutions);
+		frame.objectives.resize(num_solutions, std::vector<double>(num_objectives));
+		frame.fields.resize(num_solutions);
+
+		for (uint64_t i = 0; i < num_solutions; ++i) {
+			frame.constraints[i] = read_double();
+
+			for (uint64_t m = 0; m < num_objectives; ++m) {
+				frame.objectives[i][m] = read_double();
+			}
+
+			read(num_genes);
+			frame.fields[i].resize(num_genes * num_fields);
+
+			for (auto &field : frame.fields[i]) {
+				read(value);
+				field = DecodeZigZag(value);
+			}
+		}
+
+		p = end;
+
+		return frame;
+	}
+
+	/*
+		Streams the fronts to an append-only file. The fronts are encoded and written
+		by a background thread, so Write only copies the front into the queue.
+	*/
+	template<class Chromosome>
+	class HistoryWriter
+	{
+		typedef std::vector<Chromosome> Population;
+
+		struct Entry
+		{
+			int run, gen;
+			Population front;
+		};
+
+		FILE *file;
+		uint64_t offset;
+		std::vector<std::pair<std::pair<int, int>, uint64_t>> index;
+
+		std::deque<Entry> queue;
+		std::mutex mutex;
+		std::condition_variable cv;
+		std::thread thread;
+		bool closing;
+
+		void Run()
+		{
+			std::string frame, body;
+
+			while (true) {
+				Entry entry;
+
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					cv.wait(lock, [this] { return closing || !queue.empty(); });
+
+					if (queue.empty()) {
+						return;
+					}
+
+					entry = std::move(queue.front());
+					queue.pop_front();
+				}
+
+				EncodeFrame(entry.run, entry.gen, entry.front, frame, body);
+				std::fwrite(frame.data(), 1, frame.size(), file);
+
+				index.push_back(std::make_pair(std::make_pair(entry.run, entry.gen), offset));
+				offset += frame.size();
+			}
+		}
+
+	public:
+		// Throws std::runtime_error if the file cannot be created.
+		explicit HistoryWriter(const std::string &path, const std::vector<std::string> &objective_names = {})
+			:
+			closing(false)
+		{
+			file = std::fopen(path.c_str(), "wb");
+
+			if (!file) {
+				throw std::runtime_error("Cannot create the history file '" + path + "'");
+			}
+
+			std::string header(HISTORY_MAGIC, sizeof(HISTORY_MAGIC));
+			WriteVarint(objective_names.size(), header);
+
+			for (const auto &name : objective_names) {
+				WriteVarint(name.size(), header);
+				header += name;
+			}
+
+			std::fwrite(header.data(), 1, header.size(), file);
+			offset = header.size();
+			thread = std::thread(&HistoryWriter::Run, this);
+		}
+
+		HistoryWriter(const HistoryWriter&) = delete;
+		HistoryWriter& operator=(const HistoryWriter&) = delete;
+
+		~HistoryWriter()
+		{
+			Close();
+		}
+
+		void Write(int run, int gen, const Population &front)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				queue.push_back(Entry{ run, gen, front });
+			}
+
+			cv.notify_one();
+		}
+
+		/*
+			Waits until all the queued fronts are written and appends the index.
+		*/
+		void Close()
+		{
+			if (!file) {
+				return;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				closing = true;
+			}
+
+			cv.notify_one();
+			thread.join();
+
+			std::string buffer;
+			WriteVarint(index.size(), buffer);
+
+			for (const auto &it : index) {
+				WriteVarint(it.first.first, buffer);
+				WriteVarint(it.first.second, buffer);
+				WriteVarint(it.second, buffer);
+			}
+
+			buffer.append((const char*)&offset, sizeof(offset));
+			buffer.append(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+
+			std::fwrite(buffer.data(), 1, buffer.size(), file);
+			std::fclose(file);
+			file = nullptr;
+		}
+	};
+
+	/*
+		Random access to the fronts of a history file through a read-only memory
+		mapping, i.e. only the pages of the frames which are read are loaded.
+	*/
+	class HistoryReader
+	{
+		MappedFile file;
+		const char *data;
+		size_t size, header_size;
+		std::map<std::pair<int, int>, uint64_t> index;
+		std::vector<std::string> objective_names;
+
+		bool ReadHeader()
+		{
+			const char *p = data + sizeof(HISTORY_MAGIC), *end = data + size;
+			uint64_t num_names, length;
+
+			if (!ReadVarint(p, end, num_names)) {
+				return false;
+			}
+
+			for (uint64_t i = 0; i < num_names; ++i) {
+				if (!ReadVarint(p, end, length) || length > end - p) {
+					return false;
+				}
+
+				objective_names.push_back(std::string(p, length));
+				p += length;
+			}
+
+			header_size = p - data;
+
+			return true;
+		}
+
+		bool ReadIndex()
+		{
+			uint64_t index_offset;
+
+			if (size < header_size + sizeof(INDEX_MAGIC) + sizeof(index_offset) ||
+				std::memcmp(data + size - sizeof(INDEX_MAGIC), INDEX_MAGIC, sizeof(INDEX_MAGIC))) {
+				return false;
+			}
+
+			const char *end = data + size - sizeof(INDEX_MAGIC) - sizeof(index_offset);
+			std::memcpy(&index_offset, end, sizeof(index_offset));
+
+			if (index_offset < header_size || index_offset > end - data) {
+				return false;
+			}
+
+			const char *p = data + index_offset;
+			uint64_t num_frames, run, gen, offset;
+
+			if (!ReadVarint(p, end, num_frames)) {
+				return false;
+			}
+
+			for (uint64_t i = 0; i < num_frames; ++i) {
+				if (!ReadVarint(p, end, run) || !ReadVarint(p, end, gen) || !ReadVarint(p, end, offset)) {
+					index.clear();
+					return false;
+				}
+
+				index[std::make_pair((int)run, (int)gen)] = offset;
+			}
+
+			return true;
+		}
+
+		void ScanFrames()
+		{
+			const char *p = data + header_size, *end = data + size;
+			uint64_t frame_size, run, gen;
+
+			while (p < end) {
+				const char *frame = p;
+
+				if (!ReadVarint(p, end, frame_size) || frame_size > end - p) {
+					break;
+				}
+
+				const char *body = p;
+				p += frame_size;
+
+				if (!ReadVarint(body, p, run) || !ReadVarint(body, p, gen)) {
+					break;
+				}
+
+				index[std::make_pair((int)run, (int)gen)] = frame - data;
+			}
+		}
+
+	public:
+		// Throws std::runtime_error if the file cannot be read or is not a history file.
+		explicit HistoryReader(const std::string &path) : file(path), data(file.Data()), size(file.Size())
+		{
+			if (size < sizeof(HISTORY_MAGIC) || std::memcmp(data, HISTORY_MAGIC, sizeof(HISTORY_MAGIC)) || !ReadHeader()) {
+				throw std::runtime_error("'" + path + "' is not a history file");
+			}
+
+			if (!ReadIndex()) {
+				ScanFrames();
+			}
+		}
+
+		HistoryReader(const HistoryReader&) = delete;
+		HistoryReader& operator=(const HistoryReader&) = delete;
+
+		inline const std::vector<std::string>& ObjectiveNames() const
+		{
+			return objective_names;
+		}
+
+		inline int NumFrames() const
+		{
+			return index.size();
+		}
+
+		int NumRuns() const
+		{
+			return index.empty() ? 0 : index.rbegin()->first.first + 1;
+		}
+
+		// Number of generations of the run, i.e. the last generation + 1.
+		int NumGens(int run) const
+		{
+			auto it = index.lower_bound(std::make_pair(run + 1, 0));
+
+			if (it == index.begin() || (--it)->first.first != run) {
+				return 0;
+			}
+
+			return it->first.second + 1;
+		}
+
+		inline bool Contains(int run, int gen) const
+		{
+			return index.count(std::make_pair(run, gen)) != 0;
+		}
+
+		// Throws std::out_of_range if the front is not in the history.
+		HistoryFrame Frame(int run, int gen) const
+		{
+			auto it = index.find(std::make_pair(run, gen));
+
+			if (it == index.end()) {
+				throw std::out_of_range(
+					"Generation " + std::to_string(gen) + " of run " + std::to_string(run) + " is not in the history"
+				);
+			}
+
+			const char *p = data + it->second;
+
+			return DecodeFrame(p, data + size);
+		}
+
+		/*
+			Front of the generation as chromosomes. Only the genes' decision variables,
+			objectives and constraints are restored.
+		*/
+		template<class Chromosome>
+		std::vector<Chromosome> Front(int run, int gen) const
+		{
+			HistoryFrame frame = Frame(run, gen);
+			std::vector<Chromosome> front(frame.constraints.size());
+
+			for (int i = 0; i < front.size(); ++i) {
+				front[i].constraints = frame.constraints[i];
+				SetObjectives(front[i], frame.objectives[i]);
+
+				int num_genes = frame.num_fields ? frame.fields[i].size() / frame.num_fields : 0;
+				front[i].genes.resize(num_genes);
+
+				for (int g = 0; g < num_genes; ++g) {
+					SetFields(front[i].genes[g], &frame.fields[i][g * frame.num_fields]);
+				}
+			}
+
+			return front;
+		}
+	};
+}
+
+#endif
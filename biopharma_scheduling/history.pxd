@@ -0,0 +1,27 @@
+from libcpp cimport bool
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+
+cdef extern from "history.h" namespace "io" nogil:
+    cdef struct HistoryFrame:
+        int run
+        int gen
+        int num_fields
+        vector[double] constraints
+        vector[vector[double]] objectives
+        vector[vector[int]] fields
+
+    cdef cppclass HistoryWriter[Chromosome]:
+        HistoryWriter(string path, vector[string] objective_names) except +
+        void Write(int run, int gen, vector[Chromosome] &front)
+        void Close()
+
+    cdef cppclass HistoryReader:
+        HistoryReader(string path) except +
+        vector[string] ObjectiveNames()
+        int NumFrames()
+        int NumRuns()
+        int NumGens(int run)
+        bool Contains(int run, int gen)
+        HistoryFrame Frame(int run, int gen) except +
@@ -0,0 +1,69 @@
+'''
+    Reader of the binary history files written by 'history.h', e.g. with the
+    'history_file' parameter of the models.
+
+    Objective values are minimised, i.e. multiplied by their coefficient and -1,
+    the same as in 'biopharma_scheduling.metrics'.
+'''
+import numpy as np
+
+
+cdef class HistoryFile:
+    '''
+        Random access to the fronts of every generation of every run in a history 
+        file. The file is memory-mapped, so only the fronts which are read are loaded.
+
+        Example:
+
+            history = HistoryFile('history.bin')
+            front = history.front(run=0, gen=history.num_gens(0) - 1)
+            front['objectives'] # num solutions x num objectives array
+    '''
+    cdef HistoryReader *reader
+
+    def __cinit__(self, path: str):
+        self.reader = new HistoryReader(path.encode())
+
+    def __dealloc__(self):
+        del self.reader
+
+    @property
+    def objective_names(self):
+        return [name.decode() for name in self.reader.ObjectiveNames()]
+
+    @property
+    def num_runs(self):
+        return self.reader.NumRuns()
+
+    def num_gens(self, run: int):
+        return self.reader.NumGens(run)
+
+    def __len__(self):
+        return self.reader.NumFrames()
+
+    def __contains__(self, key):
+        run, gen = key
+        return self.reader.Contains(run, gen)
+
+    def front(self, run: int, gen: int):
+        '''
+            Returns a dictionary with the front of generation 'gen' of run 'run':
+
+                'constraints': num solutions array, 
+                'objectives': num solutions x num objectives array,
+                'genes': list of num genes x num fields arrays, i.e. (product number, batches) 
+                    for DetSingleSiteSimple and (product number, USP suite number, batches) 
+                    for DetSingleSiteMultiSuite
+        '''
+        cdef HistoryFrame frame = self.reader.Frame(run, gen)
+
+        num_solutions = frame.constraints.size()
+        num_fields = max(frame.num_fields, 1)
+        objectives = frame.objectives
+        fields = frame.fields
+
+        return {
+            'constraints': np.array(frame.constraints, dtype=np.float64),
+            'objectives': np.array(objectives, dtype=np.float64).reshape(num_solutions, -1) if num_solutions else np.empty((0, 0)),
+            'genes': [np.array(genes, dtype=np.intc).reshape(-1, num_fields) for genes in fields]
+        }
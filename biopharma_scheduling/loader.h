@@ -0,0 +1,618 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __LOADER_H__
+#define __LOADER_H__
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <utility>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "input_data.h"
+#include "mapped_file.h"
+
+
+namespace io
+{
+	/*
+		Comma separated table parsed in a single pass over a memory mapped file.
+		The first line holds the column names. Cells are kept as offsets into
+		the mapping and only converted when accessed. Blank lines are skipped,
+		cells are trimmed and may be double quoted.
+	*/
+	class CSVTable
+	{
+		std::string path;
+		MappedFile file;
+
+		std::vector<std::string> columns;
+		std::vector<std::pair<size_t, size_t>> cells; // (offset, length) in the row-major order
+		std::vector<size_t> line_nums; // Line number of every row in the file for the error messages
+
+		static inline bool IsSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r';
+		}
+
+		std::string Unquote(size_t offset, size_t length) const
+		{
+			const char *cell = file.Data() + offset;
+
+			if (length < 2 || cell[0] != '"' || cell[length - 1] != '"') {
+				return std::string(cell, length);
+			}
+
+			std::string value;
+			value.reserve(length - 2);
+
+			for (size_t i = 1; i < length - 1; ++i) {
+				value.push_back(cell[i]);
+				if (cell[i] == '"' && cell[i + 1] == '"') ++i;
+			}
+
+			return value;
+		}
+
+		void Parse()
+		{
+			const char *data = file.Data();
+			size_t size = file.Size(), pos = 0, line_num = 0;
+			std::vector<std::pair<size_t, size_t>> row;
+
+			while (pos < size) {
+				++line_num;
+				row.resize(0);
+
+				// Single line, with the newlines inside of quotes belonging to the cell
+				while (true) {
+					size_t begin = pos;
+					bool quoted = false;
+
+					while (pos < size && (quoted || (data[pos] != ',' && data[pos] != '\n'))) {
+						if (data[pos] == '"') quoted = !quoted;
+						if (data[pos] == '\n') ++line_num;
+						++pos;
+					}
+
+					if (quoted) {
+						throw std::runtime_error(path + ":" + std::to_string(line_num) + ": unterminated quote.");
+					}
+
+					size_t end = pos;
+
+					while (begin < end && IsSpace(data[begin])) ++begin;
+					while (end > begin && IsSpace(data[end - 1])) --end;
+
+					row.push_back(std::make_pair(begin, end - begin));
+
+					if (pos >= size || data[pos++] == '\n') {
+						break;
+					}
+				}
+
+				if (row.size() == 1 && row[0].second == 0) {
+					continue;
+				}
+
+				if (columns.empty()) {
+					for (const auto &cell : row) {
+						columns.push_back(Unquote(cell.first, cell.second));
+					}
+					continue;
+				}
+
+				if (row.size() != columns.size()) {
+					throw std::runtime_error(
+						path + ":" + std::to_string(line_num) + ": expected " + std::to_string(columns.size()) +
+						" cells, found " + std::to_string(row.size()) + "."
+					);
+				}
+
+				cells.insert(cells.end(), row.begin(), row.end());
+				line_nums.push_back(line_num);
+			}
+
+			if (columns.empty()) {
+				throw std::runtime_error(path + ": missing the header.");
+			}
+		}
+
+	public:
+		// Throws std::runtime_error if the file cannot be read or has a malformed row.
+		explicit CSVTable(const std::string &path) : path(path), file(path)
+		{
+			Parse();
+		}
+
+		inline const std::string& Path() const
+		{
+			return path;
+		}
+
+		inline const std::vector<std::string>& Columns() const
+		{
+			return columns;
+		}
+
+		inline size_t NumRows() const
+		{
+			return line_nums.size();
+		}
+
+		inline bool HasColumn(const std::string &name) const
+		{
+			for (const auto &column : columns) {
+				if (column == name) return true;
+			}
+			return false;
+		}
+
+		size_t Column(const std::string &name) const
+		{
+			for (size_t col = 0; col != columns.size(); ++col) {
+				if (columns[col] == name) return col;
+			}
+
+			throw std::runtime_error(path + ": missing '" + name + "' column.");
+		}
+
+		inline std::string String(size_t row, size_t col) const
+		{
+			const auto &cell = cells[row * columns.size() + col];
+			return Unquote(cell.first, cell.second);
+		}
+
+		/*
+			Empty and NaN cells are read as 0, the same as DataFrame.fillna(0).
+			Throws std::runtime_error if the cell is not a number.
+		*/
+		double Number(size_t row, size_t col) const
+		{
+			std::string cell = String(row, col);
+
+			if (cell.empty()) {
+				return 0.0;
+			}
+
+			char *end = nullptr;
+			double value = std::strtod(cell.c_str(), &end);
+
+			if (end != cell.c_str() + cell.size()) {
+				throw std::runtime_error(
+					path + ":" + std::to_string(line_nums[row]) + ": '" + cell +
+					"' in '" + columns[col] + "' column is not a number."
+				);
+			}
+
+			return std::isnan(value) ? 0.0 : value;
+		}
+
+		template<class T>
+		std::vector<T> Numbers(size_t col) const
+		{
+			std::vector<T> values(NumRows());
+
+			for (size_t row = 0; row != NumRows(); ++row) {
+				values[row] = (T)Number(row, col);
+			}
+
+			return values;
+		}
+
+		template<class T>
+		inline std::vector<T> Numbers(const std::string &name) const
+		{
+			return Numbers<T>(Column(name));
+		}
+	};
+
+	// Days since 1970-01-01 of a 'YYYY-MM-DD' date, optionally followed by a time which is ignored.
+	inline int ParseDate(const std::string &date)
+	{
+		int y, m, d;
+		char sep1, sep2;
+
+		if (std::sscanf(date.c_str(), "%d%c%d%c%d", &y, &sep1, &m, &sep2, &d) != 5 ||
+			sep1 != sep2 || (sep1 != '-' && sep1 != '/') || m < 1 || m > 12 || d < 1 || d > 31) {
+			throw std::runtime_error("'" + date + "' is not a 'YYYY-MM-DD' date.");
+		}
+
+		// Days from the civil date, see http://howardhinnant.github.io/date_algorithms.html
+		y -= m <= 2;
+		int era = (y >= 0 ? y : y - 399) / 400;
+		int yoe = y - era * 400;
+		int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+		int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+		return era * 146097 + doe - 719468;
+	}
+
+	/*
+		Labels of the columns after the first one, i.e. the products of a
+		demand table or of a changeover matrix.
+	*/
+	inline std::vector<std::string> ProductColumns(const CSVTable &table)
+	{
+		return std::vector<std::string>(table.Columns().begin() + 1, table.Columns().end());
+	}
+
+	inline std::vector<std::string> ProductRows(const CSVTable &table)
+	{
+		size_t col = table.Column("product");
+		std::vector<std::string> labels;
+
+		for (size_t row = 0; row != table.NumRows(); ++row) {
+			labels.push_back(table.String(row, col));
+		}
+
+		return labels;
+	}
+
+	/*
+		Position of every product label in 'other'. Throws std::runtime_error
+		unless 'other' holds the same labels, each exactly once.
+	*/
+	inline std::vector<size_t> Align(
+		const std::vector<std::string> &labels,
+		const std::vector<std::string> &other,
+		const std::string &error
+	)
+	{
+		std::unordered_map<std::string, size_t> positions;
+
+		for (size_t i = 0; i != other.size(); ++i) {
+			if (!positions.insert(std::make_pair(other[i], i)).second) {
+				throw std::runtime_error(error);
+			}
+		}
+
+		std::vector<size_t> order;
+
+		for (const auto &label : labels) {
+			auto it = positions.find(label);
+
+			if (it == positions.end()) {
+				throw std::runtime_error(error);
+			}
+
+			order.push_back(it->second);
+		}
+
+		if (order.size() != other.size()) {
+			throw std::runtime_error(error);
+		}
+
+		return order;
+	}
+
+	template<class T>
+	inline std::vector<T> Reorder(const std::vector<T> &values, const std::vector<size_t> &order)
+	{
+		std::vector<T> reordered;
+
+		for (auto i : order) {
+			reordered.push_back(values[i]);
+		}
+
+		return reordered;
+	}
+
+	/*
+		Products x periods matrix of a table with a 'date' column followed by
+		one column per product, with the product columns taken in 'order'.
+	*/
+	template<class T>
+	inline std::vector<std::vector<T>> ReadPeriods(const CSVTable &table, const std::vector<size_t> &order)
+	{
+		std::vector<std::vector<T>> matrix;
+
+		for (auto col : order) {
+			matrix.push_back(table.Numbers<T>(col + 1));
+		}
+
+		return matrix;
+	}
+
+	template<class T>
+	inline std::vector<std::vector<T>> ReadChangeovers(
+		const CSVTable &table,
+		const std::vector<std::string> &labels,
+		const std::string &name
+	)
+	{
+		auto rows = Align(labels, ProductRows(table), "Product labels from the demand and '" + name + "' do not match.");
+
+		std::vector<std::string> columns;
+		std::vector<size_t> column_nums;
+
+		for (size_t col = 0; col != table.Columns().size(); ++col) {
+			if (table.Columns()[col] != "product") {
+				columns.push_back(table.Columns()[col]);
+				column_nums.push_back(col);
+			}
+		}
+
+		auto cols = Align(
+			labels,
+			columns,
+			"Product labels in 'product' column do not match with the actual product columns in '" + name + "'."
+		);
+
+		std::vector<std::vector<T>> matrix(labels.size(), std::vector<T>(labels.size()));
+
+		for (size_t i = 0; i != labels.size(); ++i) {
+			for (size_t j = 0; j != labels.size(); ++j) {
+				matrix[i][j] = (T)table.Number(rows[i], column_nums[cols[j]]);
+			}
+		}
+
+		return matrix;
+	}
+
+	inline void CheckColumns(const CSVTable &table, const std::vector<std::string> &columns)
+	{
+		for (const auto &column : columns) {
+			table.Column(column);
+		}
+	}
+
+	inline std::vector<int> DaysPerPeriod(
+		const std::string &start_date,
+		const CSVTable &demand,
+		std::vector<std::string> &due_dates
+	)
+	{
+		if (demand.Columns()[0] != "date") {
+			throw std::runtime_error(demand.Path() + ": must have a 'date' index.");
+		}
+
+		if (!demand.NumRows()) {
+			throw std::runtime_error(demand.Path() + ": has no due dates.");
+		}
+
+		std::vector<int> days_per_period;
+		int prev = ParseDate(start_date);
+
+		for (size_t row = 0; row != demand.NumRows(); ++row) {
+			due_dates.push_back(demand.String(row, 0));
+
+			int date = ParseDate(due_dates.back());
+			days_per_period.push_back(date - prev);
+			prev = date;
+		}
+
+		return days_per_period;
+	}
+
+	/*
+		Input data of a problem instance together with the labels needed to
+		make a schedule readable.
+	*/
+	struct SingleSiteSimpleInstance
+	{
+		std::vector<std::string> product_labels;
+		std::vector<std::string> due_dates;
+
+		deterministic::SingleSiteSimpleInputData input_data;
+	};
+
+	struct SingleSiteMultiSuiteInstance
+	{
+		std::vector<std::string> product_labels;
+		std::vector<std::string> due_dates;
+
+		deterministic::SingleSiteMultiSuiteInputData input_data;
+	};
+
+	/*
+		Loads 'kg_demand.csv', 'product_data.csv', 'changeover_days.csv' and, if
+		present, 'kg_inventory_target.csv' from 'data_dir', validates them the same
+		way as DetSingleSiteSimple.fit and builds the input data directly. Product
+		data and changeovers are reordered to the product columns of the demand.
+		Throws std::runtime_error with the file and line of the first problem.
+	*/
+	inline SingleSiteSimpleInstance LoadSingleSiteSimple(
+		const std::string &data_dir,
+		const std::string &start_date,
+		std::unordered_map<deterministic::OBJECTIVES, int> objectives,
+		std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> *constraints = NULL
+	)
+	{
+		CSVTable kg_demand(data_dir + "/kg_demand.csv");
+		CSVTable product_data(data_dir + "/product_data.csv");
+		CSVTable changeover_days(data_dir + "/changeover_days.csv");
+
+		SingleSiteSimpleInstance instance;
+		auto days_per_period = DaysPerPeriod(start_date, kg_demand, instance.due_dates);
+
+		CheckColumns(product_data, {
+			"product",
+			"inventory_penalty_per_kg",
+			"backlog_penalty_per_kg",
+			"production_cost_per_kg",
+			"storage_cost_per_kg",
+			"waste_cost_per_kg",
+			"sell_price_per_kg",
+			"inoculation_days",
+			"seed_days",
+			"production_days",
+			"usp_days",
+			"dsp_days",
+			"approval_days",
+			"shelf_life_days",
+			"kg_yield_per_batch",
+			"kg_storage_limits",
+			"kg_opening_stock",
+			"min_batches_per_campaign",
+			"max_batches_per_campaign",
+			"batches_multiples_of_per_campaign"
+		});
+
+		instance.product_labels = ProductColumns(kg_demand);
+
+		std::vector<size_t> columns(instance.product_labels.size());
+		for (size_t i = 0; i != columns.size(); ++i) columns[i] = i;
+
+		auto rows = Align(
+			instance.product_labels,
+			ProductRows(product_data),
+			"Product labels from 'kg_demand' and 'product_data' do not match."
+		);
+
+		std::vector<std::vector<double>> kg_inventory_target;
+		bool has_target = std::ifstream(data_dir + "/kg_inventory_target.csv").good();
+
+		if (has_target) {
+			CSVTable target(data_dir + "/kg_inventory_target.csv");
+
+			if (target.Columns()[0] != "date") {
+				throw std::runtime_error(target.Path() + ": must have a 'date' index.");
+			}
+
+			if (target.NumRows() != kg_demand.NumRows()) {
+				throw std::runtime_error("'date' indices from 'kg_demand' and 'kg_inventory_target' do not match.");
+			}
+
+			for (size_t row = 0; row != target.NumRows(); ++row) {
+				if (ParseDate(target.String(row, 0)) != ParseDate(instance.due_dates[row])) {
+					throw std::runtime_error("'date' indices from 'kg_demand' and 'kg_inventory_target' do not match.");
+				}
+			}
+
+			auto order = Align(
+				instance.product_labels,
+				ProductColumns(target),
+				"Product labels from 'kg_demand' and 'kg_inventory_target' do not match."
+			);
+
+			kg_inventory_target = ReadPeriods<double>(target, order);
+		}
+
+		instance.input_data = deterministic::SingleSiteSimpleInputData(
+			objectives,
+			ReadPeriods<double>(kg_demand, columns),
+			days_per_period,
+
+			Reorder(product_data.Numbers<double>("kg_opening_stock"), rows),
+			Reorder(product_data.Numbers<double>("kg_yield_per_batch"), rows),
+			Reorder(product_data.Numbers<double>("kg_storage_limits"), rows),
+
+			Reorder(product_data.Numbers<double>("inventory_penalty_per_kg"), rows),
+			Reorder(product_data.Numbers<double>("backlog_penalty_per_kg"), rows),
+			Reorder(product_data.Numbers<double>("production_cost_per_kg"), rows),
+			Reorder(product_data.Numbers<double>("storage_cost_per_kg"), rows),
+			Reorder(product_data.Numbers<double>("waste_cost_per_kg"), rows),
+			Reorder(product_data.Numbers<double>("sell_price_per_kg"), rows),
+
+			Reorder(product_data.Numbers<int>("inoculation_days"), rows),
+			Reorder(product_data.Numbers<int>("seed_days"), rows),
+			Reorder(product_data.Numbers<int>("production_days"), rows),
+			Reorder(product_data.Numbers<int>("usp_days"), rows),
+			Reorder(product_data.Numbers<int>("dsp_days"), rows),
+			Reorder(product_data.Numbers<int>("approval_days"), rows),
+			Reorder(product_data.Numbers<int>("shelf_life_days"), rows),
+			Reorder(product_data.Numbers<int>("min_batches_per_campaign"), rows),
+			Reorder(product_data.Numbers<int>("max_batches_per_campaign"), rows),
+			Reorder(product_data.Numbers<int>("batches_multiples_of_per_campaign"), rows),
+			ReadChangeovers<int>(changeover_days, instance.product_labels, "changeover_days"),
+
+			has_target ? &kg_inventory_target : NULL,
+			constraints
+		);
+
+		return instance;
+	}
+
+	/*
+		Loads 'batch_demand.csv', 'product_data.csv', 'usp_changeover_days.csv'
+		and 'dsp_changeover_days.csv' from 'data_dir', see LoadSingleSiteSimple.
+	*/
+	inline SingleSiteMultiSuiteInstance LoadSingleSiteMultiSuite(
+		const std::string &data_dir,
+		const std::string &start_date,
+		std::unordered_map<deterministic::OBJECTIVES, int> objectives,
+		int num_usp_suites,
+		int num_dsp_suites,
+		std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> *constraints = NULL
+	)
+	{
+		CSVTable batch_demand(data_dir + "/batch_demand.csv");
+		CSVTable product_data(data_dir + "/product_data.csv");
+		CSVTable usp_changeover_days(data_dir + "/usp_changeover_days.csv");
+		CSVTable dsp_changeover_days(data_dir + "/dsp_changeover_days.csv");
+
+		SingleSiteMultiSuiteInstance instance;
+		auto days_per_period = DaysPerPeriod(start_date, batch_demand, instance.due_dates);
+
+		CheckColumns(product_data, {
+			"product",
+			"usp_days",
+			"dsp_days",
+			"shelf_life_days",
+			"batch_storage_limits",
+			"sell_price_per_batch",
+			"usp_production_cost_per_batch",
+			"dsp_production_cost_per_batch",
+			"storage_cost_per_batch",
+			"waste_cost_per_batch",
+			"backlog_penalty_per_batch",
+			"usp_changeover_cost",
+			"dsp_changeover_cost"
+		});
+
+		instance.product_labels = ProductColumns(batch_demand);
+
+		std::vector<size_t> columns(instance.product_labels.size());
+		for (size_t i = 0; i != columns.size(); ++i) columns[i] = i;
+
+		auto rows = Align(
+			instance.product_labels,
+			ProductRows(product_data),
+			"Product labels from 'batch_demand' and 'product_data' do not match."
+		);
+
+		instance.input_data = deterministic::SingleSiteMultiSuiteInputData(
+			objectives,
+
+			num_usp_suites,
+			num_dsp_suites,
+
+			ReadPeriods<int>(batch_demand, columns),
+			days_per_period,
+
+			Reorder(product_data.Numbers<double>("usp_days"), rows),
+			Reorder(product_data.Numbers<double>("dsp_days"), rows),
+
+			Reorder(product_data.Numbers<int>("shelf_life_days"), rows),
+			Reorder(product_data.Numbers<int>("batch_storage_limits"), rows),
+
+			Reorder(product_data.Numbers<double>("sell_price_per_batch"), rows),
+			Reorder(product_data.Numbers<double>("storage_cost_per_batch"), rows),
+			Reorder(product_data.Numbers<double>("backlog_penalty_per_batch"), rows),
+			Reorder(product_data.Numbers<double>("waste_cost_per_batch"), rows),
+			Reorder(product_data.Numbers<double>("usp_production_cost_per_batch"), rows),
+			Reorder(product_data.Numbers<double>("dsp_production_cost_per_batch"), rows),
+			Reorder(product_data.Numbers<double>("usp_changeover_cost"), rows),
+			Reorder(product_data.Numbers<double>("dsp_changeover_cost"), rows),
+
+			ReadChangeovers<double>(usp_changeover_days, instance.product_labels, "usp_changeover_days"),
+			ReadChangeovers<double>(dsp_changeover_days, instance.product_labels, "dsp_changeover_days"),
+
+			constraints
+		);
+
+		return instance;
+	}
+}
+
+#endif
@@ -0,0 +1,126 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __LOCK_FREE_QUEUE_H__
+#define __LOCK_FREE_QUEUE_H__
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+
+namespace utils
+{
+	/*
+		Bounded queue for any number of producer and consumer threads, which never
+		blocks, i.e. TryPush fails if the queue is full and TryPop if it is empty.
+		Every cell has a sequence number which tells whether it is ready to be
+		written or read in the current lap, so that a push or pop is a single
+		compare-and-swap on the tail or the head.
+
+		Vyukov, D., 2010. Bounded MPMC queue. http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+	*/
+	template<class T>
+	class LockFreeQueue
+	{
+		struct Cell
+		{
+			std::atomic<size_t> sequence;
+			T value;
+		};
+
+		static const size_t CACHE_LINE = 64;
+
+		std::unique_ptr<Cell[]> cells;
+		size_t mask;
+
+		// Keeps the producers and the consumers off each other's cache lines
+		char pad0[CACHE_LINE];
+		std::atomic<size_t> tail;
+		char pad1[CACHE_LINE];
+		std::atomic<size_t> head;
+		char pad2[CACHE_LINE];
+
+	public:
+		// The capacity is rounded up to a power of two.
+		explicit LockFreeQueue(size_t capacity) : tail(0), head(0)
+		{
+			size_t size = 2;
+
+			while (size < capacity) {
+				size *= 2;
+			}
+
+			cells.reset(new Cell[size]);
+			mask = size - 1;
+
+			for (size_t i = 0; i != size; ++i) {
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		LockFreeQueue(const LockFreeQueue&) = delete;
+		LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+		inline size_t Capacity() const
+		{
+			return mask + 1;
+		}
+
+		bool TryPush(const T &value)
+		{
+			size_t pos = tail.load(std::memory_order_relaxed);
+
+			while (true) {
+				Cell &cell = cells[pos & mask];
+				size_t sequence = cell.sequence.load(std::memory_order_acquire);
+				std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)pos;
+
+				if (diff == 0) {
+					if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						cell.value = value;
+						cell.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0) {
+					return false; // Full
+				}
+				else {
+					pos = tail.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool TryPop(T &value)
+		{
+			size_t pos = head.load(std::memory_order_relaxed);
+
+			while (true) {
+				Cell &cell = cells[pos & mask];
+				size_t sequence = cell.sequence.load(std::memory_order_acquire);
+				std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)(pos + 1);
+
+				if (diff == 0) {
+					if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						value = std::move(cell.value);
+						cell.sequence.store(pos + mask + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0) {
+					return false; // Empty
+				}
+				else {
+					pos = head.load(std::memory_order_relaxed);
+				}
+			}
+		}
+	};
+}
+
+#endif
@@ -1,1128 +1,421 @@
+/*
+	Command line solver of the deterministic single site models, e.g. for batch jobs
+	without Python.
+
+	g++ -O2 -std=c++14 -fopenmp -m64 biopharma_scheduling/main.cpp -o biopharma_scheduling.out
+	./biopharma_scheduling.out examples/solver.cfg [key=value ...]
+
+	The settings are read from the config file and can be overridden by 'key=value'
+	arguments, see examples/solver.cfg for all of them. The solutions are written to
+	'output_dir' either as CSV tables ('format = csv') or as a single frame history
+	file 'front.bin' ('format = binary'), which HistoryReader and HistoryFile can read.
+*/
 #include <chrono>
+#include <memory>
+#include <random>
 #include <stdio.h>
+#include <string>
+#include <vector>
 #include <iostream>
-#include <climits>
-#include <cassert>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(_WIN32)
+	#include <direct.h>
+#else
+	#include <sys/stat.h>
+#endif
 
 #include "nsgaii.h"
+#include "config.h"
+#include "batch_runner.h"
+#include "loader.h"
+#include "history.h"
+#include "records.h"
+#include "heuristics.h"
 #include "scheduling_models.h"
 #include "single_objective_ga.h"
 
 
-bool display_schedules = false;
-int seed = 7, num_threads = -1;
-int num_runs = 10, num_gens = 1000, popsize = 200; 
+typedef std::chrono::steady_clock Clock;
 
-int starting_length = 1;
+const std::vector<std::string> SETTINGS = {
+	"model", "data_dir", "start_date", "objectives", "constraints", "num_usp_suites", "num_dsp_suites",
+	"num_runs", "num_gens", "popsize", "starting_length", "p_xo", "p_product_mut", "p_usp_suite_mut",
+	"p_plus_batch_mut", "p_minus_batch_mut", "p_gene_swap", "num_threads", "cpus", "random_state",
+	"heuristic_init", "seeded_ratio", "time_limit", "output_dir", "format", "history_file", "verbose"
+};
 
-double p_xo = 0.131266;
-double p_product_mut = 0.131266;
-double p_usp_suite_mut = 0.131266;
-double p_plus_batch_mut = 0.131266;
-double p_minus_batch_mut = 0.131266;
-double p_gene_swap = 0.131266;
+struct Timings
+{
+	double load = 0.0, init = 0.0, evolve = 0.0, output = 0.0;
+	long long num_evaluations = 0;
+	int num_runs = 0;
+	bool out_of_time = false;
+};
 
+inline double Seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
 
-void DisplaySchedule(types::SingleSiteMultiSuiteSchedule &schedule)
+FILE* OpenOutput(const std::string &output_dir, const std::string &name)
 {
-	printf("Total proft %.1f\n", schedule.objectives[deterministic::OBJECTIVES::TOTAL_PROFIT]);
-	printf("Backlog penalty %.1f\n", schedule.objectives[deterministic::OBJECTIVES::TOTAL_BACKLOG_PENALTY]);
-	printf("Production costs %.1f\n", schedule.objectives[deterministic::OBJECTIVES::TOTAL_PRODUCTION_COST]);
-	printf("Changeover costs %.1f\n", schedule.objectives[deterministic::OBJECTIVES::TOTAL_CHANGEOVER_COST]);
-	printf("Storage costs %.1f\n", schedule.objectives[deterministic::OBJECTIVES::TOTAL_STORAGE_COST]);
-	printf("Waste costs %.1f\n\n", schedule.objectives[deterministic::OBJECTIVES::TOTAL_WASTE_COST]);
-
-	for (const auto &suite : schedule.suites) {
-		for (const auto &cmpgn : suite) {
-			printf(
-				"Suite: %d, p%d, %d, start: %.1f, end: %.1f\n", 
-				cmpgn.suite_num,
-				cmpgn.product_num, 
-				cmpgn.num_batches,
-				cmpgn.start,
-				cmpgn.end
-			);
-		}
-	}
+	FILE *file = fopen((output_dir + "/" + name).c_str(), "w");
 
-	printf("\nInventory\n\n");
-	for (const auto &row : schedule.batch_inventory) {
-		for (const auto &val : row) {
-			printf("%d  ", val);
-		}
-		printf("\n");
+	if (!file) {
+		throw std::runtime_error("Cannot write '" + output_dir + "/" + name + "'");
 	}
 
-	printf("\nBacklog\n\n");
-	for (const auto &row : schedule.batch_backlog) {
-		for (const auto &val : row) {
-			printf("%d  ", val);
-		}
-		printf("\n");
-	}
+	return file;
+}
 
-	printf("\nSold\n\n");
-	for (const auto &row : schedule.batch_supply) {
-		for (const auto &val : row) {
-			printf("%d  ", val);
-		}
-		printf("\n");
+/*
+	Writes 'front.csv' with the objectives of the solutions, 'schedules.csv' with all
+	the objectives of their schedules, 'campaigns.csv', 'batches.csv' and 'periods.csv'
+	with the inventory, backlog, supply and waste of every product and due date. All
+	the times are in days from the start date.
+*/
+template<class Schedule, class Model, class Instance, class Chromosome>
+void WriteCSV(const std::string &output_dir, Model &model, const Instance &instance, std::vector<Chromosome> &solutions)
+{
+	FILE *front = OpenOutput(output_dir, "front.csv");
+	FILE *schedules = OpenOutput(output_dir, "schedules.csv");
+	FILE *campaigns = OpenOutput(output_dir, "campaigns.csv");
+	FILE *batches = OpenOutput(output_dir, "batches.csv");
+	FILE *periods = OpenOutput(output_dir, "periods.csv");
+
+	fprintf(front, "solution");
+	for (const auto &objective : instance.input_data.objectives) {
+		fprintf(front, ",%s", io::ObjectiveName(objective.first).c_str());
 	}
+	fprintf(front, ",constraints\n");
 
-	printf("\nWaste\n\n");
-	for (const auto &row : schedule.batch_waste) {
-		for (const auto &val : row) {
-			printf("%d  ", val);
-		}
-		printf("\n");
+	fprintf(schedules, "solution");
+	for (int objective = 0; objective != deterministic::NUM_OBJECTIVES; ++objective) {
+		fprintf(schedules, ",%s", io::ObjectiveName((deterministic::OBJECTIVES)objective).c_str());
 	}
-}
+	fprintf(schedules, "\n");
 
- void Det_SingleSiteMultiSuite_Example1_Test()
-{
-	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
- 	objectives.emplace(deterministic::TOTAL_PROFIT, 1);
-	
- 	std::vector<std::vector<int>> demand =
- 	{
- 		{ 0, 0, 0, 6, 0, 6 },
- 		{ 0, 0, 6, 0, 0, 0 },
- 		{ 0, 8, 0, 0, 8, 0 }
- 	};
-
- 	std::vector<int> days_per_period = { 60, 60, 60, 60, 60, 60 };
-
-     int num_usp_suites = 2, num_dsp_suites = 2, num_products = demand.size();
-
-	std::vector<double> sales_price = { 20, 20, 20 };
-	std::vector<double> usp_production_cost = { 2, 2, 2 };
-	std::vector<double> dsp_production_cost = { 2, 2, 2 };
-	std::vector<double> waste_disposal_cost = { 1, 1, 1 };
-	std::vector<double> storage_cost = { 1, 1, 1 };
-	std::vector<double> backlog_penalty = { 20, 20, 20 };
-	std::vector<double> usp_changeover_cost = { 1, 1, 1 };
-	std::vector<double> dsp_changeover_cost = { 1, 1, 1 };
- 
-	std::vector<double> usp_days = { 20, 22, 12.5 };
-	std::vector<double> dsp_days = { 10, 10, 10 };
-
-	std::vector<std::vector<double>> usp_changeovers = {
-		{ 10, 10, 10 },
-		{ 10, 10, 10 },
-		{ 10, 10, 10 }
-	};
-
-	std::vector<std::vector<double>> dsp_changeovers = {
-		{ 10,   10,   10 },
-		{ 10,   10,   10 },
-		{ 12.5, 12.5, 12.5 }
-	};
-
-	std::vector<int> shelf_life = { 180, 180, 180 };
-	std::vector<int> storage_cap = { 40, 40, 40 };
-
-	deterministic::SingleSiteMultiSuiteInputData input_data(
- 		objectives, 
-
-		num_usp_suites,
-		num_dsp_suites,
-
-		demand,
-		days_per_period,
-
-		usp_days,
-		dsp_days,
-        
-		shelf_life,
-		storage_cap,
-
-		sales_price,
-		storage_cost,
-		backlog_penalty,
-		waste_disposal_cost,
-		usp_production_cost,
-		dsp_production_cost,
-		usp_changeover_cost,
-		dsp_changeover_cost,
-
-		usp_changeovers,
-		dsp_changeovers
-	);
-
- 	deterministic::SingleSiteMultiSuiteModel single_site_multi_suite_model(input_data);
-
- 	algorithms::SingleObjectiveGA<types::SingleObjectiveChromosome<types::SingleSiteMultiSuiteGene>, deterministic::SingleSiteMultiSuiteModel> simple_ga(
- 		single_site_multi_suite_model,
- 		seed,
- 		num_threads
- 	);
-
- 	for (int run = 0; run != num_runs; ++run) {
- 		simple_ga.Init(
- 			popsize,
- 			starting_length,
- 			p_xo,
- 			p_gene_swap,
- 			num_products,
- 			num_usp_suites,
- 			p_product_mut,
- 			p_usp_suite_mut,
- 			p_plus_batch_mut,
- 			p_minus_batch_mut
- 		);
-
- 		for (int gen = 0; gen != num_gens; ++gen) {
- 			simple_ga.Update();
-
- 			printf(
- 				"\rRun %d, Gen: %d, Best: %.1f, Constraint: %.1f, Length: %d",
- 				run + 1, gen + 1, simple_ga.Top().objective, simple_ga.Top().constraints, simple_ga.Top().genes.size()
- 			);
-
- 			std::cout << std::flush;
- 		}
-
- 		auto best = simple_ga.Top();
-
- 		types::SingleSiteMultiSuiteSchedule schedule;
- 		single_site_multi_suite_model.CreateSchedule(best, schedule);
-
- 		int total_num_usp_campaigns = 0;
-
- 		for (int usp_suite = 0; usp_suite != num_usp_suites; ++usp_suite) {
- 			total_num_usp_campaigns += schedule.suites[usp_suite].size();
- 		}
-
- 		printf(
- 			", (%.1f, %.1f, %d)\n", 
- 			schedule.objectives[deterministic::OBJECTIVES::TOTAL_PROFIT], 
- 			schedule.objectives[deterministic::OBJECTIVES::TOTAL_BACKLOG_PENALTY],
- 			total_num_usp_campaigns
- 		);
- 		std::cout << std::flush;
-
- 		if (display_schedules) {
- 			DisplaySchedule(schedule);
- 		}
- 	}
-}
+	fprintf(campaigns, "solution,campaign,product,suite,batches,kg,start,first_harvest,first_batch,last_batch,end\n");
+	fprintf(batches, "solution,campaign,product,kg,start,harvested_at,stored_at,expires_at,approved_at\n");
+	fprintf(periods, "solution,product,date,inventory,backlog,supply,waste\n");
 
- void Det_SingleSiteMultiSuite_Example2_Test()
-{
-	int seed = 7;
-	int num_threads = -1;
-	int num_runs = 10;
-	int num_gens = 100;
-	int popsize = 100; 
-
-	int starting_length = 1;
-
-	double p_xo = 0.026776;
-	double p_product_mut = 0.004667;
-	double p_usp_suite_mut = 0.015991;
-	double p_plus_batch_mut = 0.896385;
-	double p_minus_batch_mut = 0.853790;
-	double p_gene_swap = 0.403328;
-
-	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
- 	objectives.emplace(deterministic::TOTAL_PROFIT, 1);
-
-	std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> constraints;
-	constraints.emplace(deterministic::TOTAL_BACKLOG_PENALTY, std::make_pair(-1, 0));
-	
- 	std::vector<std::vector<int>> demand =
- 	{
-		{  0,0,0,6,0,4,0,0,4  },
-		{  0,4,0,0,0,0,4,0,0  },
-		{  0,0,0,0,10,0,0,0,10  },
-		{  0,6,0,8,0,0,0,0,0  },
- 	};
-
- 	std::vector<int> days_per_period = { 60, 60, 60, 60, 60, 60, 60, 60, 60 };
-
-    int num_usp_suites = 2, num_dsp_suites = 3, num_products = demand.size();
-
-	std::vector<double> sales_price = { 25.0, 20.0,	17.0, 17.0 };
-	std::vector<double> usp_production_cost = { 5.0, 2.0, 1.0, 1.0 };
-	std::vector<double> dsp_production_cost = { 5.0, 2.0, 1.0, 1.0 };
-	std::vector<double> waste_disposal_cost = { 5.0, 5.0, 5.0, 5.0 };
-	std::vector<double> storage_cost = { 1.0, 1.0, 1.0, 1.0 };
-	std::vector<double> backlog_penalty = { 20.0, 20.0, 20.0, 20.0 };
-	std::vector<double> usp_changeover_cost = { 1.0, 1.0, 1.0, 1.0 };
-	std::vector<double> dsp_changeover_cost = { 1.0, 1.0, 1.0, 1.0 };
- 
-	std::vector<double> usp_days = { 20.0, 22.2222, 12.5, 12.5 };
-	std::vector<double> dsp_days = { 10.0, 10.0, 10.0, 10.0 };
-
-	std::vector<std::vector<double>> usp_changeovers = {
-		{  10.0,10.0,10.0,10.0  },
-		{  10.0,10.0,10.0,10.0  },
-		{  10.0,10.0,10.0,10.0  },
-		{  10.0,10.0,10.0,10.0  },
-	};
-
-	std::vector<std::vector<double>> dsp_changeovers = {
-		{  10.0,10.0,10.0,10.0  },
-		{  10.0,10.0,10.0,10.0  },
-		{  12.5,12.5,12.5,12.5  },
-		{  12.5,12.5,12.5,12.5  },
-	};
-
-	std::vector<int> shelf_life = { 180, 180, 180, 180 };
-	std::vector<int> storage_cap = { 40, 40, 40, 40 };
-
-	deterministic::SingleSiteMultiSuiteInputData input_data(
- 		objectives, 
-
-		num_usp_suites,
-		num_dsp_suites,
-
-		demand,
-		days_per_period,
-
-		usp_days,
-		dsp_days,
-        
-		shelf_life,
-		storage_cap,
-
-		sales_price,
-		storage_cost,
-		backlog_penalty,
-		waste_disposal_cost,
-		usp_production_cost,
-		dsp_production_cost,
-		usp_changeover_cost,
-		dsp_changeover_cost,
-
-		usp_changeovers,
-		dsp_changeovers,
-
-		&constraints
-	);
-
- 	deterministic::SingleSiteMultiSuiteModel single_site_multi_suite_model(input_data);
-
- 	algorithms::SingleObjectiveGA<types::SingleObjectiveChromosome<types::SingleSiteMultiSuiteGene>, deterministic::SingleSiteMultiSuiteModel> simple_ga(
- 		single_site_multi_suite_model,
- 		seed,
- 		num_threads
- 	);
-
-	std::vector<types::SingleObjectiveChromosome<types::SingleSiteMultiSuiteGene>> solutions;
-
- 	for (int run = 0; run != num_runs; ++run) {
- 		simple_ga.Init(
- 			popsize,
- 			starting_length,
- 			p_xo,
- 			p_gene_swap,
- 			num_products,
- 			num_usp_suites,
- 			p_product_mut,
- 			p_usp_suite_mut,
- 			p_plus_batch_mut,
- 			p_minus_batch_mut
- 		);
-
- 		
- 		for (int gen = 0; gen != num_gens; ++gen) {
- 			simple_ga.Update();
-
- 			printf(
- 				"\rRun %d, Gen: %d, Best: %.1f, Constraint: %.1f, Length: %d",
- 				run + 1, gen + 1, simple_ga.Top().objective, simple_ga.Top().constraints, simple_ga.Top().genes.size()
- 			);
-
- 			std::cout << std::flush;
- 		}
-
- 		auto best = simple_ga.Top();
-
- 		types::SingleSiteMultiSuiteSchedule schedule;
- 		single_site_multi_suite_model.CreateSchedule(best, schedule);
-
- 		int total_num_usp_campaigns = 0;
-
- 		for (int usp_suite = 0; usp_suite != num_usp_suites; ++usp_suite) {
- 			total_num_usp_campaigns += schedule.suites[usp_suite].size();
- 		}
-
- 		printf(
- 			", (%.1f, %.1f, %d)\n", 
- 			schedule.objectives[deterministic::OBJECTIVES::TOTAL_PROFIT], 
- 			schedule.objectives[deterministic::OBJECTIVES::TOTAL_BACKLOG_PENALTY],
- 			total_num_usp_campaigns
- 		);
- 		std::cout << std::flush;
-
- 		if (display_schedules) {
- 			DisplaySchedule(schedule);
- 		}
-	 }
-}
+	types::ScheduleRecords records;
 
-void Det_SingleSiteSimple_SingleObjective_Test()
-{
-	seed = 7;
-
-	num_runs = 20;
-	num_gens = 100;
-	popsize = 100;
-
-	p_xo = 0.108198;
-	p_product_mut = 0.041373;
-	p_plus_batch_mut = 0.608130;
-	p_minus_batch_mut = 0.765819;
-	p_gene_swap = 0.471346;
-
-	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
-	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
-
-	std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> constraints;
-	constraints.emplace(deterministic::TOTAL_KG_BACKLOG, std::make_pair(-1, 0));
-	constraints.emplace(deterministic::TOTAL_KG_WASTE, std::make_pair(-1, 0));
-
-	// Kg demand
-	std::vector<std::vector<double>> kg_demand = { 
-		{ 0.0,0.0,3.1,0.0,0.0,3.1,0.0,3.1,3.1,3.1,0.0,6.2,6.2,3.1,6.2,0.0,3.1,9.3,0.0,6.2,6.2,0.0,6.2,9.3,0.0,9.3,6.2,3.1,6.2,3.1,0.0,9.3,6.2,9.3,6.2,0.0 },
-		{ 0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,6.2,0.0,0.0,0.0,0.0,0.0,6.2,0.0,0.0,0.0,0.0,0.0,0.0,6.2 },
-		{ 0.0,0.0,0.0,0.0,0.0,0.0,4.9,4.9,0.0,0.0,0.0,9.8,4.9,0.0,4.9,0.0,0.0,4.9,9.8,0.0,0.0,0.0,4.9,4.9,0.0,9.8,0.0,0.0,4.9,9.8,9.8,0.0,4.9,9.8,4.9,0.0 },
-		{ 0.0,5.5,5.5,0.0,5.5,5.5,5.5,5.5,5.5,0.0,11.0,5.5,0.0,5.5,5.5,11.0,5.5,5.5,0.0,5.5,5.5,5.5,11.0,5.5,0.0,11.0,0.0,11.0,5.5,5.5,0.0,11.0,11.0,0.0,5.5,5.5 }
-	};
-	
-	int num_products = kg_demand.size();
-
-	// 6-month kg inventoy safety levels
-	std::vector<std::vector<double>> kg_inventory_target = {
-		{ 6.2,6.2,9.3,9.3,12.4,12.4,15.5,21.7,21.7,24.8,21.7,24.8,27.9,21.7,24.8,24.8,24.8,27.9,27.9,27.9,31.0,31.0,34.1,34.1,27.9,27.9,27.9,27.9,34.1,34.1,31.0,31.0,21.7,15.5,6.2,0.0 },
-		{ 0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2 },
-		{ 0.0,4.9,9.8,9.8,9.8,9.8,19.6,19.6,14.7,19.6,19.6,19.6,14.7,19.6,19.6,14.7,14.7,19.6,19.6,9.8,19.6,19.6,19.6,19.6,24.5,34.3,24.5,29.4,39.2,39.2,29.4,19.6,19.6,14.7,4.9,0.0 },
-		{ 22.0,27.5,27.5,27.5,27.5,33.0,33.0,27.5,27.5,27.5,38.5,33.0,33.0,33.0,33.0,33.0,27.5,33.0,33.0,33.0,38.5,33.0,38.5,33.0,33.0,33.0,33.0,44.0,33.0,33.0,33.0,33.0,22.0,11.0,11.0,5.5 },
-	};
-
-	std::vector<int> days_per_period = std::vector<int>{ 
-		31,31,28,31,30,31,30,31,31,30,31,30,31,31,28,31,30,31,30,31,31,30,31,30,31,31,28,31,30,31,30,31,31,30,31,30
-	};
-
-	std::vector<double> kg_yield_per_batch = { 3.1, 6.2, 4.9, 5.5 };
-	std::vector<double> kg_storage_limits = { 250, 250, 250, 250 }; // set high to ignore
-	std::vector<double> kg_opening_stock = { 18.6, 0, 19.6, 32.0 };
-
-	std::vector<double> inventory_penalty_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> backlog_penalty_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> production_cost_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> storage_cost_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> waste_cost_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> sell_price_per_kg = { 1, 1, 1, 1 };
-
-	std::vector<int> inoculation_days = { 20, 15, 20, 26 };
-	std::vector<int> seed_days = { 11, 7, 11, 9 };
-	std::vector<int> production_days = { 14, 14, 14, 14 };
-	std::vector<int> usp_days = { 45, 36, 45, 49 }; //
-	std::vector<int> dsp_days = { 7, 11, 7, 7 };
-	std::vector<int> shelf_life_days = { 730, 730, 730, 730 }; // set high to ignore
-	std::vector<int> approval_days = { 90, 90, 90, 90 };
-	std::vector<int> min_batches_per_campaign = { 2, 2, 2, 3 };
-	std::vector<int> max_batches_per_campaign = { 50, 50, 50, 30 };
-	std::vector<int> batches_multiples_of_per_campaign = { 1, 1, 1, 3 };
-
-	std::vector<std::vector<int>> changeover_days = {
-		{ 0,  10, 16, 20 },
-		{ 16,  0, 16, 20 },
-		{ 16, 10,  0, 20 },
-		{ 18, 10, 18,  0 }
-	};
-
-	deterministic::SingleSiteSimpleInputData input_data(
-		objectives,
-		kg_demand,
-		days_per_period,
-
-		kg_opening_stock,
-		kg_yield_per_batch,
-		kg_storage_limits,
-
-		inventory_penalty_per_kg,
-		backlog_penalty_per_kg,
-		production_cost_per_kg,
-		storage_cost_per_kg,
-		waste_cost_per_kg,
-		sell_price_per_kg,		
-
-		inoculation_days,
-		seed_days,
-		production_days,
-		usp_days,
-		dsp_days,
-		approval_days,
-		shelf_life_days,
-		min_batches_per_campaign,
-		max_batches_per_campaign,
-		batches_multiples_of_per_campaign,
-		changeover_days,
-
-		&kg_inventory_target,
-		&constraints
-	);
-
-	deterministic::SingleSiteSimpleModel deterministic_fitness(input_data);
-	
-	algorithms::SingleObjectiveGA<types::SingleObjectiveChromosome<types::SingleSiteSimpleGene>, deterministic::SingleSiteSimpleModel> ga(
-		deterministic_fitness,
-		seed,
-		num_threads
-	);
-
-	std::vector<types::SingleObjectiveChromosome<types::SingleSiteSimpleGene>> solutions;
-
-	double mean_time = 0.0;
-
-	for (int run = 0; run < num_runs; ++run) {
-
-		auto start = std::chrono::steady_clock::now();
-
-		ga.Init(
-			popsize,
-
-			//Individual Params + GeneParams
-			starting_length,
-			p_xo,
-			p_gene_swap,
-
-			//GeneParams 
-			num_products,
-			p_product_mut,
-			p_plus_batch_mut,
-			p_minus_batch_mut
-		);
+	for (int s = 0; s != solutions.size(); ++s) {
+		// Schedules are not reused, Init does not clear the campaigns
+		Schedule schedule;
+		model.CreateSchedule(solutions[s], schedule);
+		types::MakeRecords(schedule, records);
 
-		for (int gen = 0; gen < num_gens; ++gen) {
-			ga.Update();
-		}			
+		fprintf(front, "%d", s);
+		for (const auto &objective : instance.input_data.objectives) {
+			fprintf(front, ",%.10g", schedule.objectives[objective.first]);
+		}
+		fprintf(front, ",%.10g\n", solutions[s].constraints);
 
-		auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
-		mean_time += elapsed_time;
+		fprintf(schedules, "%d", s);
+		for (const auto &value : schedule.objectives) {
+			fprintf(schedules, ",%.10g", value);
+		}
+		fprintf(schedules, "\n");
 
-		auto solution = ga.Top();
-		solutions.push_back(solution);
+		for (int c = 0; c != records.campaigns.size(); ++c) {
+			const auto &campaign = records.campaigns[c];
 
-		types::SingleSiteSimpleSchedule schedule;
-		deterministic_fitness.CreateSchedule(solution, schedule);
-	}
+			fprintf(
+				campaigns, "%d,%d,%s,%d,%d,%.10g,%.10g,%.10g,%.10g,%.10g,%.10g\n",
+				s, c, instance.product_labels[campaign.product_num - 1].c_str(), campaign.suite_num, campaign.num_batches,
+				campaign.kg, campaign.start, campaign.first_harvest, campaign.first_batch, campaign.last_batch, campaign.end
+			);
+		}
 
-	if (solutions.size()) {
-		auto solution = ga.Top(solutions);
-		types::SingleSiteSimpleSchedule schedule;;
-		deterministic_fitness.CreateSchedule(solution, schedule);
+		for (const auto &batch : records.batches) {
+			fprintf(
+				batches, "%d,%d,%s,%.10g,%.10g,%.10g,%.10g,%.10g,%.10g\n",
+				s, batch.campaign_num, instance.product_labels[batch.product_num - 1].c_str(), batch.kg,
+				batch.start, batch.harvested_at, batch.stored_at, batch.expires_at, batch.approved_at
+			);
+		}
 
-		std::cout << "\n######################## After " << num_runs << " num_runs, mean elapsed time: " << mean_time / num_runs << " ms ########################\n" << std::endl;
+		for (int p = 0; p != records.num_products; ++p) {
+			for (int t = 0; t != records.num_periods; ++t) {
+				int i = p * records.num_periods + t;
 
-		printf(
-			"Top Solution:\nTotal kg throughput: %.2f (%.2f)\nTotal kg inventory deficit: %.2f\nTotal kg backlog: %.2f\nTotal kg waste: %.2f\n\n",
-			solution.objective, schedule.objectives[deterministic::TOTAL_KG_THROUGHPUT],
-			schedule.objectives[deterministic::TOTAL_KG_INVENTORY_DEFICIT],
-			schedule.objectives[deterministic::TOTAL_KG_BACKLOG],
-			schedule.objectives[deterministic::TOTAL_KG_WASTE]
-		);
+				fprintf(
+					periods, "%d,%s,%s,%.10g,%.10g,%.10g,%.10g\n",
+					s, instance.product_labels[p].c_str(), instance.due_dates[t].c_str(),
+					records.inventory[i], records.backlog[i], records.supply[i], records.waste[i]
+				);
+			}
+		}
 	}
+
+	fclose(front);
+	fclose(schedules);
+	fclose(campaigns);
+	fclose(batches);
+	fclose(periods);
 }
 
-void Det_SingleSiteSimple_MultiObjective_Test()
+template<template<class, class> class GA, class Chromosome, class Model, class Schedule, class Instance, class... ChromosomeParams>
+void Solve(const io::Config &config, const Instance &instance, Timings &timings, ChromosomeParams... params)
 {
-	seed = 7;
-	num_threads = -1;
-
-	num_runs = 20;
-	num_gens = 100;
-	popsize = 100;
-
-	p_xo = 0.108198;
-	p_product_mut = 0.041373;
-	p_plus_batch_mut = 0.608130;
-	p_minus_batch_mut = 0.765819;
-	p_gene_swap = 0.471346;
-
-	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
-	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
-	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
-
-	std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> constraints;
-	constraints.emplace(deterministic::TOTAL_KG_BACKLOG, std::make_pair(-1, 0));
-	constraints.emplace(deterministic::TOTAL_KG_WASTE, std::make_pair(-1, 0));
-
-	// Kg demand
-	std::vector<std::vector<double>> kg_demand = { 
-		{ 0.0,0.0,3.1,0.0,0.0,3.1,0.0,3.1,3.1,3.1,0.0,6.2,6.2,3.1,6.2,0.0,3.1,9.3,0.0,6.2,6.2,0.0,6.2,9.3,0.0,9.3,6.2,3.1,6.2,3.1,0.0,9.3,6.2,9.3,6.2,0.0 },
-		{ 0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,6.2,0.0,0.0,0.0,0.0,0.0,6.2,0.0,0.0,0.0,0.0,0.0,0.0,6.2 },
-		{ 0.0,0.0,0.0,0.0,0.0,0.0,4.9,4.9,0.0,0.0,0.0,9.8,4.9,0.0,4.9,0.0,0.0,4.9,9.8,0.0,0.0,0.0,4.9,4.9,0.0,9.8,0.0,0.0,4.9,9.8,9.8,0.0,4.9,9.8,4.9,0.0 },
-		{ 0.0,5.5,5.5,0.0,5.5,5.5,5.5,5.5,5.5,0.0,11.0,5.5,0.0,5.5,5.5,11.0,5.5,5.5,0.0,5.5,5.5,5.5,11.0,5.5,0.0,11.0,0.0,11.0,5.5,5.5,0.0,11.0,11.0,0.0,5.5,5.5 }
-	};
-	
-	int num_products = kg_demand.size();
-
-	// 6-month kg inventoy safety levels
-	std::vector<std::vector<double>> kg_inventory_target = {
-		{ 6.2,6.2,9.3,9.3,12.4,12.4,15.5,21.7,21.7,24.8,21.7,24.8,27.9,21.7,24.8,24.8,24.8,27.9,27.9,27.9,31.0,31.0,34.1,34.1,27.9,27.9,27.9,27.9,34.1,34.1,31.0,31.0,21.7,15.5,6.2,0.0 },
-		{ 0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2 },
-		{ 0.0,4.9,9.8,9.8,9.8,9.8,19.6,19.6,14.7,19.6,19.6,19.6,14.7,19.6,19.6,14.7,14.7,19.6,19.6,9.8,19.6,19.6,19.6,19.6,24.5,34.3,24.5,29.4,39.2,39.2,29.4,19.6,19.6,14.7,4.9,0.0 },
-		{ 22.0,27.5,27.5,27.5,27.5,33.0,33.0,27.5,27.5,27.5,38.5,33.0,33.0,33.0,33.0,33.0,27.5,33.0,33.0,33.0,38.5,33.0,38.5,33.0,33.0,33.0,33.0,44.0,33.0,33.0,33.0,33.0,22.0,11.0,11.0,5.5 },
-	};
-
-	std::vector<int> days_per_period = std::vector<int>{ 
-		31,31,28,31,30,31,30,31,31,30,31,30,31,31,28,31,30,31,30,31,31,30,31,30,31,31,28,31,30,31,30,31,31,30,31,30
-	};
-
-	std::vector<double> kg_yield_per_batch = { 3.1, 6.2, 4.9, 5.5 };
-	std::vector<double> kg_storage_limits = { 250, 250, 250, 250 }; // set high to ignore
-	std::vector<double> kg_opening_stock = { 18.6, 0, 19.6, 32.0 };
-
-	std::vector<double> inventory_penalty_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> backlog_penalty_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> production_cost_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> storage_cost_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> waste_cost_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> sell_price_per_kg = { 1, 1, 1, 1 };
-
-	std::vector<int> inoculation_days = { 20, 15, 20, 26 };
-	std::vector<int> seed_days = { 11, 7, 11, 9 };
-	std::vector<int> production_days = { 14, 14, 14, 14 };
-	std::vector<int> usp_days = { 45, 36, 45, 49 }; //
-	std::vector<int> dsp_days = { 7, 11, 7, 7 };
-	std::vector<int> shelf_life_days = { 730, 730, 730, 730 }; // set high to ignore
-	std::vector<int> approval_days = { 90, 90, 90, 90 };
-	std::vector<int> min_batches_per_campaign = { 2, 2, 2, 3 };
-	std::vector<int> max_batches_per_campaign = { 50, 50, 50, 30 };
-	std::vector<int> batches_multiples_of_per_campaign = { 1, 1, 1, 3 };
-
-	std::vector<std::vector<int>> changeover_days = {
-		{ 0,  10, 16, 20 },
-		{ 16,  0, 16, 20 },
-		{ 16, 10,  0, 20 },
-		{ 18, 10, 18,  0 }
-	};
-
-	deterministic::SingleSiteSimpleInputData input_data(
-		objectives,
-		kg_demand,
-		days_per_period,
-
-		kg_opening_stock,
-		kg_yield_per_batch,
-		kg_storage_limits,
-
-		inventory_penalty_per_kg,
-		backlog_penalty_per_kg,
-		production_cost_per_kg,
-		storage_cost_per_kg,
-		waste_cost_per_kg,
-		sell_price_per_kg,		
-
-		inoculation_days,
-		seed_days,
-		production_days,
-		usp_days,
-		dsp_days,
-		approval_days,
-		shelf_life_days,
-		min_batches_per_campaign,
-		max_batches_per_campaign,
-		batches_multiples_of_per_campaign,
-		changeover_days,
-
-		&kg_inventory_target,
-		&constraints
-	);
-
-	deterministic::SingleSiteSimpleModel deterministic_fitness(input_data);
-	
-	algorithms::NSGAII<types::NSGAChromosome<types::SingleSiteSimpleGene>, deterministic::SingleSiteSimpleModel> nsgaii(
-		deterministic_fitness,
-		seed,
-		num_threads
-	);
-
-	std::vector<types::NSGAChromosome<types::SingleSiteSimpleGene>> solutions;
-
-	double mean_time = 0.0;
-
-	for (int run = 0; run < num_runs; ++run) {
-
-		auto start = std::chrono::steady_clock::now();
-
-		nsgaii.Init(
-			popsize,
-
-			//Individual Params + GeneParams
-			starting_length,
-			p_xo,
-			p_gene_swap,
-
-			//GeneParams 
-			num_products,
-			p_product_mut,
-			p_plus_batch_mut,
-			p_minus_batch_mut
-		);
+	auto start = Clock::now();
+
+	int num_runs = config.Int("num_runs", 10);
+	int num_gens = config.Int("num_gens", 1000);
+	int popsize = config.Int("popsize", 100);
+	double time_limit = config.Double("time_limit", 0.0);
+	bool verbose = config.Bool("verbose", false);
+	std::string output_dir = config.String("output_dir", ".");
+	std::string format = config.String("format", "csv");
+
+#if defined(_WIN32)
+	_mkdir(output_dir.c_str());
+#else
+	mkdir(output_dir.c_str(), 0755);
+#endif
+
+
+	Model model(instance.input_data);
+	GA<Chromosome, Model> ga(model, config.Int("random_state", std::random_device{}()), config.Int("num_threads", -1));
+	ga.SetSeededRatio(config.Double("seeded_ratio", 0.5));
+
+	if (config.Has("cpus")) {
+		auto cpus = utils::ParseCpuList(config.String("cpus", ""));
+		ga.SetExecutor(std::make_shared<algorithms::PoolExecutor>(cpus.size(), 4, cpus));
+	}
 
-		for (int gen = 0; gen < num_gens; ++gen) {
-			nsgaii.Update();
-		}			
+	std::vector<Chromosome> seeds;
 
-		auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
-		mean_time += elapsed_time;
+	if (config.Bool("heuristic_init", false)) {
+		seeds = heuristics::Seeds<Chromosome>(instance.input_data);
+	}
 
-		auto top_front = nsgaii.TopFront();
-		solutions.insert(solutions.end(), top_front.begin(), top_front.end());
+	std::vector<std::string> objective_names;
 
-		types::SingleSiteSimpleSchedule schedule_x, schedule_y;
-		deterministic_fitness.CreateSchedule(top_front[0], schedule_x);
-		deterministic_fitness.CreateSchedule(top_front.back(), schedule_y);
+	for (const auto &objective : instance.input_data.objectives) {
+		objective_names.push_back(io::ObjectiveName(objective.first));
 	}
 
-	if (solutions.size()) {
-		solutions = nsgaii.TopFront(solutions);
-		types::SingleSiteSimpleSchedule schedule_x, schedule_y;
-		deterministic_fitness.CreateSchedule(solutions[0], schedule_x);
-		deterministic_fitness.CreateSchedule(solutions.back(), schedule_y);
+	std::unique_ptr<io::HistoryWriter<Chromosome>> history;
 
-		std::cout << "\n######################## After " << num_runs << " num_runs, no. best solutions: " << solutions.size() << ", mean elapsed time: " << mean_time / num_runs << " ms ########################\n" << std::endl;
+	if (config.Has("history_file")) {
+		history.reset(new io::HistoryWriter<Chromosome>(config.String("history_file", ""), objective_names));
+	}
 
-		printf(
-			"Solution X:\nTotal kg throughput: %.2f (%.2f)\nTotal kg inventory deficit: %.2f (%.2f)\nTotal kg backlog: %.2f\nTotal kg waste: %.2f\n\n",
-			solutions[0].objectives[0], schedule_x.objectives[deterministic::TOTAL_KG_THROUGHPUT],
-			solutions[0].objectives[1], schedule_x.objectives[deterministic::TOTAL_KG_INVENTORY_DEFICIT],
-			schedule_x.objectives[deterministic::TOTAL_KG_BACKLOG],
-			schedule_x.objectives[deterministic::TOTAL_KG_WASTE]
-		);
+	std::vector<Chromosome> solutions;
 
-		printf(
-			"Solution Y:\nTotal kg throughput: %.2f (%.2f)\nTotal kg inventory deficit: %.2f (%.2f)\nTotal kg backlog: %.2f\nTotal kg waste: %.2f\n\n",
-			solutions.back().objectives[0], schedule_y.objectives[deterministic::TOTAL_KG_THROUGHPUT],
-			solutions.back().objectives[1], schedule_y.objectives[deterministic::TOTAL_KG_INVENTORY_DEFICIT],
-			schedule_y.objectives[deterministic::TOTAL_KG_BACKLOG],
-			schedule_y.objectives[deterministic::TOTAL_KG_WASTE]
-		);
-	}
-}
+	for (int run = 0; run < num_runs && !timings.out_of_time; ++run) {
+		auto phase = Clock::now();
 
-void Stoch_SingleSiteSimple_SingleObjective_Test()
-{
-	int mc_seed = 7;
-	int num_mc_sims = 100;
-
-	seed = 7;
-	num_threads = -1;
-
-	num_runs = 10;
-	num_gens = 100;
-	popsize = 100;
-
-	p_xo = 0.108198;
-	p_product_mut = 0.041373;
-	p_plus_batch_mut = 0.608130;
-	p_minus_batch_mut = 0.765819;
-	p_gene_swap = 0.471346;
-
-	std::unordered_map<stochastic::OBJECTIVES, int> objectives;
-	objectives.emplace(stochastic::TOTAL_KG_THROUGHPUT_MEAN, 1);
-
-	std::unordered_map<stochastic::OBJECTIVES, std::pair<int, double>> constraints;
-	constraints.emplace(stochastic::TOTAL_KG_BACKLOG_MEAN, std::make_pair(-1, 0));
-	constraints.emplace(stochastic::TOTAL_KG_WASTE_MEAN, std::make_pair(-1, 0));
-
-	// Kg demand
-	std::vector<std::vector<double>> kg_demand_min = {
-		{ 0,0,3.1,0,0,3.1,0,3.1,3.1,3.1,0,6.2,6.2,3.1,6.2,0,3.1,9.3,0,6.2,6.2,0,6.2,9.3,0,9.3,6.2,3.1,6.2,3.1,0,9.3,6.2,9.3,6.2,0 },
-	    { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6.2,0,0,0,0,0,6.2,0,0,0,0,0,0,6.2 },
-		{ 0,0,0,0,0,0,4.9,4.9,0,0,0,9.8,4.9,0,4.9,0,0,4.9,9.8,0,0,0,4.9,4.9,0,9.8,0,0,4.9,9.8,9.8,0,4.9,9.8,4.9,0 },
-		{ 0,5.5,5.5,0,5.5,5.5,5.5,5.5,5.5,0,11,5.5,0,5.5,5.5,11,5.5,5.5,0,5.5,5.5,5.5,11,5.5,0,11,0,11,5.5,5.5,0,11,11,0,5.5,5.5 },
-	};
-
-	std::vector<std::vector<double>> kg_demand_mode = {
-		{ 0,0,3.1,0,0,3.1,0,3.1,3.1,3.1,0,6.2,6.2,3.1,6.2,0,3.1,9.3,0,6.2,6.2,0,6.2,9.3,0,9.3,6.2,3.1,6.2,3.1,0,9.3,6.2,9.3,6.2,0 },
-	    { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6.2,0,0,0,0,0,6.2,0,0,0,0,0,0,6.2 },
-		{ 0,0,0,0,0,0,4.9,4.9,0,0,0,9.8,4.9,0,4.9,0,0,4.9,9.8,0,0,0,4.9,4.9,0,9.8,0,0,4.9,9.8,9.8,0,4.9,9.8,4.9,0 },
-		{ 0,5.5,5.5,0,5.5,5.5,5.5,5.5,5.5,0,11,5.5,0,5.5,5.5,11,5.5,5.5,0,5.5,5.5,5.5,11,5.5,0,11,0,11,5.5,5.5,0,11,11,0,5.5,5.5 },
-	};
-
-	std::vector<std::vector<double>> kg_demand_max = {
-		{ 0,0,3.1,0,0,3.1,0,3.1,3.1,3.1,0,6.2,6.2,3.1,6.2,0,3.1,9.3,0,6.2,6.2,0,6.2,9.3,0,9.3,6.2,3.1,6.2,3.1,0,9.3,6.2,9.3,6.2,0 },
-	    { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6.2,0,0,0,0,0,6.2,0,0,0,0,0,0,6.2 },
-		{ 0,0,0,0,0,0,4.9,4.9,0,0,0,9.8,4.9,0,4.9,0,0,4.9,9.8,0,0,0,4.9,4.9,0,9.8,0,0,4.9,9.8,9.8,0,4.9,9.8,4.9,0 },
-		{ 0,5.5,5.5,0,5.5,5.5,5.5,5.5,5.5,0,11,5.5,0,5.5,5.5,11,5.5,5.5,0,5.5,5.5,5.5,11,5.5,0,11,0,11,5.5,5.5,0,11,11,0,5.5,5.5 },
-	};
-
-	int num_products = kg_demand_mode.size();
-
-	// 6-month kg inventoy safety levels
-	std::vector<std::vector<double>> kg_inventory_target = {
-		{ 6.2,6.2,9.3,9.3,12.4,12.4,15.5,21.7,21.7,24.8,21.7,24.8,27.9,21.7,24.8,24.8,24.8,27.9,27.9,27.9,31.0,31.0,34.1,34.1,27.9,27.9,27.9,27.9,34.1,34.1,31.0,31.0,21.7,15.5,6.2,0.0 },
-		{ 0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2 },
-		{ 0.0,4.9,9.8,9.8,9.8,9.8,19.6,19.6,14.7,19.6,19.6,19.6,14.7,19.6,19.6,14.7,14.7,19.6,19.6,9.8,19.6,19.6,19.6,19.6,24.5,34.3,24.5,29.4,39.2,39.2,29.4,19.6,19.6,14.7,4.9,0.0 },
-		{ 22.0,27.5,27.5,27.5,27.5,33.0,33.0,27.5,27.5,27.5,38.5,33.0,33.0,33.0,33.0,33.0,27.5,33.0,33.0,33.0,38.5,33.0,38.5,33.0,33.0,33.0,33.0,44.0,33.0,33.0,33.0,33.0,22.0,11.0,11.0,5.5 },
-	};
-
-	std::vector<int> days_per_period = std::vector<int>{ 
-		31,31,28,31,30,31,30,31,31,30,31,30,31,31,28,31,30,31,30,31,31,30,31,30,31,31,28,31,30,31,30,31,31,30,31,30
-	};
-
-	std::vector<double> kg_yield_per_batch_min = { 3.1, 6.2, 4.9, 5.5 };
-	std::vector<double> kg_yield_per_batch_mode = { 3.1, 6.2, 4.9, 5.5 };
-	std::vector<double> kg_yield_per_batch_max = { 3.1, 6.2, 4.9, 5.5 };
-
-	std::vector<double> kg_storage_limits = { 250, 250, 250, 250 }; // set high to ignore
-	std::vector<double> kg_opening_stock = { 18.6, 0, 19.6, 32.0 };
-
-	std::vector<double> inventory_penalty_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> backlog_penalty_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> production_cost_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> storage_cost_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> waste_cost_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> sell_price_per_kg = { 1, 1, 1, 1 };
-
-	std::vector<int> inoculation_days = { 20, 15, 20, 26 };
-	std::vector<int> seed_days = { 11, 7, 11, 9 };
-	std::vector<int> production_days = { 14, 14, 14, 14 };
-	std::vector<int> usp_days = { 45, 36, 45, 49 }; //
-	std::vector<int> dsp_days = { 7, 11, 7, 7 };
-	std::vector<int> shelf_life_days = { 730, 730, 730, 730 }; // set high to ignore
-	std::vector<int> approval_days = { 90, 90, 90, 90 };
-	std::vector<int> min_batches_per_campaign = { 2, 2, 2, 3 };
-	std::vector<int> max_batches_per_campaign = { 50, 50, 50, 30 };
-	std::vector<int> batches_multiples_of_per_campaign = { 1, 1, 1, 3 };
-	std::vector<std::vector<int>> changeover_days = {
-		{ 0,  10, 16, 20 },
-		{ 16,  0, 16, 20 },
-		{ 16, 10,  0, 20 },
-		{ 18, 10, 18,  0 }
-	};
-
-	stochastic::SingleSiteSimpleInputData input_data(
-		mc_seed,
-		num_mc_sims,
-
-		objectives,
-		days_per_period,
-
-		kg_demand_min,
-		kg_demand_mode,
-		kg_demand_max,
-
-		kg_yield_per_batch_min,
-		kg_yield_per_batch_mode,
-		kg_yield_per_batch_max,
-
-		kg_opening_stock,
-		kg_storage_limits,
-
-		inventory_penalty_per_kg,
-		backlog_penalty_per_kg,
-		production_cost_per_kg,
-		storage_cost_per_kg,
-		waste_cost_per_kg,
-		sell_price_per_kg,		
-
-		inoculation_days,
-		seed_days,
-		production_days,
-		usp_days,
-		dsp_days,
-		approval_days,
-		shelf_life_days,
-		min_batches_per_campaign,
-		max_batches_per_campaign,
-		batches_multiples_of_per_campaign,
-		changeover_days,
-
-		&kg_inventory_target,
-		&constraints
-	);
-
-	stochastic::SingleSiteSimpleModel stochastic_fitness(input_data);
-	
-	algorithms::SingleObjectiveGA<types::SingleObjectiveChromosome<types::SingleSiteSimpleGene>, stochastic::SingleSiteSimpleModel> simple_ga(
-		stochastic_fitness,
-		seed,
-		num_threads
-	);
-
-	std::vector<types::SingleObjectiveChromosome<types::SingleSiteSimpleGene>> solutions;
-
-	double mean_time = 0.0;
-
-	for (int run = 0; run < num_runs; ++run) {
-
-		auto start = std::chrono::steady_clock::now();
-
-		simple_ga.Init(
-			popsize,
-
-			//Individual Params + GeneParams
-			starting_length,
-			p_xo,
-			p_gene_swap,
-
-			//GeneParams 
-			num_products,
-			p_product_mut,
-			p_plus_batch_mut,
-			p_minus_batch_mut
-		);
+		if (seeds.empty()) {
+			ga.Init(popsize, params...);
+		}
+		else {
+			ga.Init(popsize, seeds, params...);
+		}
 
-		for (int gen = 0; gen < num_gens; ++gen) {
-			simple_ga.Update();
-		}			
+		timings.init += Seconds(phase);
+		timings.num_evaluations += popsize;
 
-		auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
-		mean_time += elapsed_time;
+		phase = Clock::now();
 
-		solutions.push_back(simple_ga.Top());
-	}
+		std::vector<Chromosome> front;
+		int gen = 0;
 
-	if (solutions.size()) {
-		auto solution = simple_ga.Top(solutions);
-		types::SingleSiteSimpleSchedule schedule;;
-		stochastic_fitness.CreateSchedule(solution, schedule);
+		for (; gen < num_gens && !timings.out_of_time; ++gen) {
+			ga.Update();
+			timings.num_evaluations += popsize;
 
-		std::cout << "\n######################## After " << num_runs << " num_runs, mean elapsed time: " << mean_time / num_runs << " ms ########################\n" << std::endl;
+			// TopFront of NSGAII moves the front out, i.e. it is taken only once per generation
+			if (history) {
+				front = Front(ga);
+				history->Write(run, gen, front);
+			}
 
-		printf(
-			"Top Solution:\nTotal kg throughput: %.2f (%.2f)\nTotal kg inventory deficit: %.2f\nTotal kg backlog: %.2f\nTotal kg waste: %.2f\n\n",
-			solution.objective, schedule.objectives[stochastic::TOTAL_KG_THROUGHPUT_MEAN],
-			schedule.objectives[stochastic::TOTAL_KG_INVENTORY_DEFICIT_MEAN],
-			schedule.objectives[stochastic::TOTAL_KG_BACKLOG_MEAN],
-			schedule.objectives[stochastic::TOTAL_KG_WASTE_MEAN]
-		);
-	}
-}
+			timings.out_of_time = time_limit > 0.0 && Seconds(start) >= time_limit;
+		}
 
-void Stoch_SingleSiteSimple_MultiObjective_Test()
-{
-	int mc_seed = 7;
-	int num_mc_sims = 100;
-
-	seed = 7;
-	num_threads = -1;
-
-	num_runs = 10;
-	num_gens = 100;
-
-	p_xo = 0.108198;
-	p_product_mut = 0.041373;
-	p_plus_batch_mut = 0.608130;
-	p_minus_batch_mut = 0.765819;
-	p_gene_swap = 0.471346;
-
-	std::unordered_map<stochastic::OBJECTIVES, int> objectives;
-	objectives.emplace(stochastic::TOTAL_KG_INVENTORY_DEFICIT_MEAN, -1);
-	objectives.emplace(stochastic::TOTAL_KG_THROUGHPUT_MEAN, 1);
-
-	std::unordered_map<stochastic::OBJECTIVES, std::pair<int, double>> constraints;
-	constraints.emplace(stochastic::TOTAL_KG_BACKLOG_MEAN, std::make_pair(-1, 0));
-	constraints.emplace(stochastic::TOTAL_KG_WASTE_MEAN, std::make_pair(-1, 0));
-
-	// Kg demand
-	std::vector<std::vector<double>> kg_demand_min = {
-		{ 0,0,3.1,0,0,3.1,0,3.1,3.1,3.1,0,6.2,6.2,3.1,6.2,0,3.1,9.3,0,6.2,6.2,0,6.2,9.3,0,9.3,6.2,3.1,6.2,3.1,0,9.3,6.2,9.3,6.2,0 },
-	    { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6.2,0,0,0,0,0,6.2,0,0,0,0,0,0,6.2 },
-		{ 0,0,0,0,0,0,4.9,4.9,0,0,0,9.8,4.9,0,4.9,0,0,4.9,9.8,0,0,0,4.9,4.9,0,9.8,0,0,4.9,9.8,9.8,0,4.9,9.8,4.9,0 },
-		{ 0,5.5,5.5,0,5.5,5.5,5.5,5.5,5.5,0,11,5.5,0,5.5,5.5,11,5.5,5.5,0,5.5,5.5,5.5,11,5.5,0,11,0,11,5.5,5.5,0,11,11,0,5.5,5.5 },
-	};
-
-	std::vector<std::vector<double>> kg_demand_mode = {
-		{ 0,0,3.1,0,0,3.1,0,3.1,3.1,3.1,0,6.2,6.2,3.1,6.2,0,3.1,9.3,0,6.2,6.2,0,6.2,9.3,0,9.3,6.2,3.1,6.2,3.1,0,9.3,6.2,9.3,6.2,0 },
-	    { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6.2,0,0,0,0,0,6.2,0,0,0,0,0,0,6.2 },
-		{ 0,0,0,0,0,0,4.9,4.9,0,0,0,9.8,4.9,0,4.9,0,0,4.9,9.8,0,0,0,4.9,4.9,0,9.8,0,0,4.9,9.8,9.8,0,4.9,9.8,4.9,0 },
-		{ 0,5.5,5.5,0,5.5,5.5,5.5,5.5,5.5,0,11,5.5,0,5.5,5.5,11,5.5,5.5,0,5.5,5.5,5.5,11,5.5,0,11,0,11,5.5,5.5,0,11,11,0,5.5,5.5 },
-	};
-
-	std::vector<std::vector<double>> kg_demand_max = {
-		{ 0,0,3.1,0,0,3.1,0,3.1,3.1,3.1,0,6.2,6.2,3.1,6.2,0,3.1,9.3,0,6.2,6.2,0,6.2,9.3,0,9.3,6.2,3.1,6.2,3.1,0,9.3,6.2,9.3,6.2,0 },
-	    { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6.2,0,0,0,0,0,6.2,0,0,0,0,0,0,6.2 },
-		{ 0,0,0,0,0,0,4.9,4.9,0,0,0,9.8,4.9,0,4.9,0,0,4.9,9.8,0,0,0,4.9,4.9,0,9.8,0,0,4.9,9.8,9.8,0,4.9,9.8,4.9,0 },
-		{ 0,5.5,5.5,0,5.5,5.5,5.5,5.5,5.5,0,11,5.5,0,5.5,5.5,11,5.5,5.5,0,5.5,5.5,5.5,11,5.5,0,11,0,11,5.5,5.5,0,11,11,0,5.5,5.5 },
-	};
-
-	int num_products = kg_demand_mode.size();
-
-	// 6-month kg inventoy safety levels
-	std::vector<std::vector<double>> kg_inventory_target = {
-		{ 6.2,6.2,9.3,9.3,12.4,12.4,15.5,21.7,21.7,24.8,21.7,24.8,27.9,21.7,24.8,24.8,24.8,27.9,27.9,27.9,31.0,31.0,34.1,34.1,27.9,27.9,27.9,27.9,34.1,34.1,31.0,31.0,21.7,15.5,6.2,0.0 },
-		{ 0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,0.0,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2,6.2 },
-		{ 0.0,4.9,9.8,9.8,9.8,9.8,19.6,19.6,14.7,19.6,19.6,19.6,14.7,19.6,19.6,14.7,14.7,19.6,19.6,9.8,19.6,19.6,19.6,19.6,24.5,34.3,24.5,29.4,39.2,39.2,29.4,19.6,19.6,14.7,4.9,0.0 },
-		{ 22.0,27.5,27.5,27.5,27.5,33.0,33.0,27.5,27.5,27.5,38.5,33.0,33.0,33.0,33.0,33.0,27.5,33.0,33.0,33.0,38.5,33.0,38.5,33.0,33.0,33.0,33.0,44.0,33.0,33.0,33.0,33.0,22.0,11.0,11.0,5.5 },
-	};
-
-	std::vector<int> days_per_period = std::vector<int>{ 
-		31,31,28,31,30,31,30,31,31,30,31,30,31,31,28,31,30,31,30,31,31,30,31,30,31,31,28,31,30,31,30,31,31,30,31,30
-	};
-
-	std::vector<double> kg_yield_per_batch_min = { 3.1, 6.2, 4.9, 5.5 };
-	std::vector<double> kg_yield_per_batch_mode = { 3.1, 6.2, 4.9, 5.5 };
-	std::vector<double> kg_yield_per_batch_max = { 3.1, 6.2, 4.9, 5.5 };
-
-	std::vector<double> kg_storage_limits = { 250, 250, 250, 250 }; // set high to ignore
-	std::vector<double> kg_opening_stock = { 18.6, 0, 19.6, 32.0 };
-
-	std::vector<double> inventory_penalty_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> backlog_penalty_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> production_cost_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> storage_cost_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> waste_cost_per_kg = { 1, 1, 1, 1 };
-	std::vector<double> sell_price_per_kg = { 1, 1, 1, 1 };
-
-	std::vector<int> inoculation_days = { 20, 15, 20, 26 };
-	std::vector<int> seed_days = { 11, 7, 11, 9 };
-	std::vector<int> production_days = { 14, 14, 14, 14 };
-	std::vector<int> usp_days = { 45, 36, 45, 49 }; //
-	std::vector<int> dsp_days = { 7, 11, 7, 7 };
-	std::vector<int> shelf_life_days = { 730, 730, 730, 730 }; // set high to ignore
-	std::vector<int> approval_days = { 90, 90, 90, 90 };
-	std::vector<int> min_batches_per_campaign = { 2, 2, 2, 3 };
-	std::vector<int> max_batches_per_campaign = { 50, 50, 50, 30 };
-	std::vector<int> batches_multiples_of_per_campaign = { 1, 1, 1, 3 };
-	std::vector<std::vector<int>> changeover_days = {
-		{ 0,  10, 16, 20 },
-		{ 16,  0, 16, 20 },
-		{ 16, 10,  0, 20 },
-		{ 18, 10, 18,  0 }
-	};
-
-	stochastic::SingleSiteSimpleInputData input_data(
-		mc_seed,
-		num_mc_sims,
-
-		objectives,
-		days_per_period,
-
-		kg_demand_min,
-		kg_demand_mode,
-		kg_demand_max,
-
-		kg_yield_per_batch_min,
-		kg_yield_per_batch_mode,
-		kg_yield_per_batch_max,
-
-		kg_opening_stock,
-		kg_storage_limits,
-
-		inventory_penalty_per_kg,
-		backlog_penalty_per_kg,
-		production_cost_per_kg,
-		storage_cost_per_kg,
-		waste_cost_per_kg,
-		sell_price_per_kg,		
-
-		inoculation_days,
-		seed_days,
-		production_days,
-		usp_days,
-		dsp_days,
-		approval_days,
-		shelf_life_days,
-		min_batches_per_campaign,
-		max_batches_per_campaign,
-		batches_multiples_of_per_campaign,
-		changeover_days,
-
-		&kg_inventory_target,
-		&constraints
-	);
-
-	stochastic::SingleSiteSimpleModel stochastic_fitness(input_data);
-	
-	algorithms::NSGAII<types::NSGAChromosome<types::SingleSiteSimpleGene>, stochastic::SingleSiteSimpleModel> nsgaii(
-		stochastic_fitness,
-		seed,
-		num_threads
-	);
-
-	std::vector<types::NSGAChromosome<types::SingleSiteSimpleGene>> solutions;
-
-	double mean_time = 0.0;
-
-	for (int run = 0; run < num_runs; ++run) {
-
-		auto start = std::chrono::steady_clock::now();
-
-		nsgaii.Init(
-			popsize,
-
-			//Individual Params + GeneParams
-			starting_length,
-			p_xo,
-			p_gene_swap,
-
-			//GeneParams 
-			num_products,
-			p_product_mut,
-			p_plus_batch_mut,
-			p_minus_batch_mut
-		);
+		if (!history || !gen) {
+			front = Front(ga);
+		}
 
-		for (int gen = 0; gen < num_gens; ++gen) {
-			nsgaii.Update();
-		}			
+		timings.evolve += Seconds(phase);
+		++timings.num_runs;
 
-		auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
-		mean_time += elapsed_time;
+		solutions.insert(solutions.end(), front.begin(), front.end());
 
-		auto top_front = nsgaii.TopFront();
-		solutions.insert(solutions.end(), top_front.begin(), top_front.end());
+		if (verbose) {
+			fprintf(stderr, "Run %d/%d, %d generations, %d solutions\n", run + 1, num_runs, gen, (int)front.size());
+		}
 	}
 
-	if (solutions.size()) {
-		solutions = nsgaii.TopFront(solutions);
-		types::SingleSiteSimpleSchedule schedule_x, schedule_y;
-		stochastic_fitness.CreateSchedule(solutions[0], schedule_x);
-		stochastic_fitness.CreateSchedule(solutions.back(), schedule_y);
+	if (history) {
+		history->Close();
+	}
 
-		std::cout << "\n######################## After " << num_runs << " num_runs, no. best solutions: " << solutions.size() << ", mean elapsed time: " << mean_time / num_runs << " ms ########################\n" << std::endl;
+	auto phase = Clock::now();
 
-		printf(
-			"Solution X:\nTotal kg throughput: %.2f (%.2f)\nTotal kg inventory deficit: %.2f (%.2f)\nTotal kg backlog: %.2f\nTotal kg waste: %.2f\n\n",
-			solutions[0].objectives[0], schedule_x.objectives[stochastic::TOTAL_KG_THROUGHPUT_MEAN],
-			solutions[0].objectives[1], schedule_x.objectives[stochastic::TOTAL_KG_INVENTORY_DEFICIT_MEAN],
-			schedule_x.objectives[stochastic::TOTAL_KG_BACKLOG_MEAN],
-			schedule_x.objectives[stochastic::TOTAL_KG_WASTE_MEAN]
-		);
+	solutions = Best(ga, solutions);
 
-		printf(
-			"Solution Y:\nTotal kg throughput: %.2f (%.2f)\nTotal kg inventory deficit: %.2f (%.2f)\nTotal kg backlog: %.2f\nTotal kg waste: %.2f\n\n",
-			solutions.back().objectives[0], schedule_y.objectives[stochastic::TOTAL_KG_THROUGHPUT_MEAN],
-			solutions.back().objectives[1], schedule_y.objectives[stochastic::TOTAL_KG_INVENTORY_DEFICIT_MEAN],
-			schedule_y.objectives[stochastic::TOTAL_KG_BACKLOG_MEAN],
-			schedule_y.objectives[stochastic::TOTAL_KG_WASTE_MEAN]
-		);
+	if (format == "csv") {
+		WriteCSV<Schedule>(output_dir, model, instance, solutions);
 	}
+	else {
+		io::HistoryWriter<Chromosome> writer(output_dir + "/front.bin", objective_names);
+		writer.Write(0, 0, solutions);
+	}
+
+	timings.output += Seconds(phase);
+
+	printf("%d solutions written to '%s'\n", (int)solutions.size(), output_dir.c_str());
 }
 
-int main()
+template<class Gene, class Model, class Schedule, class Instance, class... ChromosomeParams>
+void Solve(const io::Config &config, const Instance &instance, Timings &timings, ChromosomeParams... params)
 {
-	// printf("\nDeterministic SingleSiteMultiSuite Example 1 Single-Objective GA test...\n\n");
-	// Det_SingleSiteMultiSuite_Example1_Test();
+	if (instance.input_data.objectives.size() == 1) {
+		Solve<algorithms::SingleObjectiveGA, types::SingleObjectiveChromosome<Gene>, Model, Schedule>(config, instance, timings, params...);
+	}
+	else {
+		// Chromosomes with a fixed number of objectives for the common cases
+		switch (instance.input_data.objectives.size()) {
+		case 2:
+			Solve<algorithms::NSGAII, types::FixedNSGAChromosome<Gene, 2>, Model, Schedule>(config, instance, timings, params...);
+			break;
+		case 3:
+			Solve<algorithms::NSGAII, types::FixedNSGAChromosome<Gene, 3>, Model, Schedule>(config, instance, timings, params...);
+			break;
+		case 4:
+			Solve<algorithms::NSGAII, types::FixedNSGAChromosome<Gene, 4>, Model, Schedule>(config, instance, timings, params...);
+			break;
+		default:
+			Solve<algorithms::NSGAII, types::NSGAChromosome<Gene>, Model, Schedule>(config, instance, timings, params...);
+		}
+	}
+}
 
-	printf("\nDeterministic SingleSiteMultiSuite Example 2 Single-Objective GA test...\n\n");
-	Det_SingleSiteMultiSuite_Example2_Test();
+int main(int argc, char *argv[])
+{
+	if (argc < 2 || std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help") {
+		printf("Usage: %s config [key=value ...]\n\nSettings:\n", argv[0]);
+		for (const auto &setting : SETTINGS) {
+			printf("  %s\n", setting.c_str());
+		}
+		return argc < 2;
+	}
+
+	try {
+		io::Config config(argv[1]);
 
-	// printf("\nDeterministic SingleSiteSimple Single-Objective GA test\n\n");
-	// Det_SingleSiteSimple_SingleObjective_Test();	
+		for (int i = 2; i < argc; ++i) {
+			if (!config.Set(argv[i])) {
+				throw std::runtime_error(std::string("Expected 'key=value', found '") + argv[i] + "'.");
+			}
+		}
 
-	// printf("\nDeterministic SingleSiteSimple Multi-Objective GA test\n\n");
-	// Det_SingleSiteSimple_MultiObjective_Test();	
+		for (const auto &key : config.Keys()) {
+			if (std::find(SETTINGS.begin(), SETTINGS.end(), key) == SETTINGS.end()) {
+				throw std::runtime_error("Unknown setting '" + key + "'.");
+			}
+		}
 
-	// printf("\nStochastic SingleSiteSimple Single-Objective GA test\n\n");
-	// Stoch_SingleSiteSimple_SingleObjective_Test();
+		std::string format = config.String("format", "csv");
 
-	// printf("\nStochastic SingleSiteSimple Multi-Objective GA test\n\n");
-	// Stoch_SingleSiteSimple_MultiObjective_Test();
+		if (format != "csv" && format != "binary") {
+			throw std::runtime_error("'format' must be 'csv' or 'binary', is '" + format + "'.");
+		}
 
-	printf("\n");
+		auto objectives = config.Objectives("objectives");
+		auto constraints = config.Constraints("constraints");
+
+		int starting_length = config.Int("starting_length", 1);
+		double p_xo = config.Double("p_xo", 0.131266);
+		double p_gene_swap = config.Double("p_gene_swap", 0.131266);
+		double p_product_mut = config.Double("p_product_mut", 0.131266);
+		double p_plus_batch_mut = config.Double("p_plus_batch_mut", 0.131266);
+		double p_minus_batch_mut = config.Double("p_minus_batch_mut", 0.131266);
+
+		Timings timings;
+		auto start = Clock::now();
+		std::string model = config.String("model", "");
+
+		if (model == "simple") {
+			auto instance = io::LoadSingleSiteSimple(
+				config.String("data_dir", "."),
+				config.String("start_date", ""),
+				objectives,
+				&constraints
+			);
 
-	#if defined(_WIN32) || defined(_WIN64)
-		system("pause");
-	#endif
+			timings.load = Seconds(start);
+
+			Solve<types::SingleSiteSimpleGene, deterministic::SingleSiteSimpleModel, types::SingleSiteSimpleSchedule>(
+				config,
+				instance,
+				timings,
+				starting_length,
+				p_xo,
+				p_gene_swap,
+				instance.input_data.num_products,
+				p_product_mut,
+				p_plus_batch_mut,
+				p_minus_batch_mut
+			);
+		}
+		else if (model == "multi_suite") {
+			auto instance = io::LoadSingleSiteMultiSuite(
+				config.String("data_dir", "."),
+				config.String("start_date", ""),
+				objectives,
+				config.Int("num_usp_suites", 1),
+				config.Int("num_dsp_suites", 1),
+				&constraints
+			);
+
+			timings.load = Seconds(start);
+
+			Solve<types::SingleSiteMultiSuiteGene, deterministic::SingleSiteMultiSuiteModel, types::SingleSiteMultiSuiteSchedule>(
+				config,
+				instance,
+				timings,
+				starting_length,
+				p_xo,
+				p_gene_swap,
+				instance.input_data.num_products,
+				instance.input_data.num_usp_suites,
+				p_product_mut,
+				config.Double("p_usp_suite_mut", 0.131266),
+				p_plus_batch_mut,
+				p_minus_batch_mut
+			);
+		}
+		else {
+			throw std::runtime_error("'model' must be 'simple' or 'multi_suite', is '" + model + "'.");
+		}
+
+		double total = Seconds(start);
+
+		printf(
+			"Load %.3f s, init %.3f s, evolve %.3f s, output %.3f s, total %.3f s\n",
+			timings.load, timings.init, timings.evolve, timings.output, total
+		);
+
+		printf(
+			"%d runs, %lld evaluations, %.0f evaluations/s%s\n",
+			timings.num_runs,
+			timings.num_evaluations,
+			timings.num_evaluations / std::max(timings.init + timings.evolve, 1e-9),
+			timings.out_of_time ? ", stopped by 'time_limit'" : ""
+		);
+	}
+	catch (const std::exception &e) {
+		fprintf(stderr, "Error: %s\n", e.what());
+		return 1;
+	}
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,120 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include <string>
+#include <stdexcept>
+
+#if defined(_WIN32)
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+
+namespace io
+{
+	/*
+		Read-only memory mapping of a whole file, i.e. only the pages which are
+		read are loaded. Empty files are not mapped and have no data.
+	*/
+	class MappedFile
+	{
+		const char *data;
+		size_t size;
+
+#if defined(_WIN32)
+		HANDLE file_handle, mapping_handle;
+#endif
+
+		void Unmap()
+		{
+#if defined(_WIN32)
+			if (data) UnmapViewOfFile(data);
+			if (mapping_handle) CloseHandle(mapping_handle);
+			if (file_handle != INVALID_HANDLE_VALUE) CloseHandle(file_handle);
+			mapping_handle = NULL;
+			file_handle = INVALID_HANDLE_VALUE;
+#else
+			if (data) munmap((void*)data, size);
+#endif
+			data = nullptr;
+			size = 0;
+		}
+
+	public:
+		// Throws std::runtime_error if the file cannot be opened or mapped.
+		explicit MappedFile(const std::string &path) : data(nullptr), size(0)
+		{
+#if defined(_WIN32)
+			file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+			mapping_handle = NULL;
+
+			if (file_handle == INVALID_HANDLE_VALUE) {
+				throw std::runtime_error("Cannot open '" + path + "'");
+			}
+
+			LARGE_INTEGER file_size;
+			GetFileSizeEx(file_handle, &file_size);
+			size = file_size.QuadPart;
+
+			if (size) {
+				mapping_handle = CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+				data = mapping_handle ? (const char*)MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+			}
+#else
+			int fd = open(path.c_str(), O_RDONLY);
+
+			if (fd == -1) {
+				throw std::runtime_error("Cannot open '" + path + "'");
+			}
+
+			struct stat st;
+			fstat(fd, &st);
+			size = st.st_size;
+
+			if (size) {
+				void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+				data = (mapping == MAP_FAILED) ? nullptr : (const char*)mapping;
+			}
+
+			close(fd);
+#endif
+
+			if (size && !data) {
+				Unmap();
+				throw std::runtime_error("Cannot map '" + path + "'");
+			}
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		~MappedFile()
+		{
+			Unmap();
+		}
+
+		inline const char* Data() const
+		{
+			return data;
+		}
+
+		inline size_t Size() const
+		{
+			return size;
+		}
+	};
+}
+
+#endif
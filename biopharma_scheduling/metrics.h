@@ -0,0 +1,377 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __METRICS_H__
+#define __METRICS_H__
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+
+
+/*
+	Quality indicators of non-dominated fronts. All objectives are minimised, i.e.
+	the same as NSGAChromosome::objectives. The fronts can be passed either as
+	vectors of points or directly as vectors of chromosomes.
+*/
+namespace metrics
+{
+	typedef std::vector<double> Point;
+	typedef std::vector<Point> Points;
+
+	inline const Point& Objectives(const Point &point)
+	{
+		return point;
+	}
+
+	template<class Chromosome>
+	inline const Point& Objectives(const Chromosome &chromosome)
+	{
+		return chromosome.objectives;
+	}
+
+	/*
+		Returns true if p weakly dominates q in the first 'num_objectives' objectives.
+	*/
+	inline bool WeaklyDominates(const Point &p, const Point &q, int num_objectives)
+	{
+		for (int m = 0; m < num_objectives; ++m) {
+			if (p[m] > q[m]) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+		Removes the weakly dominated points and duplicates. After the lexicographic
+		sort a point can only be dominated by one of the points preceding it.
+	*/
+	inline Points NonDominated(Points points, int num_objectives)
+	{
+		std::sort(points.begin(), points.end());
+		Points front;
+
+		for (auto &p : points) {
+			bool dominated = std::any_of(
+				front.begin(),
+				front.end(),
+				[&](const Point &q) { return WeaklyDominates(q, p, num_objectives); }
+			);
+
+			if (!dominated) {
+				front.push_back(std::move(p));
+			}
+		}
+
+		return front;
+	}
+
+	/*
+		Volume of the box between the point and the reference point.
+	*/
+	inline double InclusiveHypervolume(const Point &point, const Point &ref, int num_objectives)
+	{
+		double volume = 1.0;
+
+		for (int m = 0; m < num_objectives; ++m) {
+			volume *= ref[m] - point[m];
+		}
+
+		return volume;
+	}
+
+	/*
+		O(N log N) sweep over the points sorted by the first objective.
+	*/
+	inline double Hypervolume2D(Points points, const Point &ref)
+	{
+		std::sort(
+			points.begin(),
+			points.end(),
+			[](const Point &p, const Point &q) { return p[0] < q[0] || (p[0] == q[0] && p[1] < q[1]); }
+		);
+
+		double volume = 0.0, y = ref[1];
+
+		for (const auto &p : points) {
+			if (p[1] < y) {
+				volume += (ref[0] - p[0]) * (y - p[1]);
+				y = p[1];
+			}
+		}
+
+		return volume;
+	}
+
+	/*
+		Exact hypervolume of the points dominating the reference point in the
+		first 'num_objectives' objectives.
+
+		While, L., Bradstreet, L. and Barone, L., 2012. A fast way of calculating exact hypervolumes. IEEE Transactions on Evolutionary Computation, 16(1), pp.86-95.
+		http://ieeexplore.ieee.org/document/5766730/
+
+		The points are processed in the descending order of the last objective, so
+		all the points of a limit set share the last objective with the point it
+		is computed for and the exclusive hypervolumes are computed one dimension
+		lower.
+	*/
+	inline double WFG(Points points, const Point &ref, int num_objectives)
+	{
+		if (points.empty()) {
+			return 0.0;
+		}
+
+		if (num_objectives == 1) {
+			double min = points[0][0];
+
+			for (const auto &p : points) {
+				min = std::min(min, p[0]);
+			}
+
+			return ref[0] - min;
+		}
+
+		if (num_objectives == 2) {
+			return Hypervolume2D(std::move(points), ref);
+		}
+
+		if (points.size() == 1) {
+			return InclusiveHypervolume(points[0], ref, num_objectives);
+		}
+
+		int last = num_objectives - 1;
+
+		std::sort(
+			points.begin(),
+			points.end(),
+			[last](const Point &p, const Point &q) { return p[last] > q[last]; }
+		);
+
+		double volume = 0.0;
+		Points limit_set;
+
+		for (int k = 0; k < points.size(); ++k) {
+			limit_set.resize(0);
+
+			for (int j = k + 1; j < points.size(); ++j) {
+				Point limit(last);
+
+				for (int m = 0; m < last; ++m) {
+					limit[m] = std::max(points[k][m], points[j][m]);
+				}
+
+				limit_set.push_back(std::move(limit));
+			}
+
+			volume += (ref[last] - points[k][last]) * (
+				InclusiveHypervolume(points[k], ref, last) -
+				WFG(NonDominated(std::move(limit_set), last), ref, last)
+			);
+		}
+
+		return volume;
+	}
+
+	/*
+		Exact hypervolume of the front with respect to the reference point. Points
+		which do not strictly dominate the reference point do not contribute.
+	*/
+	template<class Front>
+	double Hypervolume(const Front &front, const Point &ref)
+	{
+		int num_objectives = ref.size();
+		Points points;
+		points.reserve(front.size());
+
+		for (const auto &i : front) {
+			const Point &p = Objectives(i);
+			bool contributes = true;
+
+			for (int m = 0; m < num_objectives; ++m) {
+				if (p[m] >= ref[m]) {
+					contributes = false;
+					break;
+				}
+			}
+
+			if (contributes) {
+				points.push_back(Point(p.begin(), p.begin() + num_objectives));
+			}
+		}
+
+		if (num_objectives > 2) {
+			points = NonDominated(std::move(points), num_objectives);
+		}
+
+		return WFG(std::move(points), ref, num_objectives);
+	}
+
+	/*
+		Inverted generational distance, i.e. the mean Euclidean distance from each
+		point of the reference front to its nearest point of the front. If 'plus'
+		is true, only the objectives in which the front is worse than the reference
+		point count towards the distance (IGD+).
+
+		Ishibuchi, H., Masuda, H., Tanigaki, Y. and Nojima, Y., 2015. Modified distance calculation in generational distance and inverted generational distance. EMO 2015, pp.110-125.
+	*/
+	template<class Front, class ReferenceFront>
+	double IGD(const Front &front, const ReferenceFront &reference_front, bool plus = false)
+	{
+		if (front.empty() || reference_front.empty()) {
+			return std::numeric_limits<double>::infinity();
+		}
+
+		double total = 0.0;
+
+		for (const auto &r : reference_front) {
+			const Point &z = Objectives(r);
+			double min = std::numeric_limits<double>::infinity();
+
+			for (const auto &i : front) {
+				const Point &a = Objectives(i);
+				double d = 0.0;
+
+				for (int m = 0; m < z.size(); ++m) {
+					double diff = plus ? std::max(a[m] - z[m], 0.0) : a[m] - z[m];
+					d += diff * diff;
+				}
+
+				min = std::min(min, d);
+			}
+
+			total += std::sqrt(min);
+		}
+
+		return total / reference_front.size();
+	}
+
+	template<class Front, class ReferenceFront>
+	double IGDPlus(const Front &front, const ReferenceFront &reference_front)
+	{
+		return IGD(front, reference_front, true);
+	}
+
+	/*
+		Additive epsilon indicator, i.e. the smallest value which has to be subtracted
+		from all the objectives of the front so that it weakly dominates the reference
+		front.
+
+		Zitzler, E., Thiele, L., Laumanns, M., Fonseca, C.M. and Da Fonseca, V.G., 2003. Performance assessment of multiobjective optimizers: an analysis and review. IEEE Transactions on evolutionary computation, 7(2), pp.117-132.
+	*/
+	template<class Front, class ReferenceFront>
+	double Epsilon(const Front &front, const ReferenceFront &reference_front)
+	{
+		if (front.empty()) {
+			return std::numeric_limits<double>::infinity();
+		}
+
+		double epsilon = -std::numeric_limits<double>::infinity();
+
+		for (const auto &r : reference_front) {
+			const Point &z = Objectives(r);
+			double min = std::numeric_limits<double>::infinity();
+
+			for (const auto &i : front) {
+				const Point &a = Objectives(i);
+				double max = -std::numeric_limits<double>::infinity();
+
+				for (int m = 0; m < z.size(); ++m) {
+					max = std::max(max, a[m] - z[m]);
+				}
+
+				min = std::min(min, max);
+			}
+
+			epsilon = std::max(epsilon, min);
+		}
+
+		return epsilon;
+	}
+
+	/*
+		Generalised spread, i.e. the spread of Deb et al. extended to any number
+		of objectives. 0.0 for an ideal distribution, which covers the extreme
+		points of the reference front. If the reference front is empty, the
+		extreme points of the front itself are used.
+
+		Zhou, A., Jin, Y., Zhang, Q., Sendhoff, B. and Tsang, E., 2006. Combining model-based and genetics-based offspring generation for multi-objective optimization using a convergence acceleration operator. IEEE Congress on Evolutionary Computation, pp.2876-2883.
+	*/
+	template<class Front, class ReferenceFront>
+	double Spread(const Front &front, const ReferenceFront &reference_front)
+	{
+		if (front.size() < 2) {
+			return 1.0;
+		}
+
+		auto distance = [](const Point &p, const Point &q) {
+			double d = 0.0;
+
+			for (int m = 0; m < p.size(); ++m) {
+				d += (p[m] - q[m]) * (p[m] - q[m]);
+			}
+
+			return std::sqrt(d);
+		};
+
+		auto nearest = [&](const Point &p, int skip) {
+			double min = std::numeric_limits<double>::infinity();
+
+			for (int i = 0; i < front.size(); ++i) {
+				if (i != skip) {
+					min = std::min(min, distance(p, Objectives(front[i])));
+				}
+			}
+
+			return min;
+		};
+
+		int num_objectives = Objectives(front[0]).size();
+		double extremes = 0.0;
+
+		if (!reference_front.empty()) {
+			for (int m = 0; m < num_objectives; ++m) {
+				auto extreme = std::min_element(
+					reference_front.begin(),
+					reference_front.end(),
+					[m](const auto &r1, const auto &r2) { return Objectives(r1)[m] < Objectives(r2)[m]; }
+				);
+
+				extremes += nearest(Objectives(*extreme), -1);
+			}
+		}
+
+		std::vector<double> d(front.size());
+
+		for (int i = 0; i < front.size(); ++i) {
+			d[i] = nearest(Objectives(front[i]), i);
+		}
+
+		double mean = std::accumulate(d.begin(), d.end(), 0.0) / d.size(), deviation = 0.0;
+
+		for (double di : d) {
+			deviation += std::fabs(di - mean);
+		}
+
+		if (extremes + front.size() * mean == 0.0) {
+			return 0.0;
+		}
+
+		return (extremes + deviation) / (extremes + front.size() * mean);
+	}
+
+	template<class Front>
+	double Spread(const Front &front)
+	{
+		return Spread(front, Points());
+	}
+}
+
+#endif
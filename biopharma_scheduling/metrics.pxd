@@ -0,0 +1,9 @@
+from libcpp cimport bool
+from libcpp.vector cimport vector
+
+
+cdef extern from "metrics.h" namespace "metrics" nogil:
+    double Hypervolume[Front](Front &front, vector[double] &ref)
+    double IGD[Front, ReferenceFront](Front &front, ReferenceFront &reference_front, bool plus)
+    double Epsilon[Front, ReferenceFront](Front &front, ReferenceFront &reference_front)
+    double Spread[Front, ReferenceFront](Front &front, ReferenceFront &reference_front)
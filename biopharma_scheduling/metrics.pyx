@@ -0,0 +1,75 @@
+'''
+    Quality indicators of non-dominated fronts computed by 'metrics.h'. 
+
+    All objectives are minimised, i.e. a front is a list of points with
+    objective values multiplied by their coefficient and -1, the same as
+    'biopharma_scheduling.utils.hypervolume' does.
+'''
+from libcpp.vector cimport vector
+
+
+def hypervolume(front: list, ref_point: list):
+    '''
+        Exact hypervolume of the 'front' with respect to 'ref_point'. Points
+        which do not dominate 'ref_point' do not contribute.
+    '''
+    cdef:
+        vector[vector[double]] points = front
+        vector[double] ref = ref_point
+        double value
+
+    with nogil:
+        value = Hypervolume[vector[vector[double]]](points, ref)
+
+    return value
+
+
+def igd(front: list, reference_front: list, plus: bool=False):
+    '''
+        Inverted generational distance of the 'front' from the 'reference_front', 
+        or IGD+ if 'plus' is True.
+    '''
+    cdef:
+        vector[vector[double]] points = front
+        vector[vector[double]] reference_points = reference_front
+        bint igd_plus = plus
+        double value
+
+    with nogil:
+        value = IGD[vector[vector[double]], vector[vector[double]]](points, reference_points, igd_plus)
+
+    return value
+
+
+def epsilon(front: list, reference_front: list):
+    '''
+        Additive epsilon indicator of the 'front' with respect to the 'reference_front'.
+    '''
+    cdef:
+        vector[vector[double]] points = front
+        vector[vector[double]] reference_points = reference_front
+        double value
+
+    with nogil:
+        value = Epsilon[vector[vector[double]], vector[vector[double]]](points, reference_points)
+
+    return value
+
+
+def spread(front: list, reference_front: list=None):
+    '''
+        Generalised spread of the 'front'. The extreme points are taken from 
+        the 'reference_front' if one is given.
+    '''
+    cdef:
+        vector[vector[double]] points = front
+        vector[vector[double]] reference_points
+        double value
+
+    if reference_front is not None:
+        reference_points = reference_front
+
+    with nogil:
+        value = Spread[vector[vector[double]], vector[vector[double]]](points, reference_points)
+
+    return value
@@ -8,25 +8,53 @@
 #ifndef __NSGA_CHROMOSOME_H__
 #define __NSGA_CHROMOSOME_H__
 
+#include <array>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
 #include "base_chromosome.h"
 
 
 namespace types
 {
-	template<class Gene>
-	class NSGAChromosome : public BaseChromosome<Gene>
+	/*
+		'Objectives' is either a std::vector<double> or, if the number of objectives 
+		is known at compile time, a std::array<double, M>, see FixedNSGAChromosome.
+	*/
+	template<class Gene, class GeneContainer = std::vector<Gene>, class Objectives = std::vector<double>>
+	class NSGAChromosome : public BaseChromosome<Gene, GeneContainer>
 	{
 	public:
-		using BaseChromosome<Gene>::BaseChromosome;
+		using BaseChromosome<Gene, GeneContainer>::BaseChromosome;
 
-		std::vector<double> objectives; // All objectives are minimised
-		double constraints; 
+		Objectives objectives; // All objectives are minimised
+		double constraints = 0.0;
 
-		double d; // Crowding distance
-		int rank; // Domination rank
-		int n; // Number of solutions which dominate this solution
-		std::vector<int> S; // Set of solutions (indices) that are dominated by this solution
+		double d = 0.0; // Crowding distance, compared in the tournaments
 	};
+
+	/*
+		NSGAChromosome with M objectives, which are stored inline, so that the 
+		dominance checks of NSGAII are unrolled for M.
+	*/
+	template<class Gene, size_t M, class GeneContainer = std::vector<Gene>>
+	using FixedNSGAChromosome = NSGAChromosome<Gene, GeneContainer, std::array<double, M>>;
+
+	inline void ResizeObjectives(std::vector<double> &objectives, size_t num_objectives)
+	{
+		objectives.resize(num_objectives);
+	}
+
+	template<size_t M>
+	inline void ResizeObjectives(std::array<double, M> & /* objectives */, size_t num_objectives)
+	{
+		if (num_objectives != M) {
+			throw std::invalid_argument(
+				"Expected " + std::to_string(M) + " objectives, found " + std::to_string(num_objectives) + "."
+			);
+		}
+	}
 }
 
 #endif 
@@ -8,12 +8,15 @@
 #ifndef __NSGAII_H__
 #define __NSGAII_H__
 
+#include <vector>
 #include <numeric>
 #include <utility>
 #include <limits>
 #include <algorithm>
 
 #include "utils.h"
+#include "archive.h"
+#include "dominance.h"
 #include "base_ga.h"
 
 
@@ -30,6 +33,9 @@ namespace algorithms
 		using BaseGA<Chromosome, FitnessFunction>::BaseGA;
 		using BaseGA<Chromosome, FitnessFunction>::Select;
 		using BaseGA<Chromosome, FitnessFunction>::Reproduce;
+		using BaseGA<Chromosome, FitnessFunction>::Seed;
+		using BaseGA<Chromosome, FitnessFunction>::Evaluate;
+		using BaseGA<Chromosome, FitnessFunction>::Steady;
 		using BaseGA<Chromosome, FitnessFunction>::fitness_function;
 		using BaseGA<Chromosome, FitnessFunction>::indices;
 		using BaseGA<Chromosome, FitnessFunction>::parents;
@@ -39,6 +45,39 @@ namespace algorithms
 
 		Population top_front;
 
+		NDTreeArchive<Chromosome> archive;
+		bool use_archive = false;
+
+		/*
+			Bookkeeping of NonDominatedSort, kept between the generations so that its
+			arrays are allocated once. 'points' holds the compared objectives and
+			constraints, 'n' the number of solutions which dominate each solution,
+			S[S_begin[p]] to S[S_begin[p + 1] - 1] the solutions dominated by p and
+			'fronts' the indices of the solutions in each front.
+		*/
+		struct RankingState
+		{
+			std::vector<int> n;
+			std::vector<int> S;
+			std::vector<int> S_begin;
+			std::vector<int> S_end;
+			std::vector<std::pair<int, int>> dominations;
+			std::vector<std::vector<int>> fronts;
+			DominancePoints points;
+
+			// Returns the emptied front 'f', keeping the capacity of the previous sorts.
+			std::vector<int>& Front(int f)
+			{
+				if (fronts.size() <= f) {
+					fronts.resize(f + 1);
+				}
+
+				fronts[f].resize(0);
+
+				return fronts[f];
+			}
+		} ranking;
+
 		/*
 			Checks the dominance.
 
@@ -55,28 +94,19 @@ namespace algorithms
 
 			bool p_dominates = false, q_dominates = false; 
 
+			// Branch-free, so that the loop is unrolled for the fixed number of objectives of a FixedNSGAChromosome
 			for (int m = 0; m != p.objectives.size(); ++m) {
-				if (p.objectives[m] < q.objectives[m]) {
-					p_dominates = true;
-				}
-
-				if (p.objectives[m] > q.objectives[m]) {
-					q_dominates = true;
-				}
-			}
-
-			if (p_dominates && !q_dominates) {
-				return 1;
-			}
-			else if (!p_dominates && q_dominates) {
-				return -1;
+				p_dominates |= p.objectives[m] < q.objectives[m];
+				q_dominates |= p.objectives[m] > q.objectives[m];
 			}
 
-			return 0;
+			return (p_dominates & !q_dominates) - (q_dominates & !p_dominates);
 		}
 
 		/*
 			Returns true if p wins the tournament against q, false otherwise.
+			A single pair drawn at random, so CheckDominance rather than CompareBlock,
+			which would need a DominancePoints copy of the pair first.
 		*/
 		inline bool Tournament(const Chromosome &p, const Chromosome &q) override
 		{	
@@ -100,52 +130,81 @@ namespace algorithms
 			return utils::random() < 0.5;
 		}
 
+		/*
+			Ranks the solutions of R into the fronts F. The first front holds the
+			solutions in R's order and every next front the solutions in the order
+			they are freed by the previous one.
+		*/
 		void NonDominatedSort(Population &R, std::vector<Population> &F)
 		{
-			for (auto &i : R) {
-				i.S.resize(0);
-				i.S.reserve(R.size() / 2);
-				i.n = 0;
-			}
+			auto &n = ranking.n;
+			auto &S = ranking.S;
+			auto &S_begin = ranking.S_begin;
+			auto &S_end = ranking.S_end;
+			auto &dominations = ranking.dominations;
+			auto &fronts = ranking.fronts;
+
+			n.assign(R.size(), 0);
+			dominations.resize(0);
 
 			// First front
-			F.resize(1);
+			ranking.Front(0);
 
-			for (int p = 0; p < R.size(); ++p) {
-				for (int q = p + 1; q != R.size(); ++q) {
-					auto domination_flag = CheckDominance(R[p], R[q]);
+			ranking.points.Assign(R);
 
-					// If p dominates q
-					if (domination_flag == 1) {
-						R[p].S.push_back(q);
-						++R[q].n;
-					}
-					// If q dominates p
-					else if (domination_flag == -1) {
-						R[q].S.push_back(p);
-						++R[p].n;
+			for (int p = 0; p < R.size(); ++p) {
+				// Compares p with the next solutions a block at a time
+				for (int begin = p + 1; begin < R.size(); begin += DOMINANCE_BLOCK) {
+					uint32_t dominates, dominated;
+					CompareBlock(ranking.points, p, begin, dominates, dominated);
+
+					for (uint32_t mask = dominates | dominated; mask; mask &= mask - 1) {
+						int k = LowestBit(mask), q = begin + k;
+
+						// If p dominates q
+						if (dominates >> k & 1) {
+							dominations.emplace_back(p, q);
+							++n[q];
+						}
+						// If q dominates p
+						else {
+							dominations.emplace_back(q, p);
+							++n[p];
+						}
 					}
 				}
 
-				if (R[p].n == 0) {
-					R[p].rank = 1;
-					F[0].push_back(std::move(R[p]));
+				if (n[p] == 0) {
+					fronts[0].push_back(p);
 				}
 			}
 
+			// Groups the dominated solutions by the dominating one, keeping the order they were found in
+			S_begin.assign(R.size() + 1, 0);
+
+			for (const auto &domination : dominations) {
+				++S_begin[domination.first + 1];
+			}
+
+			std::partial_sum(S_begin.begin(), S_begin.end(), S_begin.begin());
+			S_end.assign(S_begin.begin(), S_begin.end() - 1);
+			S.resize(dominations.size());
+
+			for (const auto &domination : dominations) {
+				S[S_end[domination.first]++] = domination.second;
+			}
+
 			int i = 0;
-			Population Q;
 
 			while (1) {
-				Q.resize(0);
+				auto &Q = ranking.Front(i + 1);
 
-				for (auto &p : F[i]) {
-					for (int q : p.S) {
-						--R[q].n;
+				for (int p : fronts[i]) {
+					for (int k = S_begin[p]; k != S_begin[p + 1]; ++k) {
+						int q = S[k];
 
-						if (R[q].n == 0) {
-							R[q].rank = i + 2; // +2 because i starts at 0
-							Q.push_back(R[q]);
+						if (--n[q] == 0) {
+							Q.push_back(q);
 						}
 					}
 				}
@@ -154,9 +213,19 @@ namespace algorithms
 					break;
 				}
 
-				F.push_back(std::move(Q));
 				++i;
 			}
+
+			F.resize(i + 1);
+
+			for (int f = 0; f <= i; ++f) {
+				F[f].resize(0);
+				F[f].reserve(fronts[f].size());
+
+				for (int p : fronts[f]) {
+					F[f].push_back(std::move(R[p]));
+				}
+			}
 		}
 
 		void CalculateCrowdingDistance(Population &I)
@@ -218,6 +287,42 @@ namespace algorithms
 			top_front = std::move(F[0]);
 		}
 
+		/*
+			The offspring have to have lower constraints values than the worst ranked
+			parent to survive the next Rank, as all the parents dominate them otherwise.
+		*/
+		types::Cutoff SurvivalCutoff() const
+		{
+			types::Cutoff cutoff;
+
+			if (!parents.empty()) {
+				cutoff.constraints = std::max_element(
+					parents.begin(),
+					parents.end(),
+					[](const Chromosome &p, const Chromosome &q) { return p.constraints < q.constraints; }
+				)->constraints;
+			}
+
+			return cutoff;
+		}
+
+		void UpdateArchive(const Population &P)
+		{
+			for (const auto &i : P) {
+				// Its objectives are partial, see types::Cutoff
+				if (i.truncated) {
+					continue;
+				}
+
+				if (i.snapshot) {
+					archive.Update(this->Released(i));
+				}
+				else {
+					archive.Update(i);
+				}
+			}
+		}
+
 	public:
 		template<class... ChromosomeParams>
 		void Init(
@@ -235,9 +340,27 @@ namespace algorithms
 				parents.push_back(std::move(Chromosome(params...)));
 			}
 
-			#pragma omp parallel for
-			for (int i = 0; i < parents.size(); ++i) {
-				fitness_function(parents[i]);
+			Evaluate(parents);
+
+			if (use_archive) {
+				UpdateArchive(parents);
+			}
+		}
+
+		// Creates new parent population starting from the seed individuals.
+		template<class... ChromosomeParams>
+		void Init(
+			int popsize,
+			const Population &seeds,
+			ChromosomeParams... params
+		)
+		{
+			Seed(popsize, seeds, params...);
+
+			Evaluate(parents);
+
+			if (use_archive) {
+				UpdateArchive(parents);
 			}
 		}
 
@@ -247,12 +370,38 @@ namespace algorithms
 			Select();
 			Reproduce();
 
-			#pragma omp parallel for 
-			for (int i = 0; i < offspring.size(); ++i) {
-				fitness_function(offspring[i]);
+			Evaluate(offspring, SurvivalCutoff());
+
+			if (use_archive) {
+				UpdateArchive(offspring);
 			}
 		}
 
+		/*
+			Steady-state alternative to calling Update num_evaluations / popsize times,
+			see BaseGA::Steady. The evaluated offspring are ranked together with the
+			parents, and offered to the archive, 'batch_size' at a time, or a quarter of
+			the population if it is not positive. Ranking is quadratic in the number of
+			solutions, so ranking every offspring on its own would cost more than most
+			evaluations.
+		*/
+		void UpdateAsync(int num_evaluations, int batch_size = -1)
+		{
+			if (batch_size < 1) {
+				batch_size = std::max(2, (int)parents.size() / 4);
+			}
+
+			Rank();
+
+			Steady(num_evaluations, batch_size, [this]() {
+				if (use_archive) {
+					UpdateArchive(offspring);
+				}
+
+				Rank();
+			});
+		}
+
 		// TODO: Review performance
 		Population TopFront()
 		{
@@ -281,7 +430,7 @@ namespace algorithms
 				top_front.erase(duplicates_begin, top_front.end());
 			}
 
-			return std::move(top_front);
+			return this->Released(std::move(top_front));
 		}
 
 		Population TopFront(Population R)
@@ -291,6 +440,27 @@ namespace algorithms
 			top_front = std::move(F[0]);
 			return std::move(TopFront());
 		}
+
+		/*
+			If 'use_archive' is true, every evaluated individual is offered to an archive
+			of the non-dominated solutions, which is kept across generations and runs
+			until ClearArchive is called.
+		*/
+		void UseArchive(bool use_archive)
+		{
+			this->use_archive = use_archive;
+		}
+
+		// Returns all the non-dominated solutions evaluated since the archive was last cleared.
+		Population Archive() const
+		{
+			return archive.Front();
+		}
+
+		void ClearArchive()
+		{
+			archive.Clear();
+		}
 	};
 }
 
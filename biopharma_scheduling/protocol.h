@@ -0,0 +1,227 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __PROTOCOL_H__
+#define __PROTOCOL_H__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "history.h"
+
+
+/*
+	Messages between the solver daemon (daemon.cpp) and its clients (client.py).
+	Both directions use the same framing, with the varints and doubles encoded
+	as in the history files:
+
+		varint message size (without this varint)
+		varint type, job id
+		payload
+
+	Strings are a varint length followed by the characters. Requests, with the
+	job id chosen by the client:
+
+		FIT_REQUEST        settings, i.e. 'key = value' lines as in a config file
+		EVALUATE_REQUEST   settings, varint num tables, for each table:
+		                       varint num campaigns, for each campaign:
+		                           product label, USP suite label (multi suite only), varint batches
+		CANCEL_REQUEST     nothing, stops the job with the same id
+
+	Replies, each job ends with either DONE_REPLY or ERROR_REPLY:
+
+		INSTANCE_REPLY     varint num objectives, for each: name, zigzag coefficient,
+		                   varint num products, product labels
+		PROGRESS_REPLY     varint run, gen, num evaluations, double seconds
+		FRONT_REPLY        history frame with the front of a finished run
+		RESULT_REPLY       history frame with the best solutions of all the runs
+		OBJECTIVES_REPLY   varint num tables, num values per table, doubles in the order of OBJECTIVES
+		DONE_REPLY         double seconds since the request was received
+		ERROR_REPLY        message
+
+	The objectives in the frames are the ones minimised by the GA, i.e. the value
+	of an objective times -1 * its coefficient.
+*/
+namespace io
+{
+	enum MESSAGE_TYPE
+	{
+		FIT_REQUEST = 1,
+		EVALUATE_REQUEST,
+		CANCEL_REQUEST,
+
+		INSTANCE_REPLY = 16,
+		PROGRESS_REPLY,
+		FRONT_REPLY,
+		RESULT_REPLY,
+		OBJECTIVES_REPLY,
+		DONE_REPLY,
+		ERROR_REPLY
+	};
+
+	// Larger messages are treated as a corrupted stream.
+	static const uint64_t MAX_MESSAGE_SIZE = 1 << 28;
+
+	struct Message
+	{
+		int type;
+		uint64_t job_id;
+		std::string payload;
+	};
+
+	inline void WriteString(const std::string &value, std::string &buffer)
+	{
+		WriteVarint(value.size(), buffer);
+		buffer += value;
+	}
+
+	// Framed message, ready to be sent.
+	inline std::string EncodeMessage(int type, uint64_t job_id, const std::string &payload)
+	{
+		std::string header, message;
+
+		WriteVarint(type, header);
+		WriteVarint(job_id, header);
+		WriteVarint(header.size() + payload.size(), message);
+
+		message.reserve(message.size() + header.size() + payload.size());
+		message += header;
+		message += payload;
+
+		return message;
+	}
+
+	/*
+		Sequential reads of a payload. Throws std::runtime_error if the payload
+		ends before the value.
+	*/
+	class PayloadReader
+	{
+		const char *p, *end;
+
+	public:
+		explicit PayloadReader(const std::string &payload) : p(payload.data()), end(payload.data() + payload.size()) {}
+
+		uint64_t Varint()
+		{
+			uint64_t value;
+
+			if (!ReadVarint(p, end, value)) {
+				throw std::runtime_error("Truncated message");
+			}
+
+			return value;
+		}
+
+		inline int64_t ZigZag()
+		{
+			return DecodeZigZag(Varint());
+		}
+
+		double Double()
+		{
+			double value;
+
+			if (end - p < sizeof(double)) {
+				throw std::runtime_error("Truncated message");
+			}
+
+			std::memcpy(&value, p, sizeof(double));
+			p += sizeof(double);
+
+			return value;
+		}
+
+		std::string String()
+		{
+			uint64_t length = Varint();
+
+			if (length > end - p) {
+				throw std::runtime_error("Truncated message");
+			}
+
+			std::string value(p, length);
+			p += length;
+
+			return value;
+		}
+
+		inline HistoryFrame Frame()
+		{
+			return DecodeFrame(p, end);
+		}
+
+		inline bool AtEnd() const
+		{
+			return p == end;
+		}
+	};
+
+	/*
+		Splits a byte stream into messages, which can arrive in any number of pieces.
+	*/
+	class MessageBuffer
+	{
+		std::string data;
+		size_t begin = 0;
+
+	public:
+		inline void Append(const char *bytes, size_t size)
+		{
+			data.append(bytes, size);
+		}
+
+		/*
+			Moves the next complete message into 'message', returns false if there
+			is none yet. Throws std::runtime_error if the stream is corrupted.
+		*/
+		bool Next(Message &message)
+		{
+			const char *p = data.data() + begin, *end = data.data() + data.size();
+			uint64_t size, type;
+
+			if (!ReadVarint(p, end, size)) {
+				if (data.size() - begin >= 10) {
+					throw std::runtime_error("Corrupted message size");
+				}
+
+				return false;
+			}
+
+			if (size > MAX_MESSAGE_SIZE) {
+				throw std::runtime_error("Message of " + std::to_string(size) + " bytes is too large");
+			}
+
+			if (size > end - p) {
+				return false;
+			}
+
+			end = p + size;
+
+			if (!ReadVarint(p, end, type) || !ReadVarint(p, end, message.job_id)) {
+				throw std::runtime_error("Corrupted message header");
+			}
+
+			message.type = type;
+			message.payload.assign(p, end);
+			begin = end - data.data();
+
+			// Drops the consumed bytes once they make up most of the buffer
+			if (begin > 4096 && begin * 2 > data.size()) {
+				data.erase(0, begin);
+				begin = 0;
+			}
+
+			return true;
+		}
+	};
+}
+
+#endif
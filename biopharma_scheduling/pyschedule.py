@@ -9,6 +9,20 @@ import plotly.graph_objs as go
 import plotly.figure_factory as ff
 
 
+def _to_frame(table):
+    '''
+        Converts a list of records into a DataFrame. DataFrames are used as they are.
+        Returns None for an empty or missing table.
+    '''
+    if table is None or len(table) == 0:
+        return None
+
+    if isinstance(table, pd.core.frame.DataFrame):
+        return table
+
+    return pd.DataFrame.from_records(table)
+
+
 class PySingleSiteSimpleSchedule:
     def __init__(
             self, 
@@ -40,7 +54,7 @@ class PySingleSiteSimpleSchedule:
                     }
 
                 campaigns_table: list of Union[dict, OrderedDict]
-                    A Python list of either dict or OrderedDict, e.g.:
+                    A Python list of either dict or OrderedDict (or a DataFrame with the same columns), e.g.:
 
                     [
                         {
@@ -56,7 +70,7 @@ class PySingleSiteSimpleSchedule:
                     ]
 
                 batches_table: list of Union[dict, OrderedDict], optional, default None
-                    A Python list of either dict or OrderedDict, e.g.:
+                    A Python list of either dict or OrderedDict (or a DataFrame with the same columns), e.g.:
 
                     [
                         {
@@ -71,7 +85,7 @@ class PySingleSiteSimpleSchedule:
                     ]
 
                 tasks_table: list of Union[dict, OrderedDict], optional, default None
-                    A Python list of either dict or OrderedDict, e.g.:
+                    A Python list of either dict or OrderedDict (or a DataFrame with the same columns), e.g.:
 
                     [
                         {
@@ -137,13 +151,13 @@ class PySingleSiteSimpleSchedule:
                     ]
         '''
         self.__objectives = pd.DataFrame.from_records([objectives], index=['value'])
-        self.__campaigns = pd.DataFrame.from_records(campaigns_table)
-        self.__batches = pd.DataFrame.from_records(batches_table) if batches_table else None
-        self.__tasks = pd.DataFrame.from_records(tasks_table) if tasks_table else None
-        self.__kg_inventory = pd.DataFrame.from_records(kg_inventory) if kg_inventory else None
-        self.__kg_backlog = pd.DataFrame.from_records(kg_backlog) if kg_backlog else None
-        self.__kg_supply = pd.DataFrame.from_records(kg_supply) if kg_supply else None
-        self.__kg_waste = pd.DataFrame.from_records(kg_waste) if kg_waste else None
+        self.__campaigns = pd.DataFrame.from_records(campaigns_table) if isinstance(campaigns_table, list) else campaigns_table
+        self.__batches = _to_frame(batches_table)
+        self.__tasks = _to_frame(tasks_table)
+        self.__kg_inventory = _to_frame(kg_inventory)
+        self.__kg_backlog = _to_frame(kg_backlog)
+        self.__kg_supply = _to_frame(kg_supply)
+        self.__kg_waste = _to_frame(kg_waste)
 
         for df in [self.__kg_inventory, self.__kg_backlog, self.__kg_supply, self.__kg_waste]:
             if df is not None:
@@ -307,12 +321,12 @@ class PySingleSiteMultiSuiteSchedule:
             batch_waste: list=None,
         ):
         self.__objectives = pd.DataFrame.from_records([objectives], index=['value'])
-        self.__campaigns = pd.DataFrame.from_records(campaigns_table)
-        self.__batches = pd.DataFrame.from_records(batches_table) if batches_table else None
-        self.__batch_inventory = pd.DataFrame.from_records(batch_inventory) if batch_inventory else None
-        self.__batch_backlog = pd.DataFrame.from_records(batch_backlog) if batch_backlog else None
-        self.__batch_supply = pd.DataFrame.from_records(batch_supply) if batch_supply else None
-        self.__batch_waste = pd.DataFrame.from_records(batch_waste) if batch_waste else None
+        self.__campaigns = pd.DataFrame.from_records(campaigns_table) if isinstance(campaigns_table, list) else campaigns_table
+        self.__batches = _to_frame(batches_table)
+        self.__batch_inventory = _to_frame(batch_inventory)
+        self.__batch_backlog = _to_frame(batch_backlog)
+        self.__batch_supply = _to_frame(batch_supply)
+        self.__batch_waste = _to_frame(batch_waste)
 
         for df in [
             self.__batch_inventory, 
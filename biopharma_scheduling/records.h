@@ -0,0 +1,145 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __RECORDS_H__
+#define __RECORDS_H__
+
+#include <vector>
+
+#include "schedule.h"
+
+
+namespace types
+{
+	/*
+		Flat, fixed size records of a schedule, which can be exposed to NumPy as
+		record arrays without copying. All times are in days from the start of
+		the schedule.
+	*/
+	struct CampaignRecord
+	{
+		int product_num;
+		int suite_num;
+		int num_batches;
+		int first_batch_num; // Index of the first batch of the campaign in ScheduleRecords::batches
+		double kg;
+		double start;
+		double first_harvest;
+		double first_batch;
+		double last_batch;
+		double end;
+	};
+
+	struct BatchRecord
+	{
+		int product_num;
+		int campaign_num; // Index of the campaign in ScheduleRecords::campaigns
+		double kg;
+		double start;
+		double harvested_at;
+		double stored_at;
+		double expires_at;
+		double approved_at;
+	};
+
+	struct ScheduleRecords
+	{
+		int num_products;
+		int num_periods;
+
+		std::vector<double> objectives;
+		std::vector<CampaignRecord> campaigns;
+		std::vector<BatchRecord> batches;
+
+		// Products x periods grids in the row-major order, i.e. kg for
+		// SingleSiteSimpleSchedule and batches for SingleSiteMultiSuiteSchedule
+		std::vector<double> inventory;
+		std::vector<double> backlog;
+		std::vector<double> supply;
+		std::vector<double> waste;
+	};
+
+	inline void AddRecords(const Campaign &campaign, double end, ScheduleRecords &records)
+	{
+		records.campaigns.push_back(CampaignRecord{
+			campaign.product_num,
+			campaign.suite_num,
+			campaign.num_batches,
+			(int)records.batches.size(),
+			campaign.kg,
+			campaign.start,
+			campaign.first_harvest,
+			campaign.first_batch,
+			campaign.last_batch,
+			end
+		});
+
+		for (const auto &batch : campaign.batches) {
+			records.batches.push_back(BatchRecord{
+				batch.product_num,
+				(int)records.campaigns.size() - 1,
+				batch.kg,
+				batch.start,
+				batch.harvested_at,
+				batch.stored_at,
+				batch.expires_at,
+				batch.approved_at
+			});
+		}
+	}
+
+	template<class Grid>
+	inline void Flatten(const std::vector<std::vector<Grid>> &grid, std::vector<double> &flat)
+	{
+		flat.resize(0);
+
+		for (const auto &row : grid) {
+			flat.insert(flat.end(), row.begin(), row.end());
+		}
+	}
+
+	inline void MakeRecords(const SingleSiteSimpleSchedule &schedule, ScheduleRecords &records)
+	{
+		records.num_products = schedule.kg_inventory.size();
+		records.num_periods = schedule.kg_inventory.empty() ? 0 : schedule.kg_inventory[0].size();
+		records.objectives = schedule.objectives;
+		records.campaigns.resize(0);
+		records.batches.resize(0);
+
+		for (const auto &campaign : schedule.campaigns) {
+			// Campaign::end is not used by SingleSiteSimpleModel
+			AddRecords(campaign, campaign.last_batch, records);
+		}
+
+		Flatten(schedule.kg_inventory, records.inventory);
+		Flatten(schedule.kg_backlog, records.backlog);
+		Flatten(schedule.kg_supply, records.supply);
+		Flatten(schedule.kg_waste, records.waste);
+	}
+
+	inline void MakeRecords(const SingleSiteMultiSuiteSchedule &schedule, ScheduleRecords &records)
+	{
+		records.num_products = schedule.batch_inventory.size();
+		records.num_periods = schedule.batch_inventory.empty() ? 0 : schedule.batch_inventory[0].size();
+		records.objectives = schedule.objectives;
+		records.campaigns.resize(0);
+		records.batches.resize(0);
+
+		for (const auto &suite : schedule.suites) {
+			for (const auto &campaign : suite) {
+				AddRecords(campaign, campaign.end, records);
+			}
+		}
+
+		Flatten(schedule.batch_inventory, records.inventory);
+		Flatten(schedule.batch_backlog, records.backlog);
+		Flatten(schedule.batch_supply, records.supply);
+		Flatten(schedule.batch_waste, records.waste);
+	}
+}
+
+#endif
@@ -0,0 +1,41 @@
+from libcpp.vector cimport vector
+
+from schedule cimport SingleSiteSimpleSchedule, SingleSiteMultiSuiteSchedule
+
+
+cdef extern from "records.h" namespace "types":
+    cdef struct CampaignRecord:
+        int product_num
+        int suite_num
+        int num_batches
+        int first_batch_num
+        double kg
+        double start
+        double first_harvest
+        double first_batch
+        double last_batch
+        double end
+
+    cdef struct BatchRecord:
+        int product_num
+        int campaign_num
+        double kg
+        double start
+        double harvested_at
+        double stored_at
+        double expires_at
+        double approved_at
+
+    cdef cppclass ScheduleRecords:
+        int num_products
+        int num_periods
+        vector[double] objectives
+        vector[CampaignRecord] campaigns
+        vector[BatchRecord] batches
+        vector[double] inventory
+        vector[double] backlog
+        vector[double] supply
+        vector[double] waste
+
+    void MakeRecords(SingleSiteSimpleSchedule &schedule, ScheduleRecords &records)
+    void MakeRecords(SingleSiteMultiSuiteSchedule &schedule, ScheduleRecords &records)
@@ -0,0 +1,437 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __RESULT_CACHE_H__
+#define __RESULT_CACHE_H__
+
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(_WIN32)
+	#include <io.h>
+	#include <direct.h>
+	#include <sys/utime.h>
+#else
+	#include <dirent.h>
+	#include <utime.h>
+	#include <sys/stat.h>
+#endif
+
+#include "history.h"
+#include "input_data.h"
+
+
+/*
+	On-disk cache of the results of the fits with a fixed seed. An entry is keyed by
+	everything the result depends on, i.e. the input data as parsed (so the formatting
+	of the CSV files does not matter), the objectives, the constraints, the GA parameters,
+	the seed and the initial population. Its file is named after a hash of the key and
+	holds the key itself, so a hash collision is a miss:
+
+		8 byte CACHE_MAGIC
+		varint key size, key
+		history frame with the solutions
+		history frame with the last population
+*/
+namespace io
+{
+	static const char CACHE_MAGIC[8] = { 'B', 'S', 'C', 'A', 'C', 'H', 'E', '1' };
+
+	/*
+		Canonical binary form of the inputs of a fit, see FitKey.
+	*/
+	class KeyWriter
+	{
+		std::string data;
+
+	public:
+		inline void Add(int64_t value)
+		{
+			WriteZigZag(value, data);
+		}
+
+		inline void Add(double value)
+		{
+			WriteDouble(value, data);
+		}
+
+		inline void Add(const std::string &value)
+		{
+			WriteVarint(value.size(), data);
+			data += value;
+		}
+
+		template<class T>
+		void Add(const std::vector<T> &values)
+		{
+			WriteVarint(values.size(), data);
+
+			for (const auto &value : values) {
+				Add(value);
+			}
+		}
+
+		void Add(const std::vector<int> &values)
+		{
+			WriteVarint(values.size(), data);
+
+			for (int value : values) {
+				Add((int64_t)value);
+			}
+		}
+
+		template<class Objective>
+		void Add(const std::vector<std::pair<Objective, int>> &objectives)
+		{
+			WriteVarint(objectives.size(), data);
+
+			for (const auto &objective : objectives) {
+				Add((int64_t)objective.first);
+				Add((int64_t)objective.second);
+			}
+		}
+
+		template<class Objective>
+		void Add(const std::vector<std::pair<Objective, std::pair<int, double>>> &constraints)
+		{
+			WriteVarint(constraints.size(), data);
+
+			for (const auto &constraint : constraints) {
+				Add((int64_t)constraint.first);
+				Add((int64_t)constraint.second.first);
+				Add(constraint.second.second);
+			}
+		}
+
+		inline const std::string& Data() const
+		{
+			return data;
+		}
+	};
+
+	inline void AddInputData(const deterministic::SingleSiteSimpleInputData &input_data, KeyWriter &key)
+	{
+		key.Add(std::string("deterministic::SingleSiteSimpleInputData"));
+		key.Add(input_data.objectives);
+		key.Add(input_data.constraints);
+		key.Add(input_data.kg_demand);
+		key.Add(input_data.kg_inventory_target);
+		key.Add(input_data.days_per_period);
+		key.Add(input_data.kg_opening_stock);
+		key.Add(input_data.kg_yield_per_batch);
+		key.Add(input_data.kg_storage_limits);
+		key.Add(input_data.inventory_penalty_per_kg);
+		key.Add(input_data.backlog_penalty_per_kg);
+		key.Add(input_data.production_cost_per_kg);
+		key.Add(input_data.storage_cost_per_kg);
+		key.Add(input_data.waste_cost_per_kg);
+		key.Add(input_data.sell_price_per_kg);
+		key.Add(input_data.inoculation_days);
+		key.Add(input_data.seed_days);
+		key.Add(input_data.production_days);
+		key.Add(input_data.usp_days);
+		key.Add(input_data.dsp_days);
+		key.Add(input_data.approval_days);
+		key.Add(input_data.shelf_life_days);
+		key.Add(input_data.changeover_days);
+		key.Add(input_data.min_batches_per_campaign);
+		key.Add(input_data.max_batches_per_campaign);
+		key.Add(input_data.batches_multiples_of_per_campaign);
+	}
+
+	inline void AddInputData(const deterministic::SingleSiteMultiSuiteInputData &input_data, KeyWriter &key)
+	{
+		key.Add(std::string("deterministic::SingleSiteMultiSuiteInputData"));
+		key.Add(input_data.objectives);
+		key.Add(input_data.constraints);
+		key.Add((int64_t)input_data.num_usp_suites);
+		key.Add((int64_t)input_data.num_dsp_suites);
+		key.Add(input_data.demand);
+		key.Add(input_data.days_per_period);
+		key.Add(input_data.usp_days);
+		key.Add(input_data.dsp_days);
+		key.Add(input_data.usp_production_cost);
+		key.Add(input_data.dsp_production_cost);
+		key.Add(input_data.usp_changeover_cost);
+		key.Add(input_data.dsp_changeover_cost);
+		key.Add(input_data.sales_price);
+		key.Add(input_data.storage_cost);
+		key.Add(input_data.backlog_penalty);
+		key.Add(input_data.waste_disposal_cost);
+		key.Add(input_data.shelf_life);
+		key.Add(input_data.storage_cap);
+		key.Add(input_data.usp_changeovers);
+		key.Add(input_data.dsp_changeovers);
+	}
+
+	/*
+		Key of a fit. 'params' holds the GA parameters and the seed in any stable
+		text form, 'seeds' the chromosomes the initial population is seeded with.
+	*/
+	template<class InputData, class Chromosome>
+	std::string FitKey(const InputData &input_data, const std::string &params, const std::vector<Chromosome> &seeds)
+	{
+		KeyWriter key;
+		std::string frame, body;
+
+		AddInputData(input_data, key);
+		key.Add(params);
+
+		EncodeFrame(0, 0, seeds, frame, body);
+		key.Add(frame);
+
+		return key.Data();
+	}
+
+	// 64 bit FNV-1a, i.e. the name of an entry and not a proof of its contents.
+	inline uint64_t HashKey(const std::string &key)
+	{
+		uint64_t hash = 14695981039346656037ULL;
+
+		for (unsigned char byte : key) {
+			hash = (hash ^ byte) * 1099511628211ULL;
+		}
+
+		return hash;
+	}
+
+	/*
+		Entries live in 'dir' as '<hash>.fit' files. Once their total size exceeds
+		'max_bytes', the least recently used ones are removed, with a hit counting as
+		a use and the latest entry always kept. Writes go to a temporary file first, so several processes can share
+		the directory.
+	*/
+	class ResultCache
+	{
+		struct EntryFile
+		{
+			std::string path;
+			uint64_t size;
+			std::time_t last_used;
+		};
+
+		std::string dir;
+		uint64_t max_bytes;
+
+		std::string EntryPath(const std::string &key) const
+		{
+			char name[32];
+			std::snprintf(name, sizeof(name), "%016llx.fit", (unsigned long long)HashKey(key));
+			return dir + "/" + name;
+		}
+
+		std::vector<EntryFile> ListEntries() const
+		{
+			std::vector<EntryFile> entries;
+
+#if defined(_WIN32)
+			_finddata_t found;
+			intptr_t handle = _findfirst((dir + "/*.fit").c_str(), &found);
+
+			if (handle == -1) {
+				return entries;
+			}
+
+			do {
+				entries.push_back(EntryFile{ dir + "/" + found.name, (uint64_t)found.size, found.time_write });
+			} while (_findnext(handle, &found) == 0);
+
+			_findclose(handle);
+#else
+			DIR *handle = opendir(dir.c_str());
+
+			if (!handle) {
+				return entries;
+			}
+
+			while (dirent *found = readdir(handle)) {
+				std::string name = found->d_name;
+				struct stat info;
+
+				if (name.size() > 4 && !name.compare(name.size() - 4, 4, ".fit") && !stat((dir + "/" + name).c_str(), &info)) {
+					entries.push_back(EntryFile{ dir + "/" + name, (uint64_t)info.st_size, info.st_mtime });
+				}
+			}
+
+			closedir(handle);
+#endif
+
+			return entries;
+		}
+
+		// Keeps the entry at 'kept_path', i.e. the one just stored.
+		void Evict(const std::string &kept_path) const
+		{
+			auto entries = ListEntries();
+			uint64_t total = 0;
+
+			for (const auto &entry : entries) {
+				total += entry.size;
+			}
+
+			std::sort(entries.begin(), entries.end(), [](const EntryFile &a, const EntryFile &b) {
+				return a.last_used < b.last_used;
+			});
+
+			for (const auto &entry : entries) {
+				if (total <= max_bytes) {
+					break;
+				}
+
+				if (entry.path == kept_path) {
+					continue;
+				}
+
+				std::remove(entry.path.c_str());
+				total -= entry.size;
+			}
+		}
+
+	public:
+		explicit ResultCache(const std::string &dir, uint64_t max_bytes = 256ULL << 20) : dir(dir), max_bytes(max_bytes)
+		{
+#if defined(_WIN32)
+			_mkdir(dir.c_str());
+#else
+			mkdir(dir.c_str(), 0755);
+#endif
+		}
+
+		inline const std::string& Dir() const
+		{
+			return dir;
+		}
+
+		/*
+			Returns false if there is no entry for the key. A corrupted entry is
+			removed and counts as a miss.
+		*/
+		template<class Chromosome>
+		bool Load(const std::string &key, std::vector<Chromosome> &solutions, std::vector<Chromosome> &population) const
+		{
+			std::string path = EntryPath(key);
+			std::ifstream file(path, std::ios::binary);
+
+			if (!file) {
+				return false;
+			}
+
+			std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			file.close();
+
+			const char *p = data.data(), *end = data.data() + data.size();
+			uint64_t key_size;
+
+			if (data.size() < sizeof(CACHE_MAGIC) || std::memcmp(p, CACHE_MAGIC, sizeof(CACHE_MAGIC))) {
+				std::remove(path.c_str());
+				return false;
+			}
+
+			p += sizeof(CACHE_MAGIC);
+
+			if (!ReadVarint(p, end, key_size) || key_size > end - p) {
+				std::remove(path.c_str());
+				return false;
+			}
+
+			if (key.compare(0, std::string::npos, p, key_size)) {
+				return false;
+			}
+
+			p += key_size;
+
+			try {
+				std::vector<Chromosome> *fronts[2] = { &solutions, &population };
+
+				for (auto *front : fronts) {
+					HistoryFrame frame = DecodeFrame(p, end);
+					front->assign(frame.constraints.size(), Chromosome());
+
+					for (int i = 0; i < front->size(); ++i) {
+						auto &chromosome = (*front)[i];
+						int num_genes = frame.num_fields ? frame.fields[i].size() / frame.num_fields : 0;
+
+						chromosome.constraints = frame.constraints[i];
+						SetObjectives(chromosome, frame.objectives[i]);
+						chromosome.genes.resize(num_genes);
+
+						for (int g = 0; g < num_genes; ++g) {
+							SetFields(chromosome.genes[g], &frame.fields[i][g * frame.num_fields]);
+						}
+					}
+				}
+			}
+			catch (const std::runtime_error&) {
+				std::remove(path.c_str());
+				return false;
+			}
+
+			// Marks the entry as recently used
+#if defined(_WIN32)
+			_utime(path.c_str(), NULL);
+#else
+			utime(path.c_str(), NULL);
+#endif
+
+			return true;
+		}
+
+		// Failures to write are ignored, i.e. the next fit recomputes the result.
+		template<class Chromosome>
+		void Store(const std::string &key, const std::vector<Chromosome> &solutions, const std::vector<Chromosome> &population) const
+		{
+			std::string data(CACHE_MAGIC, sizeof(CACHE_MAGIC)), frame, body;
+
+			WriteVarint(key.size(), data);
+			data += key;
+
+			EncodeFrame(0, 0, solutions, frame, body);
+			data += frame;
+			EncodeFrame(1, 0, population, frame, body);
+			data += frame;
+
+			std::ostringstream tmp_path;
+			tmp_path << EntryPath(key) << "." << std::random_device{}() << ".tmp";
+
+			std::FILE *file = std::fopen(tmp_path.str().c_str(), "wb");
+
+			if (!file) {
+				return;
+			}
+
+			bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+			written = !std::fclose(file) && written;
+
+			std::string path = EntryPath(key);
+
+			if (written) {
+				std::remove(path.c_str()); // rename does not replace a file on Windows
+				written = !std::rename(tmp_path.str().c_str(), path.c_str());
+			}
+
+			if (!written) {
+				std::remove(tmp_path.str().c_str());
+				return;
+			}
+
+			Evict(path);
+		}
+	};
+}
+
+#endif
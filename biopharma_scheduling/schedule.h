@@ -9,7 +9,9 @@
 #define __SCHEDULE_H__
 
 #include <queue>
+#include <utility>
 
+#include "utils.h"
 #include "campaign.h"
 
 
@@ -31,44 +33,63 @@ namespace types
         return std::move(v);
     }
 
+    /*
+        Empties the inventory queue of every product and period. The queues of a schedule
+        which is reused, see the Workspace of the models, keep their memory.
+    */
+    template<class Queue>
+    void ResetInventory(std::vector<std::vector<Queue>> &inventory, int num_products, int num_periods)
+    {
+        inventory.resize(num_products);
+
+        for (auto &i : inventory) {
+            i.resize(num_periods);
+
+            for (auto &q : i) {
+                auto &batches = utils::access_queue_container(q);
+
+                // Reserve space for the queue (big performance boost)
+                if (batches.capacity() < 100) {
+                    q = Queue(OldestBatchFirst(), make_reserved<types::Batch>(100));
+                }
+                else {
+                    batches.clear();
+                }
+            }
+        }
+    }
+
+    // Sets all the values to zero, reusing the rows.
+    template<class T>
+    void ResetTable(std::vector<std::vector<T>> &table, int num_rows, int num_cols)
+    {
+        table.resize(num_rows);
+
+        for (auto &row : table) {
+            row.assign(num_cols, T());
+        }
+    }
+
     struct SingleSiteMultiSuiteSchedule
     {       
         SingleSiteMultiSuiteSchedule() {}
 
         void Init(int num_products, int num_periods, int num_suites, int num_objectives) 
         {
-            using queue = std::priority_queue<types::Batch, std::vector<types::Batch>, OldestBatchFirst>;
-
-            // Reserve space for the queue (big performance boost)
-            inventory.resize(num_products);
-
-            for (auto &i : inventory) {
-                i.resize(num_periods);
-
-                for (auto &q : i) {
-                    q = queue(OldestBatchFirst(), make_reserved<types::Batch>(100));
-                }
-            }
+            ResetInventory(inventory, num_products, num_periods);
 
             suites.resize(num_suites);
 
-            batch_inventory = std::vector<std::vector<int>>(
-                num_products, std::vector<int>(num_periods, 0.0)
-            );
+            for (auto &suite : suites) {
+                suite.clear();
+            }
 
-            batch_supply = std::vector<std::vector<int>>(
-                num_products, std::vector<int>(num_periods, 0.0)
-            );
+            ResetTable(batch_inventory, num_products, num_periods);
+            ResetTable(batch_supply, num_products, num_periods);
+            ResetTable(batch_backlog, num_products, num_periods);
+            ResetTable(batch_waste, num_products, num_periods);
 
-            batch_backlog = std::vector<std::vector<int>>(
-                num_products, std::vector<int>(num_periods, 0.0)
-            );
-            
-            batch_waste = std::vector<std::vector<int>>(
-                num_products, std::vector<int>(num_periods, 0.0)
-            );
-
-            objectives = std::vector<double>(num_objectives, 0.0);
+            objectives.assign(num_objectives, 0.0);
         }
 
         std::vector<double> objectives;
@@ -173,47 +194,27 @@ namespace types
     {       
         SingleSiteSimpleSchedule() {}
 
+        // Keeps the campaigns, i.e. starts another simulation of the same schedule.
         void Reset(int num_products, int num_periods)
         {
-            using queue = std::priority_queue<types::Batch, std::vector<types::Batch>, OldestBatchFirst>;
+            ResetInventory(inventory, num_products, num_periods);
 
-            // Reserve space for the queue (big performance boost)
-            inventory.clear();
-            inventory.resize(num_products);
-
-            for (auto &i : inventory) {
-                i.resize(num_periods);
-
-                for (auto &q : i) {
-                    q = queue(OldestBatchFirst(), make_reserved<types::Batch>(100));
-                }
-            }
-
-            kg_inventory = std::vector<std::vector<double>>(
-                num_products, std::vector<double>(num_periods, 0.0)
-            );
-
-            kg_supply = std::vector<std::vector<double>>(
-                num_products, std::vector<double>(num_periods, 0.0)
-            );
-
-            kg_backlog = std::vector<std::vector<double>>(
-                num_products, std::vector<double>(num_periods, 0.0)
-            );
-            
-            kg_waste = std::vector<std::vector<double>>(
-                num_products, std::vector<double>(num_periods, 0.0)
-            );
+            ResetTable(kg_inventory, num_products, num_periods);
+            ResetTable(kg_supply, num_products, num_periods);
+            ResetTable(kg_backlog, num_products, num_periods);
+            ResetTable(kg_waste, num_products, num_periods);
         }
 
         void Init(int num_products, int num_periods, int num_objectives) 
         {
             Reset(num_products, num_periods);
 
-            objectives = std::vector<double>(num_objectives, 0.0);
+            campaigns.clear();
+            objectives.assign(num_objectives, 0.0);
         }
 
         std::vector<double> objectives;
+        std::vector<std::pair<int, double>> increments; // Added to the objectives by the periods of the last product
 
         std::vector<types::Campaign> campaigns; 
 
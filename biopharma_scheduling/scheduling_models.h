@@ -10,6 +10,7 @@
 
 #include <queue>
 #include <cmath>
+#include <memory>
 #include <vector>
 #include <utility>
 #include <numeric>
@@ -21,6 +22,8 @@
 
 #include "gene.h"
 #include "schedule.h"
+#include "cutoff.h"
+#include "delta.h"
 #include "input_data.h"
 #include "nsga_chromosome.h"
 #include "single_objective_chromosome.h"
@@ -411,50 +414,88 @@ namespace stochastic
 			}
 		}
 
+		// The sums of the simulations so far never decrease, except for the profit and the total cost.
+		static inline bool IsAccumulated(int objective)
+		{
+			return objective >= MEAN_OBJECTIVES_START && objective < MEAN_OBJECTIVES_END &&
+				objective != TOTAL_PROFIT_MEAN && objective != TOTAL_COST_MEAN;
+		}
+
+		/*
+			True if the constraint violations of the means, or the minimised objective of
+			a single-objective chromosome, already exceed the cutoff with the sums of the
+			simulations so far, which are lower bounds of the final ones.
+		*/
+		inline bool IsCutOff(const types::SingleSiteSimpleSchedule &schedule, const types::Cutoff &cutoff) const
+		{
+			double violation = 0.0;
+
+			for (const auto &it : input_data.constraints) {
+				double mean = schedule.objectives[it.first] / input_data.num_mc_sims;
+
+				// <= bound
+				if (it.second.first == -1 && IsAccumulated(it.first) && mean > it.second.second) {
+					violation += std::fabs(mean - it.second.second);
+				}
+			}
+
+			if (types::Cutoff::Exceeds(violation, cutoff.constraints)) {
+				return true;
+			}
+
+			if (input_data.objectives.empty()) {
+				return false;
+			}
+
+			const auto &objective = *input_data.objectives.begin();
+
+			return objective.second == -1 && IsAccumulated(objective.first) &&
+				types::Cutoff::Exceeds(schedule.objectives[objective.first] / input_data.num_mc_sims, cutoff.objective);
+		}
+
 		/*
-			Builds inventory, supply, backlog, and waste graphs and evaluates them.
+			Builds inventory, supply, backlog, and waste graphs and evaluates them. Returns
+			false if the simulation stopped at the cutoff.
 		*/
-		void EvaluateCampaigns(types::SingleSiteSimpleSchedule &schedule) 
+		bool EvaluateCampaigns(types::SingleSiteSimpleSchedule &schedule, const types::Cutoff &cutoff, types::CutoffStats &stats) 
 		{		
 			int product_num, period_num;
 			double kg_demand;
+			bool check_cutoff = cutoff.IsActive();
 	
 			for (product_num = 0; product_num < input_data.num_products; ++product_num) {
-				
-				period_num = 0;
-
-				kg_demand = utils::triangular_distribution(
-					input_data.kg_demand_min[product_num][period_num],
-					input_data.kg_demand_mode[product_num][period_num],
-					input_data.kg_demand_max[product_num][period_num],
-					input_data.rng
-				);
-
-				CreateOpeningStock(schedule, product_num, period_num);
-				RemoveExpired(schedule, product_num, period_num);		
-				CheckSupplyDemandBacklogInventory(schedule, product_num, period_num, kg_demand);
-				RemoveExcess(schedule, product_num, period_num);
-				CheckInventoryTarget(schedule, product_num, period_num);
-			
-				for (period_num = 1; period_num < input_data.num_periods; ++period_num) {
-					// Add batches from the previous time period to the current one
-					for (auto &batch : utils::access_queue_container(schedule.inventory[product_num][period_num - 1])) {
-						schedule.inventory[product_num][period_num].push(std::move(batch));
-					}
-
+				for (period_num = 0; period_num < input_data.num_periods; ++period_num) {
 					kg_demand = utils::triangular_distribution(
 						input_data.kg_demand_min[product_num][period_num],
 						input_data.kg_demand_mode[product_num][period_num],
 						input_data.kg_demand_max[product_num][period_num],
 						input_data.rng
 					);
+
+					if (period_num == 0) {
+						CreateOpeningStock(schedule, product_num, period_num);
+					}
+					else {
+						// Add batches from the previous time period to the current one
+						for (auto &batch : utils::access_queue_container(schedule.inventory[product_num][period_num - 1])) {
+							schedule.inventory[product_num][period_num].push(std::move(batch));
+						}
+					}
 						
 					RemoveExpired(schedule, product_num, period_num);		
 					CheckSupplyDemandBacklogInventory(schedule, product_num, period_num, kg_demand);
 					RemoveExcess(schedule, product_num, period_num);
 					CheckInventoryTarget(schedule, product_num, period_num);
+
+					if (check_cutoff && IsCutOff(schedule, cutoff)) {
+						stats.num_periods += product_num * input_data.num_periods + period_num + 1;
+						return false;
+					}
 				}
 			}
+
+			stats.num_periods += input_data.num_products * input_data.num_periods;
+			return true;
 		} 
 
 	public:
@@ -466,8 +507,26 @@ namespace stochastic
 			Chromosome &individual,
 			types::SingleSiteSimpleSchedule &schedule
 		)
+		{
+			types::CutoffStats stats;
+			CreateSchedule(individual, schedule, types::Cutoff(), stats);
+		}
+
+		/*
+			Stops the simulations as soon as the individual is beyond 'cutoff', leaving
+			the objectives of the periods simulated so far. Returns false if it did.
+		*/
+		template<class Chromosome>
+		bool CreateSchedule(
+			Chromosome &individual,
+			types::SingleSiteSimpleSchedule &schedule,
+			const types::Cutoff &cutoff,
+			types::CutoffStats &stats
+		)
 		{
 			int cmpgn_num = 0;
+			bool completed = true;
+			long long num_periods = stats.num_periods;
 
 			schedule.Init(input_data.num_products, input_data.num_periods, NUM_OBJECTIVES);
 
@@ -514,7 +573,10 @@ namespace stochastic
 					}
 				}
 
-				EvaluateCampaigns(schedule);				
+				if (!EvaluateCampaigns(schedule, cutoff, stats)) {
+					completed = false;
+					break;
+				}
 
 				schedule.objectives[TOTAL_COST_MEAN] = (
 					schedule.objectives[TOTAL_INVENTORY_PENALTY_MEAN] + 
@@ -546,13 +608,34 @@ namespace stochastic
 			if (cmpgn_num < individual.genes.size()) {
 				individual.genes.erase(individual.genes.begin() + cmpgn_num + 1, individual.genes.end());
 			}
+
+			++stats.num_evaluations;
+
+			if (!completed) {
+				++stats.num_cut_off;
+				stats.num_periods_saved += (long long)input_data.num_mc_sims * input_data.num_products * input_data.num_periods - (stats.num_periods - num_periods);
+			}
+
+			return completed;
 		}
 
-		void operator()(types::SingleObjectiveChromosome<types::SingleSiteSimpleGene> &individual)
+		/*
+			Schedule which the evaluations of a batch reuse, see EvaluateBatch, and the
+			cutoff of the batch with the work it saved.
+		*/
+		struct Workspace
 		{
 			types::SingleSiteSimpleSchedule schedule;
+			types::Cutoff cutoff;
+			types::CutoffStats stats;
+			types::DeltaStats delta_stats;   // Empty, see deterministic::SingleSiteSimpleModel::UseDelta
+		};
 
-			CreateSchedule(individual, schedule);
+		template<class GeneContainer>
+		void Evaluate(types::SingleObjectiveChromosome<types::SingleSiteSimpleGene, GeneContainer> &individual, Workspace &workspace)
+		{
+			auto &schedule = workspace.schedule;
+			individual.truncated = !CreateSchedule(individual, schedule, workspace.cutoff, workspace.stats);
 
 			for (const auto &it : input_data.objectives) {
 				individual.objective = schedule.objectives[it.first] * it.second * -1;
@@ -575,15 +658,16 @@ namespace stochastic
 			}
 		}
 		
-		void operator()(types::NSGAChromosome<types::SingleSiteSimpleGene> &individual)
+		template<class GeneContainer, class Objectives>
+		void Evaluate(types::NSGAChromosome<types::SingleSiteSimpleGene, GeneContainer, Objectives> &individual, Workspace &workspace)
 		{
-			types::SingleSiteSimpleSchedule schedule;
+			auto &schedule = workspace.schedule;
+			individual.truncated = !CreateSchedule(individual, schedule, workspace.cutoff, workspace.stats);
 
-			CreateSchedule(individual, schedule);
-
-			individual.objectives.resize(0);
+			types::ResizeObjectives(individual.objectives, input_data.objectives.size());
+			int m = 0;
 			for (auto &it : input_data.objectives) {
-				individual.objectives.push_back(schedule.objectives[it.first] * it.second * -1);
+				individual.objectives[m++] = schedule.objectives[it.first] * it.second * -1;
 			}
 
 			// The smaller the constraint value the better
@@ -601,12 +685,69 @@ namespace stochastic
 				}
 			}
 		}
+
+		/*
+			Evaluates the chromosomes from 'begin' to 'end' one after another, building
+			their schedules in the workspace, so that its buffers are allocated once per
+			workspace rather than once per chromosome. A caller keeps a workspace per
+			thread, as BaseGA does, and evaluating one chromosome is a batch of one.
+		*/
+		template<class Chromosome>
+		void EvaluateBatch(Chromosome *begin, Chromosome *end, Workspace &workspace)
+		{
+			for (; begin != end; ++begin) {
+				Evaluate(*begin, workspace);
+			}
+		}
+
+		template<class Chromosome>
+		inline void operator()(Chromosome &individual)
+		{
+			Workspace workspace;
+			EvaluateBatch(&individual, &individual + 1, workspace);
+		}
 	};
 }
 
 
 namespace deterministic
 {
+	// The objectives which never decrease during a simulation, i.e. all but the profit and the total cost.
+	inline bool IsAccumulated(int objective)
+	{
+		return objective != TOTAL_PROFIT && objective != TOTAL_COST;
+	}
+
+	/*
+		Same as stochastic::SingleSiteSimpleModel::IsCutOff, for the single simulation
+		of a deterministic model.
+	*/
+	template<class Schedule, class InputData>
+	inline bool IsCutOff(const Schedule &schedule, const InputData &input_data, const types::Cutoff &cutoff)
+	{
+		double violation = 0.0;
+
+		for (const auto &it : input_data.constraints) {
+			// <= bound
+			if (it.second.first == -1 && IsAccumulated(it.first) && schedule.objectives[it.first] > it.second.second) {
+				violation += std::fabs(schedule.objectives[it.first] - it.second.second);
+			}
+		}
+
+		if (types::Cutoff::Exceeds(violation, cutoff.constraints)) {
+			return true;
+		}
+
+		if (input_data.objectives.empty()) {
+			return false;
+		}
+
+		const auto &objective = *input_data.objectives.begin();
+
+		return objective.second == -1 && IsAccumulated(objective.first) &&
+			types::Cutoff::Exceeds(schedule.objectives[objective.first], cutoff.objective);
+	}
+
 	class SingleSiteMultiSuiteModel
 	{
 		SingleSiteMultiSuiteInputData input_data;
@@ -980,34 +1121,49 @@ namespace deterministic
 			schedule.batch_inventory[product_num][period_num] = batches_available;
 		}
 
-		void EvaluateCampaigns(
-			types::SingleSiteMultiSuiteSchedule &schedule
+		/*
+			Builds inventory, supply, backlog, and waste graphs and adds their costs and
+			revenue to the objectives. Returns false if the simulation stopped at the
+			cutoff.
+		*/
+		bool EvaluateCampaigns(
+			types::SingleSiteMultiSuiteSchedule &schedule,
+			const types::Cutoff &cutoff,
+			types::CutoffStats &stats
 		)
 		{
 			int product_num, period_num;
+			bool check_cutoff = cutoff.IsActive();
 
 			for (product_num = 0; product_num < input_data.num_products; ++product_num) {
-
-				period_num = 0;
-
-				RemoveExpired(schedule, product_num, period_num);		
-				CheckSupplyDemandBacklogInventory(schedule, product_num, period_num);
-				RemoveExcess(schedule, product_num, period_num);
-			
-				for (period_num = 1; period_num < input_data.num_periods; ++period_num) {
-					for (const auto &batch : utils::access_queue_container(schedule.inventory[product_num][period_num - 1])) {
-						schedule.inventory[product_num][period_num].push(std::move(batch));
+				for (period_num = 0; period_num < input_data.num_periods; ++period_num) {
+					if (period_num) {
+						for (const auto &batch : utils::access_queue_container(schedule.inventory[product_num][period_num - 1])) {
+							schedule.inventory[product_num][period_num].push(std::move(batch));
+						}
 					}
 					
 					RemoveExpired(schedule, product_num, period_num);		
 					CheckSupplyDemandBacklogInventory(schedule, product_num, period_num);
 					RemoveExcess(schedule, product_num, period_num);
+
+					schedule.objectives[TOTAL_STORAGE_COST] += schedule.batch_inventory[product_num][period_num] * input_data.storage_cost[product_num];
+					schedule.objectives[TOTAL_BACKLOG_PENALTY] += schedule.batch_backlog[product_num][period_num] * input_data.backlog_penalty[product_num];
+					schedule.objectives[TOTAL_WASTE_COST] += schedule.batch_waste[product_num][period_num] * input_data.waste_disposal_cost[product_num];
+					schedule.objectives[TOTAL_REVENUE] += schedule.batch_supply[product_num][period_num] * input_data.sales_price[product_num];
+
+					if (check_cutoff && IsCutOff(schedule, input_data, cutoff)) {
+						stats.num_periods += product_num * input_data.num_periods + period_num + 1;
+						return false;
+					}
 				}
 			}
 
+			stats.num_periods += input_data.num_products * input_data.num_periods;
+			return true;
 		}
 
-		void CalculateObjectiveFunction(
+		void CalculateCampaignCosts(
 			types::SingleSiteMultiSuiteSchedule &schedule
 		)
 		{
@@ -1033,15 +1189,12 @@ namespace deterministic
 					schedule.objectives[TOTAL_BATCH_THROUGHPUT] += dsp_cmpgn.num_batches;
 				}
 			}
+		}
 
-			for (int product_num = 0; product_num != input_data.num_products; ++product_num) {
-				for (int period_num = 0; period_num != input_data.num_periods; ++period_num) {
-					schedule.objectives[TOTAL_STORAGE_COST] += schedule.batch_inventory[product_num][period_num] * input_data.storage_cost[product_num];
-					schedule.objectives[TOTAL_BACKLOG_PENALTY] += schedule.batch_backlog[product_num][period_num] * input_data.backlog_penalty[product_num];
-					schedule.objectives[TOTAL_WASTE_COST] += schedule.batch_waste[product_num][period_num] * input_data.waste_disposal_cost[product_num];
-					schedule.objectives[TOTAL_REVENUE] += schedule.batch_supply[product_num][period_num] * input_data.sales_price[product_num];
-				}
-			}
+		void CalculateObjectiveFunction(
+			types::SingleSiteMultiSuiteSchedule &schedule
+		)
+		{
 			schedule.objectives[TOTAL_COST] = (
 				schedule.objectives[TOTAL_STORAGE_COST] + 
 				schedule.objectives[TOTAL_BACKLOG_PENALTY] + 
@@ -1063,16 +1216,51 @@ namespace deterministic
 			types::SingleSiteMultiSuiteSchedule &schedule
 		)
 		{
+			types::CutoffStats stats;
+			CreateSchedule(individual, schedule, types::Cutoff(), stats);
+		}
+
+		// Same as stochastic::SingleSiteSimpleModel::CreateSchedule with a cutoff.
+		template<class Chromosome>
+		bool CreateSchedule(
+			Chromosome &individual,
+			types::SingleSiteMultiSuiteSchedule &schedule,
+			const types::Cutoff &cutoff,
+			types::CutoffStats &stats
+		)
+		{
+			long long num_periods = stats.num_periods;
+
 			CreateUSPSchedule(individual, schedule);
 			CreateDSPSchedule(individual, schedule);
-			EvaluateCampaigns(schedule);
+			CalculateCampaignCosts(schedule);
+
+			bool completed = EvaluateCampaigns(schedule, cutoff, stats);
 			CalculateObjectiveFunction(schedule);
+
+			++stats.num_evaluations;
+
+			if (!completed) {
+				++stats.num_cut_off;
+				stats.num_periods_saved += input_data.num_products * input_data.num_periods - (stats.num_periods - num_periods);
+			}
+
+			return completed;
 		}
 
-		void operator()(types::SingleObjectiveChromosome<types::SingleSiteMultiSuiteGene> &individual)
+		struct Workspace
 		{
 			types::SingleSiteMultiSuiteSchedule schedule;
-			CreateSchedule(individual, schedule);			
+			types::Cutoff cutoff;
+			types::CutoffStats stats;
+			types::DeltaStats delta_stats;   // Empty, see deterministic::SingleSiteSimpleModel::UseDelta
+		};
+
+		template<class GeneContainer>
+		void Evaluate(types::SingleObjectiveChromosome<types::SingleSiteMultiSuiteGene, GeneContainer> &individual, Workspace &workspace)
+		{
+			auto &schedule = workspace.schedule;
+			individual.truncated = !CreateSchedule(individual, schedule, workspace.cutoff, workspace.stats);
 			
 			for (const auto &it : input_data.objectives) {
 				individual.objective = schedule.objectives[it.first] * it.second * -1;
@@ -1096,15 +1284,17 @@ namespace deterministic
 			}
 		}
 		
-		void operator()(types::NSGAChromosome<types::SingleSiteMultiSuiteGene> &individual)
+		template<class GeneContainer, class Objectives>
+		void Evaluate(types::NSGAChromosome<types::SingleSiteMultiSuiteGene, GeneContainer, Objectives> &individual, Workspace &workspace)
 		{
-			types::SingleSiteMultiSuiteSchedule schedule;
-			CreateSchedule(individual, schedule);		
+			auto &schedule = workspace.schedule;
+			individual.truncated = !CreateSchedule(individual, schedule, workspace.cutoff, workspace.stats);
 
-			individual.objectives.resize(0);
+			types::ResizeObjectives(individual.objectives, input_data.objectives.size());
+			int m = 0;
 
 			for (auto &it : input_data.objectives) {
-				individual.objectives.push_back(schedule.objectives[it.first] * it.second * -1);
+				individual.objectives[m++] = schedule.objectives[it.first] * it.second * -1;
 			}
 
 			// The smaller the constraint value the better
@@ -1123,25 +1313,43 @@ namespace deterministic
 				}
 			}
 		}
+
+		// Same as stochastic::SingleSiteSimpleModel::EvaluateBatch.
+		template<class Chromosome>
+		void EvaluateBatch(Chromosome *begin, Chromosome *end, Workspace &workspace)
+		{
+			for (; begin != end; ++begin) {
+				Evaluate(*begin, workspace);
+			}
+		}
+
+		template<class Chromosome>
+		inline void operator()(Chromosome &individual)
+		{
+			Workspace workspace;
+			EvaluateBatch(&individual, &individual + 1, workspace);
+		}
 	};
 
 
 	class SingleSiteSimpleModel
 	{
 		SingleSiteSimpleInputData input_data;
+		unsigned long long id = types::NewModelId();
+		bool use_delta = false;
 
 		/*
 			Adds a batch to an inventory priority queue (oldest first) within an appropriate time
 			bucket based on the approval date of the said batch.
 		*/
-		inline void AddToInventory(types::SingleSiteSimpleSchedule &schedule, types::Batch &&new_batch)
+		inline void AddToInventory(types::SingleSiteSimpleSchedule &schedule, const types::Batch &new_batch)
 		{
 			// Range based binary search for a time period to fit the batch in 
 			// based on its approval date
 			int period_num = utils::search(input_data.due_dates, new_batch.approved_at);
 
 			if (period_num != -1) {
-				schedule.inventory[new_batch.product_num - 1][period_num].push(std::move(new_batch));
+				schedule.inventory[new_batch.product_num - 1][period_num].push(new_batch);
 			}
 		}
 
@@ -1199,7 +1407,6 @@ namespace deterministic
 			new_cmpgn.kg += new_batch.kg;
 			new_cmpgn.batches.reserve(100); 
 			new_cmpgn.batches.push_back(new_batch); 
-			AddToInventory(schedule, std::move(new_batch));
 
 			int num_batches = individual.genes[0].num_batches;		
 
@@ -1237,7 +1444,6 @@ namespace deterministic
 				
 				new_cmpgn.kg += new_batch.kg;
 				new_cmpgn.batches.push_back(new_batch);
-				AddToInventory(schedule, std::move(new_batch));
 			}
 
 			new_cmpgn.num_batches = new_cmpgn.batches.size();
@@ -1282,7 +1488,6 @@ namespace deterministic
 			new_cmpgn.kg += new_batch.kg;
 			new_cmpgn.batches.reserve(100);
 			new_cmpgn.batches.push_back(new_batch);
-			AddToInventory(schedule, std::move(new_batch));
 
 			int num_batches = individual.genes[cmpgn_num].num_batches;		
 
@@ -1320,7 +1525,6 @@ namespace deterministic
 				
 				new_cmpgn.kg += new_batch.kg;
 				new_cmpgn.batches.push_back(new_batch);
-				AddToInventory(schedule, std::move(new_batch));
 			}
 
 			new_cmpgn.num_batches = new_cmpgn.batches.size();
@@ -1370,7 +1574,6 @@ namespace deterministic
 				
 				prev_cmpgn.kg += new_batch.kg;
 				prev_cmpgn.batches.push_back(new_batch);
-				AddToInventory(schedule, std::move(new_batch));
 			}
 
 			prev_cmpgn.num_batches = prev_cmpgn.batches.size();
@@ -1379,6 +1582,13 @@ namespace deterministic
 			return true;
 		}
 
+		// Keeps the increments of the objectives of the product for the snapshot, see UseDelta.
+		static inline void AddToObjective(types::SingleSiteSimpleSchedule &schedule, int objective, double value)
+		{
+			schedule.objectives[objective] += value;
+			schedule.increments.push_back(std::make_pair(objective, value));
+		}
+
 		inline void CreateOpeningStock(types::SingleSiteSimpleSchedule &schedule, int product_num, int period_num)
 		{
 			if (input_data.kg_opening_stock[product_num] > 0) {
@@ -1399,8 +1609,8 @@ namespace deterministic
 			while (!schedule.inventory[product_num][period_num].empty() && kg_over > input_data.kg_storage_limits[product_num]) {
 				if (kg_over >= schedule.inventory[product_num][period_num].top().kg) {
 					schedule.kg_waste[product_num][period_num] += schedule.inventory[product_num][period_num].top().kg;
-					schedule.objectives[TOTAL_KG_WASTE] += schedule.inventory[product_num][period_num].top().kg;
-					schedule.objectives[TOTAL_WASTE_COST] += schedule.inventory[product_num][period_num].top().kg * input_data.waste_cost_per_kg[product_num];
+					AddToObjective(schedule, TOTAL_KG_WASTE, schedule.inventory[product_num][period_num].top().kg);
+					AddToObjective(schedule, TOTAL_WASTE_COST, schedule.inventory[product_num][period_num].top().kg * input_data.waste_cost_per_kg[product_num]);
 					kg_over -= schedule.inventory[product_num][period_num].top().kg;
 					schedule.inventory[product_num][period_num].pop();
 
@@ -1410,8 +1620,8 @@ namespace deterministic
 				}
 				else {
 					schedule.kg_waste[product_num][period_num] += kg_over;
-					schedule.objectives[TOTAL_KG_WASTE] += kg_over;
-					schedule.objectives[TOTAL_WASTE_COST] += kg_over * input_data.waste_cost_per_kg[product_num];
+					AddToObjective(schedule, TOTAL_KG_WASTE, kg_over);
+					AddToObjective(schedule, TOTAL_WASTE_COST, kg_over * input_data.waste_cost_per_kg[product_num]);
 					utils::access_queue_container(schedule.inventory[product_num][period_num])[0].kg -= kg_over;
 					kg_over = 0;
 				}
@@ -1426,8 +1636,8 @@ namespace deterministic
 				schedule.inventory[product_num][period_num].top().expires_at < input_data.due_dates[period_num]
 			) {
 				schedule.kg_waste[product_num][period_num] += schedule.inventory[product_num][period_num].top().kg;
-				schedule.objectives[TOTAL_KG_WASTE] += schedule.inventory[product_num][period_num].top().kg;
-				schedule.objectives[TOTAL_WASTE_COST] += schedule.inventory[product_num][period_num].top().kg * input_data.waste_cost_per_kg[product_num];
+				AddToObjective(schedule, TOTAL_KG_WASTE, schedule.inventory[product_num][period_num].top().kg);
+				AddToObjective(schedule, TOTAL_WASTE_COST, schedule.inventory[product_num][period_num].top().kg * input_data.waste_cost_per_kg[product_num]);
 				schedule.inventory[product_num][period_num].pop();
 			}
 		}
@@ -1468,7 +1678,7 @@ namespace deterministic
 				else {
 					schedule.kg_supply[product_num][period_num] = kg_available;
 					schedule.kg_backlog[product_num][period_num] = input_data.kg_demand[product_num][period_num] - kg_available;
-					schedule.objectives[TOTAL_KG_BACKLOG] += schedule.kg_backlog[product_num][period_num];
+					AddToObjective(schedule, TOTAL_KG_BACKLOG, schedule.kg_backlog[product_num][period_num]);
 					kg_available = 0;
 
 					if (period_num) {
@@ -1508,9 +1718,9 @@ namespace deterministic
 				}
 			}
 
-			schedule.objectives[TOTAL_BACKLOG_PENALTY] += schedule.kg_backlog[product_num][period_num] * input_data.backlog_penalty_per_kg[product_num];
-			schedule.objectives[TOTAL_KG_SUPPLY] += schedule.kg_supply[product_num][period_num];
-			schedule.objectives[TOTAL_REVENUE] += schedule.kg_supply[product_num][period_num] * input_data.sell_price_per_kg[product_num];			
+			AddToObjective(schedule, TOTAL_BACKLOG_PENALTY, schedule.kg_backlog[product_num][period_num] * input_data.backlog_penalty_per_kg[product_num]);
+			AddToObjective(schedule, TOTAL_KG_SUPPLY, schedule.kg_supply[product_num][period_num]);
+			AddToObjective(schedule, TOTAL_REVENUE, schedule.kg_supply[product_num][period_num] * input_data.sell_price_per_kg[product_num]);			
 			schedule.kg_inventory[product_num][period_num] = kg_available;
 		}
 
@@ -1518,74 +1728,176 @@ namespace deterministic
 		{
 			if (input_data.kg_inventory_target.size()) {
 				if (schedule.kg_inventory[product_num][period_num] < input_data.kg_inventory_target[product_num][period_num]) {
-					schedule.objectives[TOTAL_KG_INVENTORY_DEFICIT] += input_data.kg_inventory_target[product_num][period_num] - schedule.kg_inventory[product_num][period_num];
-					schedule.objectives[TOTAL_INVENTORY_PENALTY] += (input_data.kg_inventory_target[product_num][period_num] - schedule.kg_inventory[product_num][period_num]) * input_data.inventory_penalty_per_kg[product_num];
+					AddToObjective(schedule, TOTAL_KG_INVENTORY_DEFICIT, input_data.kg_inventory_target[product_num][period_num] - schedule.kg_inventory[product_num][period_num]);
+					AddToObjective(schedule, TOTAL_INVENTORY_PENALTY, (input_data.kg_inventory_target[product_num][period_num] - schedule.kg_inventory[product_num][period_num]) * input_data.inventory_penalty_per_kg[product_num]);
+				}
+			}
+		}
+
+		// Adds the campaigns of the genes to the schedule up to the horizon.
+		template<class Chromosome>
+		void AddCampaigns(Chromosome &individual, types::SingleSiteSimpleSchedule &schedule)
+		{
+			if (!AddFirstCampaign(individual, schedule)) {
+				return;
+			}
+
+			// Add remaining campaigns. Break early if the schedule is at/over the horizon.
+			for (int cmpgn_num = 1; cmpgn_num != individual.genes.size(); ++cmpgn_num) {	
+				// Product-dependent changeover.	
+				if (individual.genes[cmpgn_num].product_num != individual.genes[cmpgn_num - 1].product_num) {
+					if (!AddNewCampaign(cmpgn_num, individual, schedule)) {
+						break;
+					}
+				}
+				else {
+					if (!ContinuePreviousCampaign(cmpgn_num, individual, schedule)) {
+						break;
+					}
 				}
 			}
 		}
 
+		// Whether the campaigns of the product are those of 'parent', if any.
+		static inline bool IsReused(const types::ParentSnapshot *parent, int product_num, const types::SingleSiteSimpleSchedule &schedule)
+		{
+			return parent && parent->products[product_num]->SameCampaigns(product_num + 1, schedule.campaigns);
+		}
+
 		/*
-			Builds inventory, supply, backlog, and waste graphs and evaluates them.
+			Builds inventory, supply, backlog, and waste graphs and evaluates them. The
+			products whose campaigns are those of 'parent' add its increments to the
+			objectives instead. Adds every product to 'snapshot', if any. Returns false
+			if the simulation stopped at the cutoff.
 		*/
-		void EvaluateCampaigns(types::SingleSiteSimpleSchedule &schedule) 
+		bool EvaluateCampaigns(
+			types::SingleSiteSimpleSchedule &schedule,
+			const types::Cutoff &cutoff,
+			types::CutoffStats &stats,
+			const types::ParentSnapshot *parent,
+			types::ParentSnapshot *snapshot,
+			types::DeltaStats *delta_stats
+		) 
 		{		
 			int product_num, period_num;
+			bool check_cutoff = cutoff.IsActive();
 	
 			for (product_num = 0; product_num < input_data.num_products; ++product_num) {
+				if (delta_stats) {
+					++delta_stats->num_products;
+				}
 
-				period_num = 0;
+				if (IsReused(parent, product_num, schedule)) {
+					for (const auto &increment : parent->products[product_num]->increments) {
+						schedule.objectives[increment.first] += increment.second;
+					}
 
-				CreateOpeningStock(schedule, product_num, period_num);
-				RemoveExpired(schedule, product_num, period_num);		
-				CheckSupplyDemandBacklogInventory(schedule, product_num, period_num);
-				RemoveExcess(schedule, product_num, period_num);
-				CheckInventoryTarget(schedule, product_num, period_num);
-			
-				for (period_num = 1; period_num < input_data.num_periods; ++period_num) {
-					// Add batches from the previous time period to the current one
-					for (auto &batch : utils::access_queue_container(schedule.inventory[product_num][period_num - 1])) {
-						schedule.inventory[product_num][period_num].push(std::move(batch));
+					if (snapshot) {
+						snapshot->products.push_back(parent->products[product_num]);
+					}
+
+					if (delta_stats) {
+						++delta_stats->num_products_reused;
+					}
+
+					if (check_cutoff && IsCutOff(schedule, input_data, cutoff)) {
+						return CutOff(schedule, product_num, input_data.num_periods - 1, stats, parent);
+					}
+
+					continue;
+				}
+
+				schedule.increments.resize(0);
+
+				for (const auto &cmpgn : schedule.campaigns) {
+					if (cmpgn.product_num == product_num + 1) {
+						for (const auto &batch : cmpgn.batches) {
+							AddToInventory(schedule, batch);
+						}
+					}
+				}
+
+				for (period_num = 0; period_num < input_data.num_periods; ++period_num) {
+					if (period_num == 0) {
+						CreateOpeningStock(schedule, product_num, period_num);
+					}
+					else {
+						// Add batches from the previous time period to the current one
+						for (auto &batch : utils::access_queue_container(schedule.inventory[product_num][period_num - 1])) {
+							schedule.inventory[product_num][period_num].push(std::move(batch));
+						}
 					}
 					
 					RemoveExpired(schedule, product_num, period_num);		
 					CheckSupplyDemandBacklogInventory(schedule, product_num, period_num);
 					RemoveExcess(schedule, product_num, period_num);
 					CheckInventoryTarget(schedule, product_num, period_num);
+
+					if (check_cutoff && IsCutOff(schedule, input_data, cutoff)) {
+						stats.num_periods += period_num + 1;
+						return CutOff(schedule, product_num, period_num, stats, parent);
+					}
+				}
+
+				stats.num_periods += input_data.num_periods;
+
+				if (snapshot) {
+					auto product = std::make_shared<types::ParentSnapshot::Product>();
+					product->increments = schedule.increments;
+
+					for (const auto &cmpgn : schedule.campaigns) {
+						if (cmpgn.product_num == product_num + 1) {
+							product->campaigns.push_back({ cmpgn.num_batches, cmpgn.first_harvest });
+						}
+					}
+
+					snapshot->products.push_back(std::move(product));
 				}
 			}
-		} 
 
-	public:
-		SingleSiteSimpleModel() {}
-		SingleSiteSimpleModel(SingleSiteSimpleInputData input_data) : input_data(input_data) {}
+			return true;
+		} 
 
-		template<class Chromosome>
-		void CreateSchedule(
-			Chromosome &individual,
-			types::SingleSiteSimpleSchedule &schedule
+		// Counts the periods after the cutoff which would have been simulated. Returns false.
+		bool CutOff(
+			const types::SingleSiteSimpleSchedule &schedule,
+			int product_num,
+			int period_num,
+			types::CutoffStats &stats,
+			const types::ParentSnapshot *parent
 		)
 		{
-			int cmpgn_num = 0;
-			schedule.Init(input_data.num_products, input_data.num_periods, NUM_OBJECTIVES);
+			if (!IsReused(parent, product_num, schedule)) {
+				stats.num_periods_saved += input_data.num_periods - period_num - 1;
+			}
 
-			if (AddFirstCampaign(individual, schedule)) {
-				// Add remaining campaigns. Break early if the schedule is at/over the horizon.
-				for (cmpgn_num = 1; cmpgn_num != individual.genes.size(); ++cmpgn_num) {	
-					// Product-dependent changeover.	
-					if (individual.genes[cmpgn_num].product_num != individual.genes[cmpgn_num - 1].product_num) {
-						if (!AddNewCampaign(cmpgn_num, individual, schedule)) {
-							break;
-						}
-					}
-					else {
-						if (!ContinuePreviousCampaign(cmpgn_num, individual, schedule)) {
-							break;
-						}
-					}
+			while (++product_num < input_data.num_products) {
+				if (!IsReused(parent, product_num, schedule)) {
+					stats.num_periods_saved += input_data.num_periods;
 				}
 			}
 
-			EvaluateCampaigns(schedule);
+			return false;
+		}
+
+		/*
+			Simulates the decoded campaigns, computes the objectives and rewrites the
+			genes from the campaigns. Returns false if the simulation stopped at the
+			cutoff. See EvaluateCampaigns for 'parent' and 'snapshot'.
+		*/
+		template<class Chromosome>
+		bool SimulateSchedule(
+			Chromosome &individual,
+			types::SingleSiteSimpleSchedule &schedule,
+			const types::Cutoff &cutoff,
+			types::CutoffStats &stats,
+			const types::ParentSnapshot *parent = nullptr,
+			types::ParentSnapshot *snapshot = nullptr,
+			types::DeltaStats *delta_stats = nullptr
+		)
+		{
+			int cmpgn_num;
+			bool completed = EvaluateCampaigns(schedule, cutoff, stats, parent, snapshot, delta_stats);
 
 			// TODO: check the final throughput against the storage constraints
 			for (const auto &cmpgn : schedule.campaigns) {
@@ -1620,13 +1932,107 @@ namespace deterministic
 			if (cmpgn_num < individual.genes.size()) {
 				individual.genes.erase(individual.genes.begin() + cmpgn_num + 1, individual.genes.end());
 			}
+
+			++stats.num_evaluations;
+
+			if (!completed) {
+				++stats.num_cut_off;
+			}
+
+			return completed;
+		}
+
+	public:
+		SingleSiteSimpleModel() {}
+		SingleSiteSimpleModel(SingleSiteSimpleInputData input_data) : input_data(input_data) {}
+
+		/*
+			If 'use_delta' is true, EvaluateBatch keeps a types::ParentSnapshot of every
+			full evaluation in the chromosome, which its copies, i.e. the offspring,
+			inherit. An offspring only simulates the periods of the products whose
+			campaigns differ from those of its parent, e.g. the products of the
+			campaigns after a mutated gene, which shift in time, and replays what the
+			periods of the others added to the objectives. The evaluations are the same
+			either way.
+		*/
+		void UseDelta(bool use_delta)
+		{
+			this->use_delta = use_delta;
+		}
+
+		template<class Chromosome>
+		void CreateSchedule(
+			Chromosome &individual,
+			types::SingleSiteSimpleSchedule &schedule
+		)
+		{
+			types::CutoffStats stats;
+			CreateSchedule(individual, schedule, types::Cutoff(), stats);
+		}
+
+		// Same as stochastic::SingleSiteSimpleModel::CreateSchedule with a cutoff.
+		template<class Chromosome>
+		bool CreateSchedule(
+			Chromosome &individual,
+			types::SingleSiteSimpleSchedule &schedule,
+			const types::Cutoff &cutoff,
+			types::CutoffStats &stats
+		)
+		{
+			schedule.Init(input_data.num_products, input_data.num_periods, NUM_OBJECTIVES);
+			AddCampaigns(individual, schedule);
+
+			return SimulateSchedule(individual, schedule, cutoff, stats);
 		}
 
-		void operator()(types::SingleObjectiveChromosome<types::SingleSiteSimpleGene> &individual)
+		struct Workspace
 		{
 			types::SingleSiteSimpleSchedule schedule;
+			types::Cutoff cutoff;
+			types::CutoffStats stats;
+			types::DeltaStats delta_stats;
+		};
+
+		/*
+			Same as CreateSchedule with the cutoff of the workspace, resuming the
+			simulation from the snapshot of the parent, see UseDelta.
+		*/
+		template<class Chromosome>
+		bool CreateSchedule(Chromosome &individual, Workspace &workspace)
+		{
+			workspace.schedule.Init(input_data.num_products, input_data.num_periods, NUM_OBJECTIVES);
+			AddCampaigns(individual, workspace.schedule);
+
+			if (!use_delta) {
+				return SimulateSchedule(individual, workspace.schedule, workspace.cutoff, workspace.stats);
+			}
 
-			CreateSchedule(individual, schedule);
+			auto snapshot = std::make_shared<types::ParentSnapshot>();
+			snapshot->model = id;
+			snapshot->products.reserve(input_data.num_products);
+
+			const types::ParentSnapshot *parent = individual.snapshot && individual.snapshot->model == id ? individual.snapshot.get() : nullptr;
+			bool completed = SimulateSchedule(individual, workspace.schedule, workspace.cutoff, workspace.stats, parent, snapshot.get(), &workspace.delta_stats);
+
+			++workspace.delta_stats.num_evaluations;
+			workspace.delta_stats.num_with_parent += parent != nullptr;
+
+			// Of the full evaluations only, the others do not have all the products
+			if (completed) {
+				individual.snapshot = std::move(snapshot);
+			}
+			else {
+				individual.snapshot.reset();
+			}
+
+			return completed;
+		}
+
+		template<class GeneContainer>
+		void Evaluate(types::SingleObjectiveChromosome<types::SingleSiteSimpleGene, GeneContainer> &individual, Workspace &workspace)
+		{
+			auto &schedule = workspace.schedule;
+			individual.truncated = !CreateSchedule(individual, workspace);
 
 			for (auto &it : input_data.objectives) {
 				individual.objective = schedule.objectives[it.first] * it.second * -1;
@@ -1649,15 +2055,16 @@ namespace deterministic
 			}
 		}
 		
-		void operator()(types::NSGAChromosome<types::SingleSiteSimpleGene> &individual)
+		template<class GeneContainer, class Objectives>
+		void Evaluate(types::NSGAChromosome<types::SingleSiteSimpleGene, GeneContainer, Objectives> &individual, Workspace &workspace)
 		{
-			types::SingleSiteSimpleSchedule schedule;
+			auto &schedule = workspace.schedule;
+			individual.truncated = !CreateSchedule(individual, workspace);
 
-			CreateSchedule(individual, schedule);
-
-			individual.objectives.resize(0);
+			types::ResizeObjectives(individual.objectives, input_data.objectives.size());
+			int m = 0;
 			for (auto &it : input_data.objectives) {
-				individual.objectives.push_back(schedule.objectives[it.first] * it.second * -1);
+				individual.objectives[m++] = schedule.objectives[it.first] * it.second * -1;
 			}
 
 			// The smaller the constraint value the better
@@ -1675,6 +2082,22 @@ namespace deterministic
 				}
 			}
 		}
+
+		// Same as stochastic::SingleSiteSimpleModel::EvaluateBatch.
+		template<class Chromosome>
+		void EvaluateBatch(Chromosome *begin, Chromosome *end, Workspace &workspace)
+		{
+			for (; begin != end; ++begin) {
+				Evaluate(*begin, workspace);
+			}
+		}
+
+		template<class Chromosome>
+		inline void operator()(Chromosome &individual)
+		{
+			Workspace workspace;
+			EvaluateBatch(&individual, &individual + 1, workspace);
+		}
 	};
 }
 
@@ -13,14 +13,14 @@
 
 namespace types
 {
-	template<class Gene>
-	class SingleObjectiveChromosome : public BaseChromosome<Gene>
+	template<class Gene, class GeneContainer = std::vector<Gene>>
+	class SingleObjectiveChromosome : public BaseChromosome<Gene, GeneContainer>
 	{
 	public:
-		using BaseChromosome<Gene>::BaseChromosome;
+		using BaseChromosome<Gene, GeneContainer>::BaseChromosome;
 
-		double objective;
-        double constraints;
+		double objective = 0.0;
+        double constraints = 0.0;
 	};
 }
 
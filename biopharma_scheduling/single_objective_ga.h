@@ -22,6 +22,9 @@ namespace algorithms
 		using BaseGA<Chromosome, FitnessFunction>::BaseGA;
 		using BaseGA<Chromosome, FitnessFunction>::Select;
 		using BaseGA<Chromosome, FitnessFunction>::Reproduce;
+		using BaseGA<Chromosome, FitnessFunction>::Seed;
+		using BaseGA<Chromosome, FitnessFunction>::Evaluate;
+		using BaseGA<Chromosome, FitnessFunction>::Steady;
 		using BaseGA<Chromosome, FitnessFunction>::fitness_function;
 		using BaseGA<Chromosome, FitnessFunction>::indices;
 		using BaseGA<Chromosome, FitnessFunction>::parents;
@@ -60,6 +63,24 @@ namespace algorithms
             );
 		}
 
+		/*
+			The offspring have to be better than the worst parent to replace it, and an
+			objective can only be compared once the worst parent is feasible.
+		*/
+		types::Cutoff SurvivalCutoff() const
+		{
+			types::Cutoff cutoff;
+			const Chromosome &worst = parents.back();
+
+			cutoff.constraints = worst.constraints;
+
+			if (worst.constraints == 0.0) {
+				cutoff.objective = worst.objective;
+			}
+
+			return cutoff;
+		}
+
 		inline bool Tournament(const Chromosome &p, const Chromosome &q) override
 		{	
             // If either p or q is infeasible
@@ -95,10 +116,7 @@ namespace algorithms
 				parents.push_back(std::move(Chromosome(params...)));
 			}
 
-			#pragma omp parallel for
-			for (int i = 0; i < parents.size(); ++i) {
-				fitness_function(parents[i]);
-			}
+			Evaluate(parents);
 
 			// Sorts in an descending order of objective 
 			// and ascending order of constraints values
@@ -115,23 +133,55 @@ namespace algorithms
             );
 		}
 
+		// Creates new parent population starting from the seed individuals.
+		template<class... ChromosomeParams>
+		void Init(
+			int popsize,
+			const Population &seeds,
+			ChromosomeParams... params
+		)
+		{
+			Seed(popsize, seeds, params...);
+
+			Evaluate(parents);
+
+			std::sort(parents.begin(), parents.end(),
+				[](const Chromosome &p, const Chromosome &q)
+                {
+                    // If either p or q is infeasible
+                    if (p.constraints != utils::Approx(q.constraints)) {
+                        return p.constraints < q.constraints;
+                    }	
+
+                    return p.objective < q.objective;
+                }
+            );
+		}
+
 		void Update()
 		{
 			Select();
 			Reproduce();
 
-			#pragma omp parallel for 
-			for (int i = 0; i < offspring.size(); ++i) {
-				fitness_function(offspring[i]);
-            }
+			Evaluate(offspring, SurvivalCutoff());
 
 			Replace();
 		}
 
+		/*
+			Steady-state alternative to calling Update num_evaluations / popsize times,
+			see BaseGA::Steady. The evaluated offspring replace the worst parents as soon
+			as they are handed back.
+		*/
+		void UpdateAsync(int num_evaluations)
+		{
+			Steady(num_evaluations, 1, [this]() { Replace(); });
+		}
+
 		// Returns top parent individual.
 		Chromosome Top()
 		{
-			return parents[0];
+			return this->Released(parents[0]);
 		}
 
 		// Returns top parent individual.
@@ -149,7 +199,7 @@ namespace algorithms
                 }
             );
 
-			return std::move(solutions[0]);
+			return this->Released(std::move(solutions[0]));
 		}
 	};
 }
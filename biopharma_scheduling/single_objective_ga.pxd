@@ -19,6 +19,32 @@ cdef extern from "single_objective_ga.h" namespace "algorithms" nogil:
 
         void Init(
             int popsize,
+            vector[Chromosome] seeds,
+            int starting_length,
+            double p_xo,
+            double p_gene_swap,
+            int num_products,
+            double p_product_mut,
+            double p_plus_batch_mut,
+            double p_minus_batch_mut
+        )
+
+        void Init(
+            int popsize,
+            int starting_length,
+            double p_xo,
+            double p_gene_swap,
+            int num_products,
+            int num_usp_suites,
+            double p_product_mut,
+            double p_usp_suite_mut,
+            double p_plus_batch_mut,
+            double p_minus_batch_mut
+        )
+
+        void Init(
+            int popsize,
+            vector[Chromosome] seeds,
             int starting_length,
             double p_xo,
             double p_gene_swap,
@@ -31,5 +57,10 @@ cdef extern from "single_objective_ga.h" namespace "algorithms" nogil:
         )
 
         void Update()
+        void UpdateAsync(int num_evaluations)
+        void SetSeededRatio(double seeded_ratio)
+        void UseCutoff(bint use_cutoff)
+        void UseDelta(bint use_delta)
+        vector[Chromosome] Parents()
         Chromosome Top()
         Chromosome Top(vector[Chromosome])
\ No newline at end of file
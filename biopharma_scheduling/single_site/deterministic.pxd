@@ -1,9 +1,11 @@
+from libcpp cimport bool
 from libcpp.utility cimport pair
 from libcpp.string cimport string
 from libcpp.vector cimport vector
 from libcpp.unordered_map cimport unordered_map
 
 from ..schedule cimport SingleSiteSimpleSchedule, SingleSiteMultiSuiteSchedule
+from ..records cimport ScheduleRecords
 
 
 cdef extern from "../input_data.h" namespace "deterministic":
@@ -66,6 +68,7 @@ cdef extern from "../input_data.h" namespace "deterministic":
             unordered_map[OBJECTIVES, pair[int, double]] *constraints
         )
 
+        vector[pair[OBJECTIVES, int]] objectives,
         vector[vector[double]] kg_demand,
         vector[int] days_per_period,
         vector[double] kg_opening_stock,
@@ -123,7 +126,7 @@ cdef extern from "../input_data.h" namespace "deterministic":
             unordered_map[OBJECTIVES, pair[int, double]] *constraints
         )
 
-        unordered_map[OBJECTIVES, int] objectives,
+        vector[pair[OBJECTIVES, int]] objectives,
         int num_usp_suites,
         int num_dsp_suites,
         vector[vector[int]] demand,
@@ -156,3 +159,51 @@ cdef extern from "../scheduling_models.h" namespace "deterministic" nogil:
         SingleSiteMultiSuiteModel()
         SingleSiteMultiSuiteModel(SingleSiteMultiSuiteInputData input_data)
         void CreateSchedule[Chromosome](Chromosome &chromosome, SingleSiteMultiSuiteSchedule &schedule)
+
+
+cdef extern from "../heuristics.h" namespace "heuristics" nogil:
+    vector[Chromosome] Seeds[Chromosome](SingleSiteSimpleInputData &input_data)
+    vector[Chromosome] Seeds[Chromosome](SingleSiteMultiSuiteInputData &input_data)
+
+
+cdef extern from "../loader.h" namespace "io" nogil:
+    cdef struct SingleSiteSimpleInstance:
+        vector[string] product_labels
+        vector[string] due_dates
+        SingleSiteSimpleInputData input_data
+
+    cdef struct SingleSiteMultiSuiteInstance:
+        vector[string] product_labels
+        vector[string] due_dates
+        SingleSiteMultiSuiteInputData input_data
+
+    SingleSiteSimpleInstance LoadSingleSiteSimple(
+        string data_dir,
+        string start_date,
+        unordered_map[OBJECTIVES, int] objectives,
+        unordered_map[OBJECTIVES, pair[int, double]] *constraints
+    ) except +
+
+    SingleSiteMultiSuiteInstance LoadSingleSiteMultiSuite(
+        string data_dir,
+        string start_date,
+        unordered_map[OBJECTIVES, int] objectives,
+        int num_usp_suites,
+        int num_dsp_suites,
+        unordered_map[OBJECTIVES, pair[int, double]] *constraints
+    ) except +
+
+
+cdef extern from "../evaluation.h" namespace "deterministic" nogil:
+    void EvaluateBatch[Model, Chromosome](Model &model, vector[Chromosome] &chromosomes, int num_threads)
+    void EvaluateObjectives[Schedule, Model, Chromosome](Model &model, vector[Chromosome] &chromosomes, vector[vector[double]] &objectives, int num_threads)
+    void CreateRecords[Schedule, Model, Chromosome](Model &model, vector[Chromosome] &chromosomes, vector[ScheduleRecords*] &records, int num_threads)
+
+
+cdef extern from "../result_cache.h" namespace "io" nogil:
+    cdef cppclass ResultCache:
+        ResultCache(string dir, unsigned long long max_bytes) except +
+        bool Load[Chromosome](string key, vector[Chromosome] &solutions, vector[Chromosome] &population) except +
+        void Store[Chromosome](string key, vector[Chromosome] &solutions, vector[Chromosome] &population) except +
+
+    string FitKey[InputData, Chromosome](InputData &input_data, string params, vector[Chromosome] &seeds) except +
@@ -3,6 +3,7 @@ import pandas as pd
 from tqdm import tqdm
 from collections import OrderedDict
 
+from cpython cimport Py_buffer
 from libcpp.utility cimport pair
 from libcpp.string cimport string
 from libcpp.vector cimport vector
@@ -13,7 +14,10 @@ from ..nsgaii cimport NSGAII
 from ..nsgaii_chromosome cimport NSGAChromosome
 from ..single_objective_ga cimport SingleObjectiveGA
 from ..single_objective_chromosome cimport SingleObjectiveChromosome
-from ..gene cimport SingleSiteSimpleGene, SingleSiteMultiSuiteGene
+from ..gene cimport SingleSiteSimpleGene, SingleSiteMultiSuiteGene, GeneField
+from ..metrics cimport Hypervolume, IGD, Epsilon, Spread
+from ..records cimport CampaignRecord, BatchRecord, ScheduleRecords, MakeRecords
+from ..history cimport HistoryWriter
 
 from ..pyschedule import PySingleSiteSimpleSchedule, PySingleSiteMultiSuiteSchedule
 
@@ -24,10 +28,190 @@ from deterministic cimport (
     SingleSiteSimpleModel,
     SingleSiteMultiSuiteModel,
     SingleSiteSimpleSchedule,
-    SingleSiteMultiSuiteSchedule
+    SingleSiteMultiSuiteSchedule,
+    Seeds,
+    SingleSiteSimpleInstance,
+    SingleSiteMultiSuiteInstance,
+    LoadSingleSiteSimple,
+    LoadSingleSiteMultiSuite,
+    EvaluateObjectives,
+    CreateRecords,
+    ResultCache,
+    FitKey
 )
 
 
+cdef class _BufferView:
+    '''
+        Read-only bytes view of the memory owned by a ScheduleArrays object, 
+        which is kept alive for as long as the view is referenced.
+    '''
+    cdef:
+        object owner
+        char *data
+        Py_ssize_t shape[1]
+        Py_ssize_t strides[1]
+
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        buffer.buf = self.data
+        buffer.format = 'B'
+        buffer.internal = NULL
+        buffer.itemsize = 1
+        buffer.len = self.shape[0]
+        buffer.ndim = 1
+        buffer.obj = self
+        buffer.readonly = 1
+        buffer.shape = self.shape
+        buffer.strides = self.strides
+        buffer.suboffsets = NULL
+
+    def __releasebuffer__(self, Py_buffer *buffer):
+        pass
+
+
+cdef CampaignRecord campaign_record
+cdef BatchRecord batch_record
+
+CAMPAIGN_RECORD = np.dtype({
+    'names': [
+        'product_num', 'suite_num', 'num_batches', 'first_batch_num',
+        'kg', 'start', 'first_harvest', 'first_batch', 'last_batch', 'end'
+    ],
+    'formats': [np.intc] * 4 + [np.float64] * 6,
+    'offsets': [
+        <char*>&campaign_record.product_num - <char*>&campaign_record,
+        <char*>&campaign_record.suite_num - <char*>&campaign_record,
+        <char*>&campaign_record.num_batches - <char*>&campaign_record,
+        <char*>&campaign_record.first_batch_num - <char*>&campaign_record,
+        <char*>&campaign_record.kg - <char*>&campaign_record,
+        <char*>&campaign_record.start - <char*>&campaign_record,
+        <char*>&campaign_record.first_harvest - <char*>&campaign_record,
+        <char*>&campaign_record.first_batch - <char*>&campaign_record,
+        <char*>&campaign_record.last_batch - <char*>&campaign_record,
+        <char*>&campaign_record.end - <char*>&campaign_record,
+    ],
+    'itemsize': sizeof(CampaignRecord)
+})
+
+BATCH_RECORD = np.dtype({
+    'names': [
+        'product_num', 'campaign_num', 
+        'kg', 'start', 'harvested_at', 'stored_at', 'expires_at', 'approved_at'
+    ],
+    'formats': [np.intc] * 2 + [np.float64] * 6,
+    'offsets': [
+        <char*>&batch_record.product_num - <char*>&batch_record,
+        <char*>&batch_record.campaign_num - <char*>&batch_record,
+        <char*>&batch_record.kg - <char*>&batch_record,
+        <char*>&batch_record.start - <char*>&batch_record,
+        <char*>&batch_record.harvested_at - <char*>&batch_record,
+        <char*>&batch_record.stored_at - <char*>&batch_record,
+        <char*>&batch_record.expires_at - <char*>&batch_record,
+        <char*>&batch_record.approved_at - <char*>&batch_record,
+    ],
+    'itemsize': sizeof(BatchRecord)
+})
+
+
+cdef class ScheduleArrays:
+    '''
+        A schedule as read-only NumPy arrays over the memory of its C++ records, 
+        i.e. without copying. Times are in days from the start date, products 
+        and suites are numbered from 1.
+
+        campaigns: record array with CAMPAIGN_RECORD dtype
+        batches: record array with BATCH_RECORD dtype, 'campaign_num' is the 
+            index of the batch's campaign in 'campaigns'
+        objectives: objective values indexed by the OBJECTIVES enum
+        inventory, backlog, supply, waste: products x periods arrays, kg for
+            DetSingleSiteSimple and batches for DetSingleSiteMultiSuite
+    '''
+    cdef:
+        ScheduleRecords records
+        public object pyschedule
+
+    cdef object __view(self, void *data, size_t size, dtype):
+        cdef _BufferView view
+
+        if size == 0:
+            return np.empty(0, dtype=dtype)
+
+        view = _BufferView()
+        view.owner = self
+        view.data = <char*>data
+        view.shape[0] = size * dtype.itemsize
+        view.strides[0] = 1
+
+        return np.frombuffer(view, dtype=dtype)
+
+    cdef object __grid(self, vector[double] &grid):
+        return self.__view(grid.data(), grid.size(), np.dtype(np.float64)).reshape(
+            self.records.num_products, 
+            self.records.num_periods
+        )
+
+    @property
+    def campaigns(self):
+        return self.__view(self.records.campaigns.data(), self.records.campaigns.size(), CAMPAIGN_RECORD)
+
+    @property
+    def batches(self):
+        return self.__view(self.records.batches.data(), self.records.batches.size(), BATCH_RECORD)
+
+    @property
+    def objectives(self):
+        return self.__view(self.records.objectives.data(), self.records.objectives.size(), np.dtype(np.float64))
+
+    @property
+    def inventory(self):
+        return self.__grid(self.records.inventory)
+
+    @property
+    def backlog(self):
+        return self.__grid(self.records.backlog)
+
+    @property
+    def supply(self):
+        return self.__grid(self.records.supply)
+
+    @property
+    def waste(self):
+        return self.__grid(self.records.waste)
+
+
+cdef class ScheduleSequence:
+    '''
+        Read-only sequence of schedules, which are decoded from their genes when 
+        accessed. Only the genes and the objective values of the solutions are 
+        kept after 'fit', the decoded schedules are cached by the model.
+
+        objectives: pd.DataFrame of the objective values of the schedules, 
+            available without decoding them
+    '''
+    cdef:
+        object decode
+        object indices
+        public object objectives
+
+    def __init__(self, decode, indices, objectives):
+        self.decode = decode
+        self.indices = list(indices)
+        self.objectives = objectives
+
+    def __len__(self):
+        return len(self.indices)
+
+    def __getitem__(self, key):
+        if isinstance(key, slice):
+            return [self.decode(index) for index in self.indices[key]]
+
+        return self.decode(self.indices[key])
+
+    def __iter__(self):
+        for index in self.indices:
+            yield self.decode(index)
+
+
 cdef class DetSingleSiteSimple:
     '''
         Continuous-time capacity planning of a single multi-product
@@ -43,12 +227,23 @@ cdef class DetSingleSiteSimple:
         SingleSiteSimpleInputData input_data
         SingleSiteSimpleModel single_site_simple
 
+        vector[vector[double]] front
+        vector[vector[double]] points
+        vector[vector[SingleSiteSimpleGene]] solution_genes
+
         object history
         object schedules
         object start_date
         object product_labels
         object due_dates
         object objectives
+        object initial_population
+        object population
+        object objectives_coefficients_list
+        object output
+        object cache
+        object history_file
+        ResultCache *result_cache
 
         int num_runs
         int num_gens
@@ -59,12 +254,17 @@ cdef class DetSingleSiteSimple:
         int random_state
         int verbose
         int save_history
+        int heuristic_init
+        int use_archive
+        int cache_size
+        int num_fits
 
         double p_xo
         double p_product_mut
         double p_plus_batch_mut
         double p_minus_batch_mut
         double p_gene_swap
+        double seeded_ratio
 
     AVAILABLE_OBJECTIVES = {
         'total_kg_inventory_deficit',
@@ -97,6 +297,14 @@ cdef class DetSingleSiteSimple:
         random_state: int=None,
         verbose: bool=False,
         save_history: bool=False,
+        heuristic_init: bool=False,
+        seeded_ratio: float=0.5,
+        use_archive: bool=False,
+        output: str='pandas',
+        cache_size: int=100,
+        history_file: str=None,
+        result_cache_dir: str=None,
+        result_cache_size_mb: int=256,
     ):
         '''
             PARAMETERS:
@@ -133,10 +341,11 @@ cdef class DetSingleSiteSimple:
 
                 num_threads: int, optional, default 1
                     Number of threads to use for evaluating the chromosome DetSingleSiteSimple. 
-                    If num_threads = -1, all CPUs are used. If num_threads = 0 or 1, 1 CPU is used.
+                    If num_threads = -1 or 0, all CPUs are used. If num_threads = 1, 1 CPU is used.
 
                 random_state, int, optional, default None
                     If not None, random_state is the seed used by the random number generator.
+                    If None or -1, the seed is random.
                 
                 verbose: bool, default False
                     If True, will print out the progress of the algorithm and display a progress bar.
@@ -144,6 +353,47 @@ cdef class DetSingleSiteSimple:
                 save_history: bool, default False
                     If True, will save best solution(s) from each GA run.
 
+                heuristic_init: bool, default False
+                    If True, the initial population is seeded with earliest due date and 
+                    changeover minimising campaign sequences with demand proportional 
+                    numbers of batches.
+
+                seeded_ratio: float, default 0.5
+                    Fraction of the initial population created from the heuristic seeds 
+                    and/or 'initial_population' passed to 'fit' [0.0 - 1.0]. The rest is random.
+
+                use_archive: bool, default False
+                    If True, every solution evaluated by the multi-objective genetic algorithm 
+                    is offered to an archive of non-dominated solutions, which is kept across 
+                    all the generations and runs. 'schedules' are then created from the archive 
+                    instead of the top fronts of the last generation of each run.
+
+                output: str, default 'pandas'
+                    Format of the schedules in 'schedules' and 'history'. With 'pandas', they 
+                    are PySingleSiteSimpleSchedule objects. With 'numpy', they are ScheduleArrays, 
+                    i.e. NumPy record arrays over the C++ memory without any conversion.
+
+                cache_size: int, default 100
+                    Only the genes and the objective values of the solutions are kept after 
+                    'fit'. Schedules are decoded when first accessed and up to 'cache_size' 
+                    of the most recently accessed ones are cached.
+
+                history_file: str, optional, default None
+                    If not None, the top front (or the top solution) of every generation of 
+                    every run is streamed to this binary file by a background thread. Use 
+                    'biopharma_scheduling.history.HistoryFile' to read it.
+
+                result_cache_dir: str, optional, default None
+                    If not None, the solutions and the last population of every fit are cached 
+                    in this directory, keyed by the input data, the objectives, the constraints, 
+                    the parameters above and 'initial_population'. A repeated fit returns them 
+                    without running the GA. Requires a 'random_state' other than -1. Not used together with 
+                    'save_history' or 'history_file'.
+
+                result_cache_size_mb: int, default 256
+                    Size of 'result_cache_dir' above which the least recently used entries are 
+                    removed.
+
         '''
         assert num_runs >= 1, "'num_runs' must be a positive integer number." 
         self.num_runs = num_runs
@@ -175,9 +425,8 @@ cdef class DetSingleSiteSimple:
         assert type(num_threads) is int, "'num_threads must be an integer number."
         self.num_threads = num_threads
         
-        if random_state is not None:
-            assert type(random_state) is int, "'random_state' must be an integer number"
-            self.random_state = random_state if random_state else -1
+        assert random_state is None or type(random_state) is int, "'random_state' must be an integer number"
+        self.random_state = random_state if random_state is not None else -1
 
         assert type(verbose) is bool, "'verbose' must have a bool value" 
         self.verbose = verbose
@@ -185,6 +434,31 @@ cdef class DetSingleSiteSimple:
         assert type(save_history) is bool, "'save_history' must have a bool value" 
         self.save_history = save_history
 
+        assert type(heuristic_init) is bool, "'heuristic_init' must have a bool value" 
+        self.heuristic_init = heuristic_init
+
+        assert seeded_ratio >= 0.0 and seeded_ratio <= 1.0, "'seeded_ratio' must be a positive floating point number in range [0.0 - 1.0]."
+        self.seeded_ratio = seeded_ratio
+
+        assert type(use_archive) is bool, "'use_archive' must have a bool value" 
+        self.use_archive = use_archive
+
+        assert output in ('pandas', 'numpy'), "'output' must be either 'pandas' or 'numpy'"
+        self.output = output
+
+        assert cache_size >= 1, "'cache_size' must be a positive integer number." 
+        self.cache_size = cache_size
+        self.cache = OrderedDict()
+
+        assert history_file is None or type(history_file) is str, "'history_file' must be a 'str'"
+        self.history_file = history_file
+
+        if result_cache_dir is not None:
+            assert type(result_cache_dir) is str, "'result_cache_dir' must be a 'str'"
+            assert self.random_state != -1, "'result_cache_dir' requires a fixed 'random_state'."
+            assert result_cache_size_mb >= 1, "'result_cache_size_mb' must be a positive integer number."
+            self.result_cache = new ResultCache(result_cache_dir.encode(), result_cache_size_mb << 20)
+
         self.objectives = {
             'total_kg_inventory_deficit': OBJECTIVES.TOTAL_KG_INVENTORY_DEFICIT,
             'total_kg_throughput': OBJECTIVES.TOTAL_KG_THROUGHPUT,
@@ -201,6 +475,9 @@ cdef class DetSingleSiteSimple:
             'total_cost': OBJECTIVES.TOTAL_COST
         }
 
+    def __dealloc__(self):
+        del self.result_cache
+
     def fit(
         self,
         start_date: str,
@@ -210,6 +487,7 @@ cdef class DetSingleSiteSimple:
         changeover_days: pd.core.frame.DataFrame,
         kg_inventory_target: pd.core.frame.DataFrame=None,
         constraints: dict=None,
+        initial_population: list=None,
     ):
         '''
             Runs the deterministic multi-objective genetic algorithm and generates optimal schedule(s)
@@ -325,6 +603,14 @@ cdef class DetSingleSiteSimple:
                     }        
 
                     i.e. 'constraint': [-1 if <= or 1 if >=, bound]
+
+                initial_population: list, optional
+                    Warm-starts every run from previous solutions, e.g. 'schedules' of an earlier
+                    fit on an overlapping horizon or the checkpointed 'population'. Each item is 
+                    either a schedule or a campaigns table with 'Product' and 'Batches' columns. 
+                    Campaigns of unknown products are dropped and the ones beyond the new horizon
+                    are truncated. Mutated copies of the seeds fill the population up to 
+                    'seeded_ratio' and the rest are random chromosomes.
         '''
         self.__validate_input(
             objectives,
@@ -387,7 +673,59 @@ cdef class DetSingleSiteSimple:
             &cpp_constraints if constraints is not None else NULL 
         )
 
+        return self.__solve(objectives, initial_population)
+
+    def fit_csv(
+        self,
+        data_dir: str,
+        start_date: str,
+        objectives: dict,
+        constraints: dict=None,
+        initial_population: list=None,
+    ):
+        '''
+            Same as 'fit', but reads the input data from 'kg_demand.csv', 'product_data.csv',
+            'changeover_days.csv' and the optional 'kg_inventory_target.csv' CSV files
+            in 'data_dir', i.e. in the layout of the 'examples/data' directories. The files are
+            parsed and validated natively without building DataFrames, which is faster for large
+            instances. Raises RuntimeError with the file and line of the first invalid entry.
+        '''
+        self.__validate_objectives(objectives, constraints)
+
+        cdef:
+            pair[int, double] p
+            unordered_map[OBJECTIVES, int] cpp_objectives
+            unordered_map[OBJECTIVES, pair[int, double]] cpp_constraints
+            SingleSiteSimpleInstance instance
+
+        for obj, coef in objectives.items():
+            cpp_objectives[self.objectives[obj]] = coef
+
+        if constraints:
+            for cons, [coef, bound] in constraints.items():
+                p.first = coef
+                p.second = bound
+                cpp_constraints[self.objectives[cons]] = p 
+
+        instance = LoadSingleSiteSimple(
+            data_dir.encode(),
+            start_date.encode(),
+            cpp_objectives,
+            &cpp_constraints if constraints is not None else NULL
+        )
+
+        self.product_labels = [label.decode() for label in instance.product_labels]
+        self.num_products = len(self.product_labels)
+        self.start_date = start_date
+        self.due_dates = np.array([date.decode() for date in instance.due_dates], dtype=object)
+        self.input_data = instance.input_data
+
+        return self.__solve(objectives, initial_population)
+
+    def __solve(self, objectives: dict, initial_population: list):
         self.single_site_simple = SingleSiteSimpleModel(self.input_data)
+        self.initial_population = initial_population
+        self.objectives_coefficients_list = list(objectives.items())
 
         if len(objectives) == 1:
             self.__run_single_objective_ga()
@@ -405,17 +743,7 @@ cdef class DetSingleSiteSimple:
         product_data: pd.core.frame.DataFrame, 
         changeover_days: pd.core.frame.DataFrame,
     ):
-        assert type(objectives) is dict, "'objectives' must be a 'dict', is a '{}'.".format(type(objectives))
-        for obj in objectives:
-            assert obj in self.AVAILABLE_OBJECTIVES, "'{}' is not allowed as an objective.".format(obj)
-            assert objectives[obj] in [-1, 1], "Objective coefficient can only be -1 or 1."
-
-        if constraints is not None:
-            assert type(constraints) is dict, "'constraints' must be a 'dict', is a '{}'.".format(type(constraints))
-            for cons in constraints:
-                assert cons in self.AVAILABLE_OBJECTIVES, "'{}' is not allowed as a constraint.".format(cons)
-                assert type(constraints[cons]) is list and len(constraints[cons]) == 2, "'constraints' are expected to hold a coeffcient and a bound."
-                assert constraints[cons][0] in [-1, 1], "Constraint coefficient can only be -1 or 1."
+        self.__validate_objectives(objectives, constraints)
 
         for df in [kg_demand, product_data, changeover_days]:
             assert type(df) is pd.core.frame.DataFrame, "Input data must be a 'pd.core.frame.DataFrame', is a '{}'".format(type(df))
@@ -469,6 +797,19 @@ cdef class DetSingleSiteSimple:
         assert len(self.product_labels) == len(changeover_days_product_columns) and set(self.product_labels) == set(changeover_days_product_columns), \
                "Product labels in 'product' column do not match with the actual product columns in 'changeover_days_product_columns'."
 
+    def __validate_objectives(self, objectives: dict, constraints: dict):
+        assert type(objectives) is dict, "'objectives' must be a 'dict', is a '{}'.".format(type(objectives))
+        for obj in objectives:
+            assert obj in self.AVAILABLE_OBJECTIVES, "'{}' is not allowed as an objective.".format(obj)
+            assert objectives[obj] in [-1, 1], "Objective coefficient can only be -1 or 1."
+
+        if constraints is not None:
+            assert type(constraints) is dict, "'constraints' must be a 'dict', is a '{}'.".format(type(constraints))
+            for cons in constraints:
+                assert cons in self.AVAILABLE_OBJECTIVES, "'{}' is not allowed as a constraint.".format(cons)
+                assert type(constraints[cons]) is list and len(constraints[cons]) == 2, "'constraints' are expected to hold a coeffcient and a bound."
+                assert constraints[cons][0] in [-1, 1], "Constraint coefficient can only be -1 or 1."
+
     def __count_days(self, start_date: str, due_dates: list):
         self.start_date = start_date
         self.due_dates = due_dates
@@ -484,9 +825,12 @@ cdef class DetSingleSiteSimple:
 
     def __run_single_objective_ga(self):
         cdef:
-            SingleSiteSimpleSchedule schedule
-            SingleObjectiveChromosome[SingleSiteSimpleGene] top_solution
-            vector[SingleObjectiveChromosome[SingleSiteSimpleGene]] solutions 
+            vector[SingleObjectiveChromosome[SingleSiteSimpleGene]] top_front
+            HistoryWriter[SingleObjectiveChromosome[SingleSiteSimpleGene]] *history_writer = NULL
+            SingleObjectiveChromosome[SingleSiteSimpleGene] top_solution, seed
+            vector[SingleObjectiveChromosome[SingleSiteSimpleGene]] solutions, seeds, parents
+            string key
+            vector[SingleObjectiveChromosome[SingleSiteSimpleGene]] heuristic_seeds
             
             SingleObjectiveGA[SingleObjectiveChromosome[SingleSiteSimpleGene], SingleSiteSimpleModel] ga = \
             SingleObjectiveGA[SingleObjectiveChromosome[SingleSiteSimpleGene], SingleSiteSimpleModel](
@@ -495,50 +839,107 @@ cdef class DetSingleSiteSimple:
                 self.num_threads   
             )
 
+        for genes in self.__seed_genes():
+            seed.genes.resize(len(genes))
+            for i, (product_num, num_batches) in enumerate(genes):
+                seed.genes[i].product_num = GeneField(product_num)
+                seed.genes[i].num_batches = GeneField(num_batches)
+            seeds.push_back(seed)
+
+        if self.heuristic_init:
+            heuristic_seeds = Seeds[SingleObjectiveChromosome[SingleSiteSimpleGene]](self.input_data)
+            seeds.insert(seeds.end(), heuristic_seeds.begin(), heuristic_seeds.end())
+
+        ga.SetSeededRatio(self.seeded_ratio)
+
+        cached = False
+
+        if self.__use_result_cache():
+            key = FitKey[SingleSiteSimpleInputData, SingleObjectiveChromosome[SingleSiteSimpleGene]](self.input_data, self.__fit_params(), seeds)
+            cached = self.result_cache.Load[SingleObjectiveChromosome[SingleSiteSimpleGene]](key, solutions, parents)
+
         if self.verbose: 
             pbar = tqdm(total=self.num_runs * self.num_gens)
 
-        for run in range(self.num_runs):
-            if self.verbose: 
-                pbar.set_description('GA is running %d/%d' % (run + 1, self.num_runs))
-
-            ga.Init(
-                self.popsize,
-                self.starting_length,
-                self.p_xo,
-                self.p_gene_swap,
-                self.num_products,
-                self.p_product_mut,
-                self.p_plus_batch_mut,
-                self.p_minus_batch_mut,
-            )
-
-            for gen in range(self.num_gens):
-                ga.Update()
+        if self.history_file is not None:
+            history_writer = new HistoryWriter[SingleObjectiveChromosome[SingleSiteSimpleGene]](self.history_file.encode(), self.__objective_names())
 
+        try:
+            for run in range(0 if cached else self.num_runs):
                 if self.verbose: 
-                    pbar.update()
+                    pbar.set_description('GA is running %d/%d' % (run + 1, self.num_runs))
+
+                if seeds.empty():
+                    ga.Init(
+                        self.popsize,
+                        self.starting_length,
+                        self.p_xo,
+                        self.p_gene_swap,
+                        self.num_products,
+                        self.p_product_mut,
+                        self.p_plus_batch_mut,
+                        self.p_minus_batch_mut,
+                    )
+                else:
+                    ga.Init(
+                        self.popsize,
+                        seeds,
+                        self.starting_length,
+                        self.p_xo,
+                        self.p_gene_swap,
+                        self.num_products,
+                        self.p_product_mut,
+                        self.p_plus_batch_mut,
+                        self.p_minus_batch_mut,
+                    )
+
+                for gen in range(self.num_gens):
+                    ga.Update()
+
+                    if history_writer != NULL:
+                        top_front.assign(1, ga.Top())
+                        history_writer.Write(run, gen, top_front)
+
+                    if self.verbose: 
+                        pbar.update()
+
+                top_solution = ga.Top()
+                solutions.push_back(top_solution)
+        finally:
+            del history_writer
+
+        if not cached:
+            parents = ga.Parents()
 
-            top_solution = ga.Top()
-            solutions.push_back(top_solution)
+        self.population = []
+        for solution in parents:
+            self.population.append([
+                (self.product_labels[solution.genes[i].product_num - 1], solution.genes[i].num_batches) 
+                for i in range(solution.genes.size())
+            ])
 
         if self.verbose and self.save_history:
             pbar.set_description('Processing history')
 
+        self.__clear_solutions()
+
         if self.save_history:
-            self.history = []
+            indices = []
             for solution in solutions:
-                schedule = SingleSiteSimpleSchedule()
-                self.single_site_simple.CreateSchedule(solution, schedule)
-                self.history.append(self.__make_pyschedule(schedule))
+                indices.append(self.__store_solution(solution.genes, [solution.objective]))
+            self.history = self.__make_sequence(indices)
 
         if self.verbose:
             pbar.set_description('Collecting schedules')
 
         top_solution = ga.Top(solutions)
-        schedule = SingleSiteSimpleSchedule()
-        self.single_site_simple.CreateSchedule(top_solution, schedule)
-        self.schedules = [self.__make_pyschedule(schedule)]
+
+        if not cached and self.__use_result_cache():
+            solutions.assign(1, top_solution)
+            self.result_cache.Store[SingleObjectiveChromosome[SingleSiteSimpleGene]](key, solutions, parents)
+        self.schedules = self.__make_sequence([self.__store_solution(top_solution.genes, [top_solution.objective])])
+        self.front.clear()
+        self.front.push_back(self.points.back())
 
         if self.verbose: 
             pbar.set_description('Done')
@@ -546,9 +947,12 @@ cdef class DetSingleSiteSimple:
 
     def __run_nsgaii(self):
         cdef:
-            SingleSiteSimpleSchedule schedule
+            HistoryWriter[NSGAChromosome[SingleSiteSimpleGene]] *history_writer = NULL
+            NSGAChromosome[SingleSiteSimpleGene] seed
             vector[NSGAChromosome[SingleSiteSimpleGene]] top_front
-            vector[NSGAChromosome[SingleSiteSimpleGene]] solutions
+            vector[NSGAChromosome[SingleSiteSimpleGene]] solutions, seeds, parents
+            string key
+            vector[NSGAChromosome[SingleSiteSimpleGene]] heuristic_seeds
             vector[vector[NSGAChromosome[SingleSiteSimpleGene]]] history
             
             NSGAII[NSGAChromosome[SingleSiteSimpleGene], SingleSiteSimpleModel] nsgaii = \
@@ -558,62 +962,231 @@ cdef class DetSingleSiteSimple:
                 self.num_threads   
             )
 
+        for genes in self.__seed_genes():
+            seed.genes.resize(len(genes))
+            for i, (product_num, num_batches) in enumerate(genes):
+                seed.genes[i].product_num = GeneField(product_num)
+                seed.genes[i].num_batches = GeneField(num_batches)
+            seeds.push_back(seed)
+
+        if self.heuristic_init:
+            heuristic_seeds = Seeds[NSGAChromosome[SingleSiteSimpleGene]](self.input_data)
+            seeds.insert(seeds.end(), heuristic_seeds.begin(), heuristic_seeds.end())
+
+        nsgaii.SetSeededRatio(self.seeded_ratio)
+        nsgaii.UseArchive(self.use_archive)
+
+        cached = False
+
+        if self.__use_result_cache():
+            key = FitKey[SingleSiteSimpleInputData, NSGAChromosome[SingleSiteSimpleGene]](self.input_data, self.__fit_params(), seeds)
+            cached = self.result_cache.Load[NSGAChromosome[SingleSiteSimpleGene]](key, solutions, parents)
+
         if self.verbose: 
             pbar = tqdm(total=self.num_runs * self.num_gens)
 
-        for run in range(self.num_runs):
-            if self.verbose: 
-                pbar.set_description('GA is running %d/%d' % (run + 1, self.num_runs))
-
-            nsgaii.Init(
-                self.popsize,
-                self.starting_length,
-                self.p_xo,
-                self.p_gene_swap,
-                self.num_products,
-                self.p_product_mut,
-                self.p_plus_batch_mut,
-                self.p_minus_batch_mut,
-            )
-
-            for gen in range(self.num_gens):
-                nsgaii.Update()
+        if self.history_file is not None:
+            history_writer = new HistoryWriter[NSGAChromosome[SingleSiteSimpleGene]](self.history_file.encode(), self.__objective_names())
 
+        try:
+            for run in range(0 if cached else self.num_runs):
                 if self.verbose: 
-                    pbar.update()
+                    pbar.set_description('GA is running %d/%d' % (run + 1, self.num_runs))
+
+                if seeds.empty():
+                    nsgaii.Init(
+                        self.popsize,
+                        self.starting_length,
+                        self.p_xo,
+                        self.p_gene_swap,
+                        self.num_products,
+                        self.p_product_mut,
+                        self.p_plus_batch_mut,
+                        self.p_minus_batch_mut,
+                    )
+                else:
+                    nsgaii.Init(
+                        self.popsize,
+                        seeds,
+                        self.starting_length,
+                        self.p_xo,
+                        self.p_gene_swap,
+                        self.num_products,
+                        self.p_product_mut,
+                        self.p_plus_batch_mut,
+                        self.p_minus_batch_mut,
+                    )
+
+                for gen in range(self.num_gens):
+                    nsgaii.Update()
+
+                    if history_writer != NULL:
+                        top_front = nsgaii.TopFront()
+                        history_writer.Write(run, gen, top_front)
+
+                    if self.verbose: 
+                        pbar.update()
+
+                # TopFront moves the front out, i.e. it is already in 'top_front' if written to the history
+                if history_writer == NULL:
+                    top_front = nsgaii.TopFront()
+
+                solutions.insert(solutions.end(), top_front.begin(), top_front.end())
 
-            top_front = nsgaii.TopFront()
-            solutions.insert(solutions.end(), top_front.begin(), top_front.end())
+                if self.save_history:
+                    history.push_back(top_front)
+        finally:
+            del history_writer
 
-            if self.save_history:
-                history.push_back(top_front)
+        if not cached:
+            parents = nsgaii.Parents()
+
+        self.population = []
+        for solution in parents:
+            self.population.append([
+                (self.product_labels[solution.genes[i].product_num - 1], solution.genes[i].num_batches) 
+                for i in range(solution.genes.size())
+            ])
 
         if self.verbose and self.save_history:
             pbar.set_description('Processing history')
 
+        self.__clear_solutions()
+        order = self.__objectives_order()
+
         if self.save_history:
             self.history = []
             for front in history:
-                self.history.append([])
+                indices = []
                 for solution in front:
-                    schedule = SingleSiteSimpleSchedule()
-                    self.single_site_simple.CreateSchedule(solution, schedule)
-                    self.history[-1].append(self.__make_pyschedule(schedule))
+                    indices.append(self.__store_solution(solution.genes, [solution.objectives[i] for i in order]))
+                self.history.append(self.__make_sequence(indices))
 
         if self.verbose:
             pbar.set_description('Collecting schedules')
 
-        self.schedules = []
-        solutions = nsgaii.TopFront(solutions)
+        if not cached:
+            if self.use_archive:
+                solutions = nsgaii.Archive()
+            else:
+                solutions = nsgaii.TopFront(solutions)
+
+            if self.__use_result_cache():
+                self.result_cache.Store[NSGAChromosome[SingleSiteSimpleGene]](key, solutions, parents)
+
+        indices = []
+        self.front.clear()
         for solution in solutions:
-            schedule = SingleSiteSimpleSchedule()
-            self.single_site_simple.CreateSchedule(solution, schedule)
-            self.schedules.append(self.__make_pyschedule(schedule))
+            indices.append(self.__store_solution(solution.genes, [solution.objectives[i] for i in order]))
+            self.front.push_back(self.points.back())
+        self.schedules = self.__make_sequence(indices)
 
         if self.verbose: 
             pbar.set_description('Done')
             pbar.close()
 
+    def __use_result_cache(self):
+        return self.result_cache != NULL and not self.save_history and self.history_file is None
+
+    def __fit_params(self):
+        '''
+            Parameters the result of a fit depends on besides the input data and 
+            the initial population, in a stable text form for the result cache.
+        '''
+        return repr((
+            self.num_runs, self.num_gens, self.popsize, self.starting_length, self.p_xo, 
+            self.p_product_mut, self.p_plus_batch_mut, self.p_minus_batch_mut, self.p_gene_swap, 
+            self.random_state, self.heuristic_init, self.seeded_ratio, self.use_archive
+        )).encode()
+
+    def __seed_genes(self, population=None):
+        '''
+            Converts 'initial_population', or 'population' if given, into lists of 
+            (product number, batches) pairs. Campaigns of unknown products get product 
+            number 0 and are dropped when the chromosomes are created.
+        '''
+        if population is None:
+            population = self.initial_population
+
+        if not population:
+            return []
+
+        product_label_index_pairs = { label: index + 1 for index, label in enumerate(self.product_labels) }
+        seed_genes = []
+
+        for seed in population:
+            if isinstance(seed, pd.core.frame.DataFrame):
+                campaigns = zip(seed.Product, seed.Batches)
+            elif isinstance(seed, ScheduleArrays):
+                campaigns = [
+                    (self.product_labels[product_num - 1], num_batches) 
+                    for product_num, num_batches in zip(seed.campaigns['product_num'], seed.campaigns['num_batches'])
+                ]
+            elif hasattr(seed, 'campaigns'):
+                campaigns = zip(seed.campaigns.Product, seed.campaigns.Batches)
+            else:
+                campaigns = seed
+
+            seed_genes.append([
+                (product_label_index_pairs.get(product, 0), int(num_batches)) 
+                for product, num_batches in campaigns
+            ])
+
+        return seed_genes
+
+    def create_schedules(self, campaigns_list: list, schedules: bool=False):
+        '''
+            Evaluates many campaign tables at once, decoding them in parallel without 
+            the GIL, e.g. candidate plans of a planner. Each item is either a schedule 
+            or a campaigns table with 'Product' and 'Batches' columns. Returns a DataFrame 
+            with every objective in AVAILABLE_OBJECTIVES per table, or the schedules 
+            in the 'output' format if 'schedules' is True.
+        '''
+        cdef:
+            vector[NSGAChromosome[SingleSiteSimpleGene]] solutions
+            vector[vector[double]] objectives
+            vector[ScheduleRecords*] records
+            ScheduleArrays arrays
+
+        genes_list = self.__seed_genes(campaigns_list)
+        solutions.resize(len(genes_list))
+
+        for i, genes in enumerate(genes_list):
+            solutions[i].genes.resize(len(genes))
+
+            for j, (product_num, num_batches) in enumerate(genes):
+                assert product_num, "Campaigns table {} has an unknown product.".format(i)
+                solutions[i].genes[j].product_num = GeneField(product_num)
+                solutions[i].genes[j].num_batches = GeneField(num_batches)
+
+        if schedules:
+            schedules_list = [ScheduleArrays() for _ in range(solutions.size())]
+
+            for arrays in schedules_list:
+                records.push_back(&arrays.records)
+
+            with nogil:
+                CreateRecords[SingleSiteSimpleSchedule, SingleSiteSimpleModel, NSGAChromosome[SingleSiteSimpleGene]](
+                    self.single_site_simple, 
+                    solutions, 
+                    records,
+                    self.num_threads
+                )
+
+            return [self.__output(arrays) for arrays in schedules_list]
+
+        with nogil:
+            EvaluateObjectives[SingleSiteSimpleSchedule, SingleSiteSimpleModel, NSGAChromosome[SingleSiteSimpleGene]](
+                self.single_site_simple, 
+                solutions, 
+                objectives,
+                self.num_threads
+            )
+
+        return pd.DataFrame(OrderedDict([
+            (obj, [values[self.objectives[obj]] for values in objectives]) for obj in self.AVAILABLE_OBJECTIVES
+        ]))
+
     def create_schedule(self, campaigns: pd.core.frame.DataFrame):
         cdef:
             SingleSiteSimpleSchedule schedule
@@ -625,138 +1198,259 @@ cdef class DetSingleSiteSimple:
         solution.genes.resize(len(campaigns))
 
         for i in range(len(campaigns)):
-            solution.genes[i].product_num = product_label_index_pairs[campaigns.Product[i]]
-            solution.genes[i].num_batches = campaigns.Batches[i]
+            solution.genes[i].product_num = GeneField(product_label_index_pairs[campaigns.Product[i]])
+            solution.genes[i].num_batches = GeneField(campaigns.Batches[i])
 
         schedule = SingleSiteSimpleSchedule()
         self.single_site_simple.CreateSchedule(solution, schedule)
-        return self.__make_pyschedule(schedule)
+        return self.__output(self.__make_records(schedule))
         
-    cdef __make_pyschedule(self, SingleSiteSimpleSchedule &schedule):
-        def get_date_of(delta):
-            return pd.Timedelta('%d days' % delta) + pd.to_datetime(self.start_date).date()
+    def __objectives_order(self):
+        '''
+            Positions of the 'objectives' passed to 'fit' in NSGAChromosome objectives,
+            which follow the order of the objectives in the input data.
+        '''
+        model_objectives = self.input_data.objectives
+        model_objectives = [obj for obj, _ in model_objectives]
+        return [model_objectives.index(self.objectives[obj]) for obj, _ in self.objectives_coefficients_list]
 
-        campaigns_table = []
-        batches_table = []
-        tasks_table = []
-        
-        for campaign in schedule.campaigns: 
-            campaigns_table.append(OrderedDict([
-                ('Product', self.product_labels[campaign.product_num - 1]),
-                ('Batches', campaign.num_batches),
-                ('Kg', campaign.kg),
-                ('Start', get_date_of(campaign.start)),
-                ('First Harvest', get_date_of(campaign.first_harvest)),
-                ('First Batch', get_date_of(campaign.first_batch)),
-                ('Last Batch', get_date_of(campaign.last_batch))
-            ])) 
-
-            for batch in campaign.batches:
-                batches_table.append(OrderedDict([
-                    ('Product', self.product_labels[batch.product_num - 1]),
-                    ('Kg', batch.kg),
-                    ('Start', get_date_of(batch.start)),
-                    ('Harvested on', get_date_of(batch.harvested_at)),
-                    ('Stored on', get_date_of(batch.stored_at)),
-                    ('Expires on', get_date_of(batch.expires_at)),
-                    ('Approved on', get_date_of(batch.approved_at))
-                ]))
-
-                tasks_table.append(OrderedDict([
-                    ('Product', self.product_labels[campaign.product_num - 1]),
-                    ('Task', 'Inoculation'),
-                    ('Start', batches_table[-1]['Start']),
-                    (
-                        'Finish', 
-                        batches_table[-1]['Start'] + pd.Timedelta(
-                            '%d days' % 
-                            self.input_data.inoculation_days[batch.product_num - 1]
-                        )
-                    )
-                ]))
-
-                tasks_table.append(OrderedDict([
-                    ('Product', self.product_labels[campaign.product_num - 1]),
-                    ('Task', 'Seed'),
-                    ('Start', tasks_table[-1]['Finish']),
-                    (
-                        'Finish', 
-                        tasks_table[-1]['Finish'] + pd.Timedelta(
-                            '%d days' % 
-                            self.input_data.seed_days[batch.product_num - 1]
-                        )
-                    )                
-                ]))
-
-                tasks_table.append(OrderedDict([
-                    ('Product', self.product_labels[campaign.product_num - 1]),
-                    ('Task', 'Production'),
-                    ('Start', tasks_table[-1]['Finish']),
-                    (
-                        'Finish', 
-                        tasks_table[-1]['Finish'] + pd.Timedelta(
-                            '%d days' % 
-                            self.input_data.production_days[batch.product_num - 1]
-                        )
-                    )                
-                ]))
-
-                tasks_table.append(OrderedDict([
-                    ('Product', self.product_labels[campaign.product_num - 1]),
-                    ('Task', 'DSP'),
-                    ('Start', tasks_table[-1]['Finish']),
-                    (
-                        'Finish', 
-                        tasks_table[-1]['Finish'] + pd.Timedelta(
-                            '%d days' % 
-                            self.input_data.dsp_days[batch.product_num - 1]
-                        )
-                    )                
-                ]))
-
-        kg_inventory = []
-        kg_backlog = []
-        kg_supply = [] 
-        kg_waste = []
-
-        for i, due_date in enumerate(self.due_dates):
-            kg_inventory.append({
-                product_label: schedule.kg_inventory[j][i] 
-                for j, product_label in enumerate(self.product_labels)
-            })
-
-            kg_backlog.append({
-                product_label: schedule.kg_backlog[j][i] 
-                for j, product_label in enumerate(self.product_labels)
-            })
-            
-            kg_supply.append({
-                product_label: schedule.kg_supply[j][i] 
-                for j, product_label in enumerate(self.product_labels)
-            })
+    def __objective_names(self):
+        '''
+            Names of the objectives in the order of NSGAChromosome objectives.
+        '''
+        names = { value: name for name, value in self.objectives.items() }
+        model_objectives = self.input_data.objectives
+        return [names[obj].encode() for obj, _ in model_objectives]
+
+    def __clear_solutions(self):
+        self.solution_genes.clear()
+        self.points.clear()
+        self.cache.clear()
+        self.num_fits += 1
+
+    cdef size_t __store_solution(self, vector[SingleSiteSimpleGene] &genes, vector[double] point):
+        '''
+            Keeps the genes and the objective values of the solution, converted for 
+            minimisation like NSGAChromosome objectives, for decoding it on demand. 
+            Returns the index of the solution.
+        '''
+        self.solution_genes.push_back(genes)
+        self.points.push_back(point)
+        return self.solution_genes.size() - 1
+
+    def __make_sequence(self, indices):
+        objectives = pd.DataFrame(
+            [[-coef * self.points[index][k] for k, (_, coef) in enumerate(self.objectives_coefficients_list)] for index in indices],
+            columns=[obj for obj, _ in self.objectives_coefficients_list]
+        )
+        return ScheduleSequence(self.__schedule, [(self.num_fits, index) for index in indices], objectives)
+
+    cdef ScheduleArrays __decode(self, size_t index):
+        cdef:
+            SingleSiteSimpleSchedule schedule
+            NSGAChromosome[SingleSiteSimpleGene] solution
+
+        solution.genes = self.solution_genes[index]
+        self.single_site_simple.CreateSchedule(solution, schedule)
+        return self.__make_records(schedule)
+
+    def __schedule(self, key):
+        '''
+            Decodes the solution into a schedule in the 'output' format, or returns 
+            it from the cache of the most recently accessed schedules.
+        '''
+        num_fits, index = key
+        assert num_fits == self.num_fits, "The schedule is from a previous 'fit' and can no longer be decoded."
+
+        if index in self.cache:
+            self.cache.move_to_end(index)
+            return self.cache[index]
+
+        self.cache[index] = self.__output(self.__decode(index))
+
+        if len(self.cache) > self.cache_size:
+            self.cache.popitem(last=False)
+
+        return self.cache[index]
 
-            kg_waste.append({
-                product_label: schedule.kg_waste[j][i] 
-                for j, product_label in enumerate(self.product_labels)
-            })
+    def __to_point(self, point):
+        '''
+            Converts a schedule or a dictionary of objective name and value pairs 
+            into a point of the front.
+        '''
+        if isinstance(point, ScheduleArrays):
+            return [point.objectives[self.objectives[obj]] * coef * -1 for obj, coef in self.objectives_coefficients_list]
+
+        if hasattr(point, 'objectives'):
+            return [point.objectives[obj].values[0] * coef * -1 for obj, coef in self.objectives_coefficients_list]
+
+        return [point[obj] * coef * -1 for obj, coef in self.objectives_coefficients_list]
+
+    def hypervolume(self, ref_point: dict=None, ideal_point: dict=None):
+        '''
+            Exact hypervolume of the top non-dominated front, computed natively over the 
+            objective values of the 'schedules'. See 'biopharma_scheduling.utils.hypervolume' 
+            for the description of 'ref_point' and 'ideal_point'.
+        '''
+        assert not self.front.empty(), "Call 'fit' first"
+
+        cdef:
+            vector[double] ref
+            vector[vector[double]] ideal
+            double hv
+            size_t i, m
+
+        if ref_point is not None:
+            ref = self.__to_point(ref_point)
+        else:
+            ref = self.front[0]
+            for i in range(self.front.size()):
+                for m in range(ref.size()):
+                    ref[m] = max(ref[m], self.front[i][m])
+            for m in range(ref.size()):
+                ref[m] += 1
+
+        with nogil:
+            hv = Hypervolume[vector[vector[double]]](self.front, ref)
+
+        if ideal_point is not None:
+            ideal.push_back(self.__to_point(ideal_point))
+            hv /= Hypervolume[vector[vector[double]]](ideal, ref)
+
+        return hv
+
+    def igd(self, reference_front: list, plus: bool=False):
+        '''
+            Inverted generational distance of the top non-dominated front from the 
+            'reference_front', or IGD+ if 'plus' is True. 'reference_front' is a list 
+            of schedules or of dictionaries of objective name and value pairs.
+        '''
+        assert not self.front.empty(), "Call 'fit' first"
+
+        cdef:
+            vector[vector[double]] reference_points = [self.__to_point(point) for point in reference_front]
+            bint igd_plus = plus
+            double value
+
+        with nogil:
+            value = IGD[vector[vector[double]], vector[vector[double]]](self.front, reference_points, igd_plus)
+
+        return value
+
+    def epsilon(self, reference_front: list):
+        '''
+            Additive epsilon indicator of the top non-dominated front with respect to 
+            the 'reference_front', see 'igd'.
+        '''
+        assert not self.front.empty(), "Call 'fit' first"
+
+        cdef:
+            vector[vector[double]] reference_points = [self.__to_point(point) for point in reference_front]
+            double value
 
-            kg_inventory[-1].update({'date': due_date})
-            kg_backlog[-1].update({'date': due_date})
-            kg_supply[-1].update({'date': due_date})
-            kg_waste[-1].update({'date': due_date})
+        with nogil:
+            value = Epsilon[vector[vector[double]], vector[vector[double]]](self.front, reference_points)
+
+        return value
+
+    def spread(self, reference_front: list=None):
+        '''
+            Generalised spread of the top non-dominated front. The extreme points are 
+            taken from the 'reference_front' if one is given, see 'igd'.
+        '''
+        assert not self.front.empty(), "Call 'fit' first"
+
+        cdef:
+            vector[vector[double]] reference_points
+            double value
+
+        if reference_front is not None:
+            reference_points = [self.__to_point(point) for point in reference_front]
+
+        with nogil:
+            value = Spread[vector[vector[double]], vector[vector[double]]](self.front, reference_points)
+
+        return value
+
+    cdef ScheduleArrays __make_records(self, SingleSiteSimpleSchedule &schedule):
+        cdef ScheduleArrays arrays = ScheduleArrays()
+        MakeRecords(schedule, arrays.records)
+        return arrays
+
+    def __output(self, schedules):
+        '''
+            Returns the schedule records in the 'output' format.
+        '''
+        if self.output == 'numpy':
+            return schedules
+
+        if schedules.pyschedule is None:
+            schedules.pyschedule = self.__make_pyschedule(schedules)
+
+        return schedules.pyschedule
+
+    cdef __make_pyschedule(self, ScheduleArrays arrays):
+        start_date = pd.to_datetime(self.start_date)
+        product_labels = np.asarray(self.product_labels, dtype=object)
+        campaigns = arrays.campaigns
+        batches = arrays.batches
+
+        def get_dates_of(deltas):
+            return start_date + pd.to_timedelta(deltas.astype(int), unit='D')
+
+        def get_table_of(grid):
+            table = pd.DataFrame(np.array(grid.T), columns=self.product_labels)
+            table['date'] = self.due_dates
+            return table
+
+        campaigns_table = pd.DataFrame(OrderedDict([
+            ('Product', product_labels[campaigns['product_num'] - 1]),
+            ('Batches', campaigns['num_batches']),
+            ('Kg', campaigns['kg']),
+            ('Start', get_dates_of(campaigns['start'])),
+            ('First Harvest', get_dates_of(campaigns['first_harvest'])),
+            ('First Batch', get_dates_of(campaigns['first_batch'])),
+            ('Last Batch', get_dates_of(campaigns['last_batch']))
+        ]))
+
+        batches_table = pd.DataFrame(OrderedDict([
+            ('Product', product_labels[batches['product_num'] - 1]),
+            ('Kg', batches['kg']),
+            ('Start', get_dates_of(batches['start'])),
+            ('Harvested on', get_dates_of(batches['harvested_at'])),
+            ('Stored on', get_dates_of(batches['stored_at'])),
+            ('Expires on', get_dates_of(batches['expires_at'])),
+            ('Approved on', get_dates_of(batches['approved_at']))
+        ]))
+
+        # Inoculation, seed, production and DSP of each batch run back to back
+        task_deltas = np.cumsum(np.stack([
+            batches['start'].astype(int),
+            np.asarray(self.input_data.inoculation_days)[batches['product_num'] - 1],
+            np.asarray(self.input_data.seed_days)[batches['product_num'] - 1],
+            np.asarray(self.input_data.production_days)[batches['product_num'] - 1],
+            np.asarray(self.input_data.dsp_days)[batches['product_num'] - 1]
+        ], axis=1), axis=1)
+
+        tasks_table = pd.DataFrame(OrderedDict([
+            ('Product', np.repeat(product_labels[batches['product_num'] - 1], 4)),
+            ('Task', np.tile(['Inoculation', 'Seed', 'Production', 'DSP'], len(batches))),
+            ('Start', get_dates_of(task_deltas[:, :-1].ravel())),
+            ('Finish', get_dates_of(task_deltas[:, 1:].ravel()))
+        ]))
 
         return PySingleSiteSimpleSchedule(
             objectives={
-                obj: schedule.objectives[self.objectives[obj]] 
+                obj: arrays.objectives[self.objectives[obj]] 
                 for obj in self.AVAILABLE_OBJECTIVES
             }, 
             campaigns_table=campaigns_table,
             batches_table=batches_table,
             tasks_table=tasks_table,
-            kg_inventory=kg_inventory,
-            kg_backlog=kg_backlog,
-            kg_supply=kg_supply,
-            kg_waste=kg_waste
+            kg_inventory=get_table_of(arrays.inventory),
+            kg_backlog=get_table_of(arrays.backlog),
+            kg_supply=get_table_of(arrays.supply),
+            kg_waste=get_table_of(arrays.waste)
         )
 
     @property
@@ -767,19 +1461,40 @@ cdef class DetSingleSiteSimple:
     def history(self):
         return self.history
 
+    @property
+    def population(self):
+        '''
+            Campaigns tables of the final population of the last run. Can be passed 
+            as 'initial_population' to continue the search.
+        '''
+        return [
+            pd.DataFrame.from_records(genes, columns=['Product', 'Batches']) 
+            for genes in self.population
+        ]
+
 
 cdef class DetSingleSiteMultiSuite:
     cdef:
         SingleSiteMultiSuiteInputData input_data
         SingleSiteMultiSuiteModel single_site_multi_suite
 
+        vector[vector[double]] front
+        vector[vector[double]] points
+        vector[vector[SingleSiteMultiSuiteGene]] solution_genes
+
         object history
         object schedules
         object start_date
         object product_labels
         object due_dates
         object objectives
+        object initial_population
+        object population
         object objectives_coefficients_list
+        object output
+        object cache
+        object history_file
+        ResultCache *result_cache
 
         int num_runs
         int num_gens
@@ -792,6 +1507,10 @@ cdef class DetSingleSiteMultiSuite:
         int random_state
         int verbose
         int save_history
+        int heuristic_init
+        int use_archive
+        int cache_size
+        int num_fits
 
         double p_xo
         double p_product_mut
@@ -799,6 +1518,7 @@ cdef class DetSingleSiteMultiSuite:
         double p_plus_batch_mut
         double p_minus_batch_mut
         double p_gene_swap
+        double seeded_ratio
 
     AVAILABLE_OBJECTIVES = {
         'total_batch_throughput',
@@ -832,6 +1552,14 @@ cdef class DetSingleSiteMultiSuite:
         random_state: int=None,
         verbose: bool=False,
         save_history: bool=False,
+        heuristic_init: bool=False,
+        seeded_ratio: float=0.5,
+        use_archive: bool=False,
+        output: str='pandas',
+        cache_size: int=100,
+        history_file: str=None,
+        result_cache_dir: str=None,
+        result_cache_size_mb: int=256,
     ):
         assert num_runs >= 1, "'num_runs' must be a positive integer number." 
         self.num_runs = num_runs
@@ -866,9 +1594,8 @@ cdef class DetSingleSiteMultiSuite:
         assert type(num_threads) is int, "'num_threads must be an integer number."
         self.num_threads = num_threads
         
-        if random_state is not None:
-            assert type(random_state) is int, "'random_state' must be an integer number"
-            self.random_state = random_state if random_state else -1
+        assert random_state is None or type(random_state) is int, "'random_state' must be an integer number"
+        self.random_state = random_state if random_state is not None else -1
 
         assert type(verbose) is bool, "'verbose' must have a bool value" 
         self.verbose = verbose
@@ -876,6 +1603,31 @@ cdef class DetSingleSiteMultiSuite:
         assert type(save_history) is bool, "'save_history' must have a bool value" 
         self.save_history = save_history
 
+        assert type(heuristic_init) is bool, "'heuristic_init' must have a bool value" 
+        self.heuristic_init = heuristic_init
+
+        assert seeded_ratio >= 0.0 and seeded_ratio <= 1.0, "'seeded_ratio' must be a positive floating point number in range [0.0 - 1.0]."
+        self.seeded_ratio = seeded_ratio
+
+        assert type(use_archive) is bool, "'use_archive' must have a bool value" 
+        self.use_archive = use_archive
+
+        assert output in ('pandas', 'numpy'), "'output' must be either 'pandas' or 'numpy'"
+        self.output = output
+
+        assert cache_size >= 1, "'cache_size' must be a positive integer number." 
+        self.cache_size = cache_size
+        self.cache = OrderedDict()
+
+        assert history_file is None or type(history_file) is str, "'history_file' must be a 'str'"
+        self.history_file = history_file
+
+        if result_cache_dir is not None:
+            assert type(result_cache_dir) is str, "'result_cache_dir' must be a 'str'"
+            assert self.random_state != -1, "'result_cache_dir' requires a fixed 'random_state'."
+            assert result_cache_size_mb >= 1, "'result_cache_size_mb' must be a positive integer number."
+            self.result_cache = new ResultCache(result_cache_dir.encode(), result_cache_size_mb << 20)
+
         self.objectives = {
             'total_batch_throughput': OBJECTIVES.TOTAL_BATCH_THROUGHPUT,
             'total_batch_backlog': OBJECTIVES.TOTAL_BATCH_BACKLOG,
@@ -892,6 +1644,9 @@ cdef class DetSingleSiteMultiSuite:
             'total_cost': OBJECTIVES.TOTAL_COST
         }
 
+    def __dealloc__(self):
+        del self.result_cache
+
     def fit(
         self,
         start_date: str,
@@ -903,6 +1658,7 @@ cdef class DetSingleSiteMultiSuite:
         usp_changeover_days: pd.core.frame.DataFrame,
         dsp_changeover_days: pd.core.frame.DataFrame,
         constraints: dict=None,
+        initial_population: list=None,
     ):
         self.__validate_input(
             objectives,
@@ -960,7 +1716,65 @@ cdef class DetSingleSiteMultiSuite:
             &cpp_constraints if constraints is not None else NULL 
         )
 
+        return self.__solve(objectives, initial_population)
+
+    def fit_csv(
+        self,
+        data_dir: str,
+        start_date: str,
+        objectives: dict,
+        num_usp_suites: int,
+        num_dsp_suites: int,
+        constraints: dict=None,
+        initial_population: list=None,
+    ):
+        '''
+            Same as 'fit', but reads the input data from 'batch_demand.csv', 'product_data.csv',
+            'usp_changeover_days.csv' and 'dsp_changeover_days.csv' CSV files
+            in 'data_dir', i.e. in the layout of the 'examples/data' directories. The files are
+            parsed and validated natively without building DataFrames, which is faster for large
+            instances. Raises RuntimeError with the file and line of the first invalid entry.
+        '''
+        self.__validate_objectives(objectives, constraints)
+
+        cdef:
+            pair[int, double] p
+            unordered_map[OBJECTIVES, int] cpp_objectives
+            unordered_map[OBJECTIVES, pair[int, double]] cpp_constraints
+            SingleSiteMultiSuiteInstance instance
+
+        for obj, coef in objectives.items():
+            cpp_objectives[self.objectives[obj]] = coef
+
+        if constraints:
+            for cons, [coef, bound] in constraints.items():
+                p.first = coef
+                p.second = bound
+                cpp_constraints[self.objectives[cons]] = p 
+
+        instance = LoadSingleSiteMultiSuite(
+            data_dir.encode(),
+            start_date.encode(),
+            cpp_objectives,
+            num_usp_suites,
+            num_dsp_suites,
+            &cpp_constraints if constraints is not None else NULL
+        )
+
+        self.product_labels = [label.decode() for label in instance.product_labels]
+        self.num_products = len(self.product_labels)
+        self.start_date = start_date
+        self.due_dates = [date.decode() for date in instance.due_dates]
+        self.num_usp_suites = num_usp_suites
+        self.num_dsp_suites = num_dsp_suites
+        self.input_data = instance.input_data
+
+        return self.__solve(objectives, initial_population)
+
+    def __solve(self, objectives: dict, initial_population: list):
         self.single_site_multi_suite = SingleSiteMultiSuiteModel(self.input_data)
+        self.initial_population = initial_population
+        self.objectives_coefficients_list = list(objectives.items())
 
         if len(objectives) == 1:
             self.__run_single_objective_ga()
@@ -978,17 +1792,7 @@ cdef class DetSingleSiteMultiSuite:
         usp_changeover_days: pd.core.frame.DataFrame,
         dsp_changeover_days: pd.core.frame.DataFrame
     ):
-        assert type(objectives) is dict, "'objectives' must be a 'dict', is a '{}'.".format(type(objectives))
-        for obj in objectives:
-            assert obj in self.AVAILABLE_OBJECTIVES, "'{}' is not allowed as an objective.".format(obj)
-            assert objectives[obj] in [-1, 1], "Objective coefficient can only be -1 or 1."
-
-        if constraints is not None:
-            assert type(constraints) is dict, "'constraints' must be a 'dict', is a '{}'.".format(type(constraints))
-            for cons in constraints:
-                assert cons in self.AVAILABLE_OBJECTIVES, "'{}' is not allowed as a constraint.".format(cons)
-                assert type(constraints[cons]) is list and len(constraints[cons]) == 2, "'constraints' are expected to hold a coeffcient and a bound."
-                assert constraints[cons][0] in [-1, 1], "Constraint coefficient can only be -1 or 1."
+        self.__validate_objectives(objectives, constraints)
 
         for df in [batch_demand, product_data, usp_changeover_days, dsp_changeover_days]:
             assert type(df) is pd.core.frame.DataFrame, "Input data must be a 'pd.core.frame.DataFrame', is a '{}'".format(type(df))
@@ -1039,6 +1843,19 @@ cdef class DetSingleSiteMultiSuite:
                "Product labels in 'product' column do not match with the actual product columns in 'dsp_changeover_days_product_columns'."
 
 
+    def __validate_objectives(self, objectives: dict, constraints: dict):
+        assert type(objectives) is dict, "'objectives' must be a 'dict', is a '{}'.".format(type(objectives))
+        for obj in objectives:
+            assert obj in self.AVAILABLE_OBJECTIVES, "'{}' is not allowed as an objective.".format(obj)
+            assert objectives[obj] in [-1, 1], "Objective coefficient can only be -1 or 1."
+
+        if constraints is not None:
+            assert type(constraints) is dict, "'constraints' must be a 'dict', is a '{}'.".format(type(constraints))
+            for cons in constraints:
+                assert cons in self.AVAILABLE_OBJECTIVES, "'{}' is not allowed as a constraint.".format(cons)
+                assert type(constraints[cons]) is list and len(constraints[cons]) == 2, "'constraints' are expected to hold a coeffcient and a bound."
+                assert constraints[cons][0] in [-1, 1], "Constraint coefficient can only be -1 or 1."
+
     def __count_days(self, start_date: str, due_dates: list):
         self.start_date = start_date
         self.due_dates = due_dates
@@ -1054,9 +1871,12 @@ cdef class DetSingleSiteMultiSuite:
 
     def __run_single_objective_ga(self):
         cdef:
-            SingleSiteMultiSuiteSchedule schedule
-            SingleObjectiveChromosome[SingleSiteMultiSuiteGene] top_solution
-            vector[SingleObjectiveChromosome[SingleSiteMultiSuiteGene]] solutions 
+            vector[SingleObjectiveChromosome[SingleSiteMultiSuiteGene]] top_front
+            HistoryWriter[SingleObjectiveChromosome[SingleSiteMultiSuiteGene]] *history_writer = NULL
+            SingleObjectiveChromosome[SingleSiteMultiSuiteGene] top_solution, seed
+            vector[SingleObjectiveChromosome[SingleSiteMultiSuiteGene]] solutions, seeds, parents
+            string key
+            vector[SingleObjectiveChromosome[SingleSiteMultiSuiteGene]] heuristic_seeds
             
             SingleObjectiveGA[SingleObjectiveChromosome[SingleSiteMultiSuiteGene], SingleSiteMultiSuiteModel] ga = \
             SingleObjectiveGA[SingleObjectiveChromosome[SingleSiteMultiSuiteGene], SingleSiteMultiSuiteModel](
@@ -1065,52 +1885,116 @@ cdef class DetSingleSiteMultiSuite:
                 self.num_threads   
             )
 
+        for genes in self.__seed_genes():
+            seed.genes.resize(len(genes))
+            for i, (product_num, usp_suite_num, num_batches) in enumerate(genes):
+                seed.genes[i].product_num = GeneField(product_num)
+                seed.genes[i].usp_suite_num = GeneField(usp_suite_num)
+                seed.genes[i].num_batches = GeneField(num_batches)
+            seeds.push_back(seed)
+
+        if self.heuristic_init:
+            heuristic_seeds = Seeds[SingleObjectiveChromosome[SingleSiteMultiSuiteGene]](self.input_data)
+            seeds.insert(seeds.end(), heuristic_seeds.begin(), heuristic_seeds.end())
+
+        ga.SetSeededRatio(self.seeded_ratio)
+
+        cached = False
+
+        if self.__use_result_cache():
+            key = FitKey[SingleSiteMultiSuiteInputData, SingleObjectiveChromosome[SingleSiteMultiSuiteGene]](self.input_data, self.__fit_params(), seeds)
+            cached = self.result_cache.Load[SingleObjectiveChromosome[SingleSiteMultiSuiteGene]](key, solutions, parents)
+
         if self.verbose: 
             pbar = tqdm(total=self.num_runs * self.num_gens)
 
-        for run in range(self.num_runs):
-            if self.verbose: 
-                pbar.set_description('GA is running %d/%d' % (run + 1, self.num_runs))
-
-            ga.Init(
-                self.popsize,
-                self.starting_length,
-                self.p_xo,
-                self.p_gene_swap,
-                self.num_products,
-                self.num_usp_suites,
-                self.p_product_mut,
-                self.p_usp_suite_mut,
-                self.p_plus_batch_mut,
-                self.p_minus_batch_mut,
-            )
-
-            for gen in range(self.num_gens):
-                ga.Update()
+        if self.history_file is not None:
+            history_writer = new HistoryWriter[SingleObjectiveChromosome[SingleSiteMultiSuiteGene]](self.history_file.encode(), self.__objective_names())
 
+        try:
+            for run in range(0 if cached else self.num_runs):
                 if self.verbose: 
-                    pbar.update()
+                    pbar.set_description('GA is running %d/%d' % (run + 1, self.num_runs))
+
+                if seeds.empty():
+                    ga.Init(
+                        self.popsize,
+                        self.starting_length,
+                        self.p_xo,
+                        self.p_gene_swap,
+                        self.num_products,
+                        self.num_usp_suites,
+                        self.p_product_mut,
+                        self.p_usp_suite_mut,
+                        self.p_plus_batch_mut,
+                        self.p_minus_batch_mut,
+                    )
+                else:
+                    ga.Init(
+                        self.popsize,
+                        seeds,
+                        self.starting_length,
+                        self.p_xo,
+                        self.p_gene_swap,
+                        self.num_products,
+                        self.num_usp_suites,
+                        self.p_product_mut,
+                        self.p_usp_suite_mut,
+                        self.p_plus_batch_mut,
+                        self.p_minus_batch_mut,
+                    )
+
+                for gen in range(self.num_gens):
+                    ga.Update()
+
+                    if history_writer != NULL:
+                        top_front.assign(1, ga.Top())
+                        history_writer.Write(run, gen, top_front)
+
+                    if self.verbose: 
+                        pbar.update()
+
+                top_solution = ga.Top()
+                solutions.push_back(top_solution)
+        finally:
+            del history_writer
 
-            top_solution = ga.Top()
-            solutions.push_back(top_solution)
+        if not cached:
+            parents = ga.Parents()
+
+        self.population = []
+        for solution in parents:
+            self.population.append([
+                (
+                    self.product_labels[solution.genes[i].product_num - 1], 
+                    'USP%d' % solution.genes[i].usp_suite_num, 
+                    solution.genes[i].num_batches
+                ) 
+                for i in range(solution.genes.size())
+            ])
 
         if self.verbose and self.save_history:
             pbar.set_description('Processing history')
 
+        self.__clear_solutions()
+
         if self.save_history:
-            self.history = []
+            indices = []
             for solution in solutions:
-                schedule = SingleSiteMultiSuiteSchedule()
-                self.single_site_multi_suite.CreateSchedule(solution, schedule)
-                self.history.append(self.__make_pyschedule(schedule))
+                indices.append(self.__store_solution(solution.genes, [solution.objective]))
+            self.history = self.__make_sequence(indices)
 
         if self.verbose:
             pbar.set_description('Collecting schedules')
 
         top_solution = ga.Top(solutions)
-        schedule = SingleSiteMultiSuiteSchedule()
-        self.single_site_multi_suite.CreateSchedule(top_solution, schedule)
-        self.schedules = [self.__make_pyschedule(schedule)]
+
+        if not cached and self.__use_result_cache():
+            solutions.assign(1, top_solution)
+            self.result_cache.Store[SingleObjectiveChromosome[SingleSiteMultiSuiteGene]](key, solutions, parents)
+        self.schedules = self.__make_sequence([self.__store_solution(top_solution.genes, [top_solution.objective])])
+        self.front.clear()
+        self.front.push_back(self.points.back())
 
         if self.verbose: 
             pbar.set_description('Done')
@@ -1118,8 +2002,11 @@ cdef class DetSingleSiteMultiSuite:
 
     def __run_nsgaii(self):
         cdef:
-            SingleSiteMultiSuiteSchedule schedule
-            vector[NSGAChromosome[SingleSiteMultiSuiteGene]] solutions
+            HistoryWriter[NSGAChromosome[SingleSiteMultiSuiteGene]] *history_writer = NULL
+            NSGAChromosome[SingleSiteMultiSuiteGene] seed
+            vector[NSGAChromosome[SingleSiteMultiSuiteGene]] solutions, seeds, parents
+            string key
+            vector[NSGAChromosome[SingleSiteMultiSuiteGene]] heuristic_seeds
             vector[NSGAChromosome[SingleSiteMultiSuiteGene]] top_front
             vector[vector[NSGAChromosome[SingleSiteMultiSuiteGene]]] history
             
@@ -1130,132 +2017,480 @@ cdef class DetSingleSiteMultiSuite:
                 self.num_threads   
             )
 
+        for genes in self.__seed_genes():
+            seed.genes.resize(len(genes))
+            for i, (product_num, usp_suite_num, num_batches) in enumerate(genes):
+                seed.genes[i].product_num = GeneField(product_num)
+                seed.genes[i].usp_suite_num = GeneField(usp_suite_num)
+                seed.genes[i].num_batches = GeneField(num_batches)
+            seeds.push_back(seed)
+
+        if self.heuristic_init:
+            heuristic_seeds = Seeds[NSGAChromosome[SingleSiteMultiSuiteGene]](self.input_data)
+            seeds.insert(seeds.end(), heuristic_seeds.begin(), heuristic_seeds.end())
+
+        nsgaii.SetSeededRatio(self.seeded_ratio)
+        nsgaii.UseArchive(self.use_archive)
+
+        cached = False
+
+        if self.__use_result_cache():
+            key = FitKey[SingleSiteMultiSuiteInputData, NSGAChromosome[SingleSiteMultiSuiteGene]](self.input_data, self.__fit_params(), seeds)
+            cached = self.result_cache.Load[NSGAChromosome[SingleSiteMultiSuiteGene]](key, solutions, parents)
+
         if self.verbose: 
             pbar = tqdm(total=self.num_runs * self.num_gens)
 
-        for run in range(self.num_runs):
-            if self.verbose: 
-                pbar.set_description('GA is running %d/%d' % (run + 1, self.num_runs))
-
-            nsgaii.Init(
-                self.popsize,
-                self.starting_length,
-                self.p_xo,
-                self.p_gene_swap,
-                self.num_products,
-                self.num_usp_suites,
-                self.p_product_mut,
-                self.p_usp_suite_mut,
-                self.p_plus_batch_mut,
-                self.p_minus_batch_mut,
-            )
-
-            for gen in range(self.num_gens):
-                nsgaii.Update()
+        if self.history_file is not None:
+            history_writer = new HistoryWriter[NSGAChromosome[SingleSiteMultiSuiteGene]](self.history_file.encode(), self.__objective_names())
 
+        try:
+            for run in range(0 if cached else self.num_runs):
                 if self.verbose: 
-                    pbar.update()
+                    pbar.set_description('GA is running %d/%d' % (run + 1, self.num_runs))
+
+                if seeds.empty():
+                    nsgaii.Init(
+                        self.popsize,
+                        self.starting_length,
+                        self.p_xo,
+                        self.p_gene_swap,
+                        self.num_products,
+                        self.num_usp_suites,
+                        self.p_product_mut,
+                        self.p_usp_suite_mut,
+                        self.p_plus_batch_mut,
+                        self.p_minus_batch_mut,
+                    )
+                else:
+                    nsgaii.Init(
+                        self.popsize,
+                        seeds,
+                        self.starting_length,
+                        self.p_xo,
+                        self.p_gene_swap,
+                        self.num_products,
+                        self.num_usp_suites,
+                        self.p_product_mut,
+                        self.p_usp_suite_mut,
+                        self.p_plus_batch_mut,
+                        self.p_minus_batch_mut,
+                    )
+
+                for gen in range(self.num_gens):
+                    nsgaii.Update()
+
+                    if history_writer != NULL:
+                        top_front = nsgaii.TopFront()
+                        history_writer.Write(run, gen, top_front)
+
+                    if self.verbose: 
+                        pbar.update()
+
+                # TopFront moves the front out, i.e. it is already in 'top_front' if written to the history
+                if history_writer == NULL:
+                    top_front = nsgaii.TopFront()
 
-            top_front = nsgaii.TopFront()
-            solutions.insert(solutions.end(), top_front.begin(), top_front.end())
+                solutions.insert(solutions.end(), top_front.begin(), top_front.end())
 
-            if self.save_history:
-                history.push_back(top_front)
+                if self.save_history:
+                    history.push_back(top_front)
+        finally:
+            del history_writer
+
+        if not cached:
+            parents = nsgaii.Parents()
+
+        self.population = []
+        for solution in parents:
+            self.population.append([
+                (
+                    self.product_labels[solution.genes[i].product_num - 1], 
+                    'USP%d' % solution.genes[i].usp_suite_num, 
+                    solution.genes[i].num_batches
+                ) 
+                for i in range(solution.genes.size())
+            ])
 
         if self.verbose and self.save_history:
             pbar.set_description('Processing history')
 
+        self.__clear_solutions()
+        order = self.__objectives_order()
+
         if self.save_history:
             self.history = []
             for front in history:
-                self.history.append([])
+                indices = []
                 for solution in front:
-                    schedule = SingleSiteMultiSuiteSchedule()
-                    self.single_site_multi_suite.CreateSchedule(solution, schedule)
-                    self.history[-1].append(self.__make_pyschedule(schedule))
+                    indices.append(self.__store_solution(solution.genes, [solution.objectives[i] for i in order]))
+                self.history.append(self.__make_sequence(indices))
 
         if self.verbose:
             pbar.set_description('Collecting schedules')
 
-        self.schedules = []
-        solutions = nsgaii.TopFront(solutions)
+        if not cached:
+            if self.use_archive:
+                solutions = nsgaii.Archive()
+            else:
+                solutions = nsgaii.TopFront(solutions)
+
+            if self.__use_result_cache():
+                self.result_cache.Store[NSGAChromosome[SingleSiteMultiSuiteGene]](key, solutions, parents)
+
+        indices = []
+        self.front.clear()
         for solution in solutions:
-            schedule = SingleSiteMultiSuiteSchedule()
-            self.single_site_multi_suite.CreateSchedule(solution, schedule)
-            self.schedules.append(self.__make_pyschedule(schedule))
+            indices.append(self.__store_solution(solution.genes, [solution.objectives[i] for i in order]))
+            self.front.push_back(self.points.back())
+        self.schedules = self.__make_sequence(indices)
 
         if self.verbose: 
             pbar.set_description('Done')
             pbar.close()
 
-    cdef __make_pyschedule(self, SingleSiteMultiSuiteSchedule &schedule):
-        def get_date_of(delta):
-            return pd.Timedelta('%d days' % delta) + pd.to_datetime(self.start_date).date()
-
-        campaigns_table = []
-        batches_table = []
-
-        for suite in schedule.suites: 
-            for campaign in suite:
-                campaigns_table.append(OrderedDict([
-                    ('Product', self.product_labels[campaign.product_num - 1]),
-                    ('Suite', 'USP%d' % campaign.suite_num if campaign.suite_num <= self.num_usp_suites else 'DSP%d' % (campaign.suite_num - self.num_usp_suites)),
-                    ('Batches', campaign.num_batches),
-                    ('Start', get_date_of(campaign.start)),
-                    ('End', get_date_of(campaign.end))
-                ])) 
-
-                for batch in campaign.batches:
-                    batches_table.append(OrderedDict([
-                        ('Product', self.product_labels[batch.product_num - 1]),
-                        ('Suite', 'USP%d' % campaign.suite_num if campaign.suite_num <= self.num_usp_suites else 'DSP%d' % (campaign.suite_num - self.num_usp_suites)),
-                        ('Start', get_date_of(batch.start)),
-                        ('Stored on', get_date_of(batch.stored_at)),
-                        ('Expires on', get_date_of(batch.expires_at)),
-                    ]))
-
-        batch_inventory = []
-        batch_backlog = []
-        batch_supply = []
-        batch_waste = []
-
-        for i, due_date in enumerate(self.due_dates):
-            batch_inventory.append({
-                product_label: schedule.batch_inventory[j][i] 
-                for j, product_label in enumerate(self.product_labels)
-            })
-
-            batch_backlog.append({
-                product_label: schedule.batch_backlog[j][i] 
-                for j, product_label in enumerate(self.product_labels)
-            })
-
-            batch_supply.append({
-                product_label: schedule.batch_supply[j][i] 
-                for j, product_label in enumerate(self.product_labels)
-            })
-
-            batch_waste.append({
-                product_label: schedule.batch_waste[j][i] 
-                for j, product_label in enumerate(self.product_labels)
-            })
-
-            batch_inventory[-1].update({'date': due_date})
-            batch_backlog[-1].update({'date': due_date})
-            batch_supply[-1].update({'date': due_date})
-            batch_waste[-1].update({'date': due_date})
+    def __use_result_cache(self):
+        return self.result_cache != NULL and not self.save_history and self.history_file is None
+
+    def __fit_params(self):
+        '''
+            Parameters the result of a fit depends on besides the input data and 
+            the initial population, in a stable text form for the result cache.
+        '''
+        return repr((
+            self.num_runs, self.num_gens, self.popsize, self.starting_length, self.p_xo, 
+            self.p_product_mut, self.p_usp_suite_mut, self.p_plus_batch_mut, self.p_minus_batch_mut, self.p_gene_swap, 
+            self.random_state, self.heuristic_init, self.seeded_ratio, self.use_archive
+        )).encode()
+
+    def __seed_genes(self, population=None):
+        '''
+            Converts 'initial_population', or 'population' if given, into lists of 
+            (product number, USP suite number, batches) triplets. Campaigns of unknown 
+            products or suites get number 0 and are dropped when the chromosomes are 
+            created. DSP campaigns are skipped as they follow from the USP ones.
+        '''
+        if population is None:
+            population = self.initial_population
+
+        if not population:
+            return []
+
+        product_label_index_pairs = { label: index + 1 for index, label in enumerate(self.product_labels) }
+        usp_suite_label_index_pairs = { 'USP%d' % (index + 1): index + 1 for index in range(self.num_usp_suites) }
+        seed_genes = []
+
+        for seed in population:
+            if isinstance(seed, pd.core.frame.DataFrame):
+                campaigns = zip(seed.Product, seed.Suite, seed.Batches)
+            elif isinstance(seed, ScheduleArrays):
+                campaigns = [
+                    (self.product_labels[product_num - 1], self.__suite_label(suite_num), num_batches) 
+                    for product_num, suite_num, num_batches in zip(
+                        seed.campaigns['product_num'], 
+                        seed.campaigns['suite_num'], 
+                        seed.campaigns['num_batches']
+                    )
+                ]
+            elif hasattr(seed, 'campaigns'):
+                campaigns = zip(seed.campaigns.Product, seed.campaigns.Suite, seed.campaigns.Batches)
+            else:
+                campaigns = seed
+
+            seed_genes.append([
+                (product_label_index_pairs.get(product, 0), usp_suite_label_index_pairs.get(suite, 0), int(num_batches)) 
+                for product, suite, num_batches in campaigns
+                if not str(suite).startswith('DSP')
+            ])
+
+        return seed_genes
+
+    def create_schedules(self, campaigns_list: list, schedules: bool=False):
+        '''
+            Evaluates many campaign tables at once, decoding them in parallel without 
+            the GIL, e.g. candidate plans of a planner. Each item is either a schedule 
+            or a campaigns table with 'Product', 'Suite' and 'Batches' columns. Returns a DataFrame 
+            with every objective in AVAILABLE_OBJECTIVES per table, or the schedules 
+            in the 'output' format if 'schedules' is True.
+        '''
+        cdef:
+            vector[NSGAChromosome[SingleSiteMultiSuiteGene]] solutions
+            vector[vector[double]] objectives
+            vector[ScheduleRecords*] records
+            ScheduleArrays arrays
+
+        genes_list = self.__seed_genes(campaigns_list)
+        solutions.resize(len(genes_list))
+
+        for i, genes in enumerate(genes_list):
+            solutions[i].genes.resize(len(genes))
+
+            for j, (product_num, usp_suite_num, num_batches) in enumerate(genes):
+                assert product_num and usp_suite_num, "Campaigns table {} has an unknown product or suite.".format(i)
+                solutions[i].genes[j].product_num = GeneField(product_num)
+                solutions[i].genes[j].usp_suite_num = GeneField(usp_suite_num)
+                solutions[i].genes[j].num_batches = GeneField(num_batches)
+
+        if schedules:
+            schedules_list = [ScheduleArrays() for _ in range(solutions.size())]
+
+            for arrays in schedules_list:
+                records.push_back(&arrays.records)
+
+            with nogil:
+                CreateRecords[SingleSiteMultiSuiteSchedule, SingleSiteMultiSuiteModel, NSGAChromosome[SingleSiteMultiSuiteGene]](
+                    self.single_site_multi_suite, 
+                    solutions, 
+                    records,
+                    self.num_threads
+                )
+
+            return [self.__output(arrays) for arrays in schedules_list]
+
+        with nogil:
+            EvaluateObjectives[SingleSiteMultiSuiteSchedule, SingleSiteMultiSuiteModel, NSGAChromosome[SingleSiteMultiSuiteGene]](
+                self.single_site_multi_suite, 
+                solutions, 
+                objectives,
+                self.num_threads
+            )
+
+        return pd.DataFrame(OrderedDict([
+            (obj, [values[self.objectives[obj]] for values in objectives]) for obj in self.AVAILABLE_OBJECTIVES
+        ]))
+
+    def __objectives_order(self):
+        '''
+            Positions of the 'objectives' passed to 'fit' in NSGAChromosome objectives,
+            which follow the order of the objectives in the input data.
+        '''
+        model_objectives = self.input_data.objectives
+        model_objectives = [obj for obj, _ in model_objectives]
+        return [model_objectives.index(self.objectives[obj]) for obj, _ in self.objectives_coefficients_list]
+
+    def __objective_names(self):
+        '''
+            Names of the objectives in the order of NSGAChromosome objectives.
+        '''
+        names = { value: name for name, value in self.objectives.items() }
+        model_objectives = self.input_data.objectives
+        return [names[obj].encode() for obj, _ in model_objectives]
+
+    def __clear_solutions(self):
+        self.solution_genes.clear()
+        self.points.clear()
+        self.cache.clear()
+        self.num_fits += 1
+
+    cdef size_t __store_solution(self, vector[SingleSiteMultiSuiteGene] &genes, vector[double] point):
+        '''
+            Keeps the genes and the objective values of the solution, converted for 
+            minimisation like NSGAChromosome objectives, for decoding it on demand. 
+            Returns the index of the solution.
+        '''
+        self.solution_genes.push_back(genes)
+        self.points.push_back(point)
+        return self.solution_genes.size() - 1
+
+    def __make_sequence(self, indices):
+        objectives = pd.DataFrame(
+            [[-coef * self.points[index][k] for k, (_, coef) in enumerate(self.objectives_coefficients_list)] for index in indices],
+            columns=[obj for obj, _ in self.objectives_coefficients_list]
+        )
+        return ScheduleSequence(self.__schedule, [(self.num_fits, index) for index in indices], objectives)
+
+    cdef ScheduleArrays __decode(self, size_t index):
+        cdef:
+            SingleSiteMultiSuiteSchedule schedule
+            NSGAChromosome[SingleSiteMultiSuiteGene] solution
+
+        solution.genes = self.solution_genes[index]
+        self.single_site_multi_suite.CreateSchedule(solution, schedule)
+        return self.__make_records(schedule)
+
+    def __schedule(self, key):
+        '''
+            Decodes the solution into a schedule in the 'output' format, or returns 
+            it from the cache of the most recently accessed schedules.
+        '''
+        num_fits, index = key
+        assert num_fits == self.num_fits, "The schedule is from a previous 'fit' and can no longer be decoded."
+
+        if index in self.cache:
+            self.cache.move_to_end(index)
+            return self.cache[index]
+
+        self.cache[index] = self.__output(self.__decode(index))
+
+        if len(self.cache) > self.cache_size:
+            self.cache.popitem(last=False)
+
+        return self.cache[index]
+
+    def __to_point(self, point):
+        '''
+            Converts a schedule or a dictionary of objective name and value pairs 
+            into a point of the front.
+        '''
+        if isinstance(point, ScheduleArrays):
+            return [point.objectives[self.objectives[obj]] * coef * -1 for obj, coef in self.objectives_coefficients_list]
+
+        if hasattr(point, 'objectives'):
+            return [point.objectives[obj].values[0] * coef * -1 for obj, coef in self.objectives_coefficients_list]
+
+        return [point[obj] * coef * -1 for obj, coef in self.objectives_coefficients_list]
+
+    def hypervolume(self, ref_point: dict=None, ideal_point: dict=None):
+        '''
+            Exact hypervolume of the top non-dominated front, computed natively over the 
+            objective values of the 'schedules'. See 'biopharma_scheduling.utils.hypervolume' 
+            for the description of 'ref_point' and 'ideal_point'.
+        '''
+        assert not self.front.empty(), "Call 'fit' first"
+
+        cdef:
+            vector[double] ref
+            vector[vector[double]] ideal
+            double hv
+            size_t i, m
+
+        if ref_point is not None:
+            ref = self.__to_point(ref_point)
+        else:
+            ref = self.front[0]
+            for i in range(self.front.size()):
+                for m in range(ref.size()):
+                    ref[m] = max(ref[m], self.front[i][m])
+            for m in range(ref.size()):
+                ref[m] += 1
+
+        with nogil:
+            hv = Hypervolume[vector[vector[double]]](self.front, ref)
+
+        if ideal_point is not None:
+            ideal.push_back(self.__to_point(ideal_point))
+            hv /= Hypervolume[vector[vector[double]]](ideal, ref)
+
+        return hv
+
+    def igd(self, reference_front: list, plus: bool=False):
+        '''
+            Inverted generational distance of the top non-dominated front from the 
+            'reference_front', or IGD+ if 'plus' is True. 'reference_front' is a list 
+            of schedules or of dictionaries of objective name and value pairs.
+        '''
+        assert not self.front.empty(), "Call 'fit' first"
+
+        cdef:
+            vector[vector[double]] reference_points = [self.__to_point(point) for point in reference_front]
+            bint igd_plus = plus
+            double value
+
+        with nogil:
+            value = IGD[vector[vector[double]], vector[vector[double]]](self.front, reference_points, igd_plus)
+
+        return value
+
+    def epsilon(self, reference_front: list):
+        '''
+            Additive epsilon indicator of the top non-dominated front with respect to 
+            the 'reference_front', see 'igd'.
+        '''
+        assert not self.front.empty(), "Call 'fit' first"
+
+        cdef:
+            vector[vector[double]] reference_points = [self.__to_point(point) for point in reference_front]
+            double value
+
+        with nogil:
+            value = Epsilon[vector[vector[double]], vector[vector[double]]](self.front, reference_points)
+
+        return value
+
+    def spread(self, reference_front: list=None):
+        '''
+            Generalised spread of the top non-dominated front. The extreme points are 
+            taken from the 'reference_front' if one is given, see 'igd'.
+        '''
+        assert not self.front.empty(), "Call 'fit' first"
+
+        cdef:
+            vector[vector[double]] reference_points
+            double value
+
+        if reference_front is not None:
+            reference_points = [self.__to_point(point) for point in reference_front]
+
+        with nogil:
+            value = Spread[vector[vector[double]], vector[vector[double]]](self.front, reference_points)
+
+        return value
+
+    cdef ScheduleArrays __make_records(self, SingleSiteMultiSuiteSchedule &schedule):
+        cdef ScheduleArrays arrays = ScheduleArrays()
+        MakeRecords(schedule, arrays.records)
+        return arrays
+
+    def __output(self, schedules):
+        '''
+            Returns the schedule records in the 'output' format.
+        '''
+        if self.output == 'numpy':
+            return schedules
+
+        if schedules.pyschedule is None:
+            schedules.pyschedule = self.__make_pyschedule(schedules)
+
+        return schedules.pyschedule
+
+    def __suite_label(self, suite_num):
+        if suite_num <= self.num_usp_suites:
+            return 'USP%d' % suite_num
+
+        return 'DSP%d' % (suite_num - self.num_usp_suites)
+
+    cdef __make_pyschedule(self, ScheduleArrays arrays):
+        start_date = pd.to_datetime(self.start_date)
+        product_labels = np.asarray(self.product_labels, dtype=object)
+        campaigns = arrays.campaigns
+        batches = arrays.batches
+        suite_labels = np.asarray([self.__suite_label(suite_num) for suite_num in campaigns['suite_num']], dtype=object)
+
+        def get_dates_of(deltas):
+            return start_date + pd.to_timedelta(deltas.astype(int), unit='D')
+
+        def get_table_of(grid):
+            table = pd.DataFrame(np.array(grid.T), columns=self.product_labels)
+            table['date'] = self.due_dates
+            return table
+
+        campaigns_table = pd.DataFrame(OrderedDict([
+            ('Product', product_labels[campaigns['product_num'] - 1]),
+            ('Suite', suite_labels),
+            ('Batches', campaigns['num_batches']),
+            ('Start', get_dates_of(campaigns['start'])),
+            ('End', get_dates_of(campaigns['end']))
+        ]))
+
+        batches_table = pd.DataFrame(OrderedDict([
+            ('Product', product_labels[batches['product_num'] - 1]),
+            ('Suite', suite_labels[batches['campaign_num']]),
+            ('Start', get_dates_of(batches['start'])),
+            ('Stored on', get_dates_of(batches['stored_at'])),
+            ('Expires on', get_dates_of(batches['expires_at']))
+        ]))
 
         return PySingleSiteMultiSuiteSchedule(
             objectives={
-                obj: schedule.objectives[self.objectives[obj]] 
+                obj: arrays.objectives[self.objectives[obj]] 
                 for obj in self.AVAILABLE_OBJECTIVES
             }, 
             campaigns_table=campaigns_table,
             batches_table=batches_table,
-            batch_inventory=batch_inventory,
-            batch_backlog=batch_backlog,
-            batch_supply=batch_supply,
-            batch_waste=batch_waste
+            batch_inventory=get_table_of(arrays.inventory),
+            batch_backlog=get_table_of(arrays.backlog),
+            batch_supply=get_table_of(arrays.supply),
+            batch_waste=get_table_of(arrays.waste)
         )
 
     @property
@@ -1264,4 +2499,15 @@ cdef class DetSingleSiteMultiSuite:
 
     @property
     def history(self):
-        return self.history     
\ No newline at end of file
+        return self.history     
+
+    @property
+    def population(self):
+        '''
+            Campaigns tables of the final population of the last run. Can be passed 
+            as 'initial_population' to continue the search.
+        '''
+        return [
+            pd.DataFrame.from_records(genes, columns=['Product', 'Suite', 'Batches']) 
+            for genes in self.population
+        ]
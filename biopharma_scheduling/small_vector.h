@@ -0,0 +1,298 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __SMALL_VECTOR_H__
+#define __SMALL_VECTOR_H__
+
+#include <new>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+
+
+namespace utils
+{
+	/*
+		Vector which keeps up to N elements inline and moves them to the heap once
+		it grows beyond that, e.g. the genes of a chromosome, which are then copied
+		without going through the allocator. Has the subset of the std::vector
+		interface used by the chromosomes and the models. Iterators are pointers
+		and, as with std::vector, are invalidated when the elements move.
+	*/
+	template<class T, size_t N>
+	class SmallVector
+	{
+		static_assert(N > 0, "SmallVector needs an inline capacity of at least one element");
+
+	public:
+		typedef T value_type;
+		typedef size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef T* iterator;
+		typedef const T* const_iterator;
+
+		SmallVector() : first(Inline()), count(0), cap(N) {}
+
+		explicit SmallVector(size_type n) : SmallVector()
+		{
+			resize(n);
+		}
+
+		SmallVector(size_type n, const T &value) : SmallVector()
+		{
+			resize(n, value);
+		}
+
+		SmallVector(std::initializer_list<T> values) : SmallVector()
+		{
+			reserve(values.size());
+			std::uninitialized_copy(values.begin(), values.end(), first);
+			count = values.size();
+		}
+
+		SmallVector(const SmallVector &other) : SmallVector()
+		{
+			reserve(other.count);
+			std::uninitialized_copy(other.begin(), other.end(), first);
+			count = other.count;
+		}
+
+		SmallVector(SmallVector &&other) noexcept : SmallVector()
+		{
+			Steal(other);
+		}
+
+		SmallVector& operator=(const SmallVector &other)
+		{
+			if (this != &other) {
+				clear();
+				reserve(other.count);
+				std::uninitialized_copy(other.begin(), other.end(), first);
+				count = other.count;
+			}
+
+			return *this;
+		}
+
+		SmallVector& operator=(SmallVector &&other) noexcept
+		{
+			if (this != &other) {
+				clear();
+				Deallocate();
+				Steal(other);
+			}
+
+			return *this;
+		}
+
+		~SmallVector()
+		{
+			clear();
+			Deallocate();
+		}
+
+		inline size_type size() const { return count; }
+		inline size_type capacity() const { return cap; }
+		inline bool empty() const { return count == 0; }
+
+		// True while the elements are stored inline.
+		inline bool is_inline() const { return first == Inline(); }
+
+		inline T* data() { return first; }
+		inline const T* data() const { return first; }
+
+		inline T& operator[](size_type i) { return first[i]; }
+		inline const T& operator[](size_type i) const { return first[i]; }
+
+		inline T& front() { return first[0]; }
+		inline const T& front() const { return first[0]; }
+		inline T& back() { return first[count - 1]; }
+		inline const T& back() const { return first[count - 1]; }
+
+		inline iterator begin() { return first; }
+		inline const_iterator begin() const { return first; }
+		inline const_iterator cbegin() const { return first; }
+		inline iterator end() { return first + count; }
+		inline const_iterator end() const { return first + count; }
+		inline const_iterator cend() const { return first + count; }
+
+		void reserve(size_type n)
+		{
+			if (n <= cap) {
+				return;
+			}
+
+			T *elements = static_cast<T*>(::operator new(n * sizeof(T)));
+
+			for (size_type i = 0; i != count; ++i) {
+				new (elements + i) T(std::move(first[i]));
+				first[i].~T();
+			}
+
+			Deallocate();
+			first = elements;
+			cap = n;
+		}
+
+		inline void push_back(const T &value)
+		{
+			emplace_back(value);
+		}
+
+		inline void push_back(T &&value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		template<class... Args>
+		T& emplace_back(Args&&... args)
+		{
+			if (count == cap) {
+				// The arguments can refer to an element, so it is created before the move
+				T value(std::forward<Args>(args)...);
+				reserve(2 * cap);
+				new (first + count) T(std::move(value));
+			}
+			else {
+				new (first + count) T(std::forward<Args>(args)...);
+			}
+
+			return first[count++];
+		}
+
+		inline void pop_back()
+		{
+			first[--count].~T();
+		}
+
+		void resize(size_type n)
+		{
+			Shrink(n);
+			reserve(n);
+
+			for (; count < n; ++count) {
+				new (first + count) T();
+			}
+		}
+
+		void resize(size_type n, const T &value)
+		{
+			if (n > cap) {
+				T copy(value);
+				Shrink(n);
+				reserve(n);
+				std::uninitialized_fill(first + count, first + n, copy);
+			}
+			else {
+				Shrink(n);
+				std::uninitialized_fill(first + count, first + n, value);
+			}
+
+			count = std::max(count, n);
+		}
+
+		inline void clear()
+		{
+			Shrink(0);
+		}
+
+		iterator insert(const_iterator pos, const T &value)
+		{
+			size_type i = pos - first;
+			T copy(value);
+
+			if (i == count) {
+				emplace_back(std::move(copy));
+				return first + i;
+			}
+
+			if (count == cap) {
+				reserve(2 * cap);
+			}
+
+			new (first + count) T(std::move(first[count - 1]));
+			std::move_backward(first + i, first + count - 1, first + count);
+			first[i] = std::move(copy);
+			++count;
+
+			return first + i;
+		}
+
+		inline iterator erase(const_iterator pos)
+		{
+			return erase(pos, pos + 1);
+		}
+
+		iterator erase(const_iterator from, const_iterator to)
+		{
+			T *p = first + (from - first);
+
+			if (from != to) {
+				T *last = std::move(first + (to - first), end(), p);
+				Shrink(last - first);
+			}
+
+			return p;
+		}
+
+	private:
+		inline T* Inline() { return reinterpret_cast<T*>(&storage); }
+		inline const T* Inline() const { return reinterpret_cast<const T*>(&storage); }
+
+		inline void Shrink(size_type n)
+		{
+			for (; count > n; --count) {
+				first[count - 1].~T();
+			}
+		}
+
+		inline void Deallocate()
+		{
+			if (!is_inline()) {
+				::operator delete(first);
+				first = Inline();
+				cap = N;
+			}
+		}
+
+		// Moves the elements of 'other' into this empty vector and leaves 'other' empty.
+		void Steal(SmallVector &other)
+		{
+			if (other.is_inline()) {
+				for (size_type i = 0; i != other.count; ++i) {
+					new (first + i) T(std::move(other.first[i]));
+				}
+
+				count = other.count;
+				other.clear();
+			}
+			else {
+				first = other.first;
+				count = other.count;
+				cap = other.cap;
+
+				other.first = other.Inline();
+				other.count = 0;
+				other.cap = N;
+			}
+		}
+
+		typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type storage;
+		T *first;
+		size_type count;
+		size_type cap;
+	};
+}
+
+#endif
@@ -0,0 +1,420 @@
+#if defined(__posix) || defined(__unix) || defined(__linux) || defined(__APPLE__)
+ 	// #pragma GCC diagnostic ignored "-Wreorder"
+	// #pragma GCC diagnostic ignored "-Wunused-variable"
+	#pragma GCC diagnostic ignored "-Wformat="
+	#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include <deque>
+#include <mutex>
+#include <cstdio>
+#include <string>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#if defined(_WIN32)
+	#define NOMINMAX
+	#include <windows.h>
+#elif defined(__linux__)
+	#include <sched.h>
+	#include <pthread.h>
+#endif
+
+
+namespace utils
+{
+	/*
+		Fixed number of worker threads with a task queue each. Workers take the
+		most recent task from their own queue and, once it is empty, steal the
+		oldest task of another worker. Tasks submitted from a worker go to its
+		own queue, i.e. the follow-up work stays on the same thread unless some
+		other worker is idle.
+	*/
+	class ThreadPool
+	{
+		typedef std::function<void()> Task;
+
+		struct Queue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		std::vector<std::unique_ptr<Queue>> queues;
+		std::vector<std::thread> threads;
+
+		std::mutex mutex;
+		std::condition_variable work_available, all_done;
+		size_t num_queued = 0, num_unfinished = 0, next_queue = 0;
+		bool stop = false;
+		std::exception_ptr error;
+
+		// Pool and queue of the current thread, if it is a worker
+		static ThreadPool*& CurrentPool()
+		{
+			static thread_local ThreadPool *pool = nullptr;
+			return pool;
+		}
+
+		static size_t& CurrentQueue()
+		{
+			static thread_local size_t queue_num = 0;
+			return queue_num;
+		}
+
+		bool Pop(size_t queue_num, Task &task)
+		{
+			{
+				std::lock_guard<std::mutex> lock(queues[queue_num]->mutex);
+
+				if (!queues[queue_num]->tasks.empty()) {
+					task = std::move(queues[queue_num]->tasks.back());
+					queues[queue_num]->tasks.pop_back();
+					return true;
+				}
+			}
+
+			for (size_t i = 1; i < queues.size(); ++i) {
+				auto &victim = *queues[(queue_num + i) % queues.size()];
+				std::lock_guard<std::mutex> lock(victim.mutex);
+
+				if (!victim.tasks.empty()) {
+					task = std::move(victim.tasks.front());
+					victim.tasks.pop_front();
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		void Work(size_t queue_num)
+		{
+			CurrentPool() = this;
+			CurrentQueue() = queue_num;
+
+			while (true) {
+				Task task;
+
+				if (Pop(queue_num, task)) {
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						--num_queued;
+					}
+
+					try {
+						task();
+					}
+					catch (...) {
+						std::lock_guard<std::mutex> lock(mutex);
+						if (!error) error = std::current_exception();
+					}
+
+					std::lock_guard<std::mutex> lock(mutex);
+
+					if (--num_unfinished == 0) {
+						all_done.notify_all();
+					}
+
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(mutex);
+				work_available.wait(lock, [this]() { return stop || num_queued > 0; });
+
+				if (stop && num_queued == 0) {
+					return;
+				}
+			}
+		}
+
+	public:
+		// Uses all the hardware threads if 'num_threads' is not positive.
+		explicit ThreadPool(int num_threads = -1)
+		{
+			if (num_threads < 1) {
+				num_threads = std::max(1u, std::thread::hardware_concurrency());
+			}
+
+			for (int i = 0; i < num_threads; ++i) {
+				queues.emplace_back(new Queue());
+			}
+
+			for (int i = 0; i < num_threads; ++i) {
+				threads.emplace_back(&ThreadPool::Work, this, i);
+			}
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// Finishes the queued tasks before joining the workers.
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stop = true;
+			}
+
+			work_available.notify_all();
+
+			for (auto &thread : threads) {
+				thread.join();
+			}
+		}
+
+		inline int NumThreads() const
+		{
+			return threads.size();
+		}
+
+		/*
+			Pins worker i to CPU cpus[i % cpus.size()], e.g. to the CPUs of one NUMA
+			node, see NumaNodeCpus. Returns false if a worker could not be pinned,
+			which is always the case on platforms other than Linux and Windows.
+		*/
+		bool Pin(const std::vector<int> &cpus)
+		{
+			bool pinned = !cpus.empty();
+
+			for (size_t i = 0; i < threads.size() && !cpus.empty(); ++i) {
+				int cpu = cpus[i % cpus.size()];
+#if defined(_WIN32)
+				pinned = cpu >= 0 && cpu < 64 && SetThreadAffinityMask(threads[i].native_handle(), (DWORD_PTR)1 << cpu) && pinned;
+#elif defined(__linux__)
+				cpu_set_t cpu_set;
+				CPU_ZERO(&cpu_set);
+
+				if (cpu < 0 || cpu >= CPU_SETSIZE) {
+					pinned = false;
+					continue;
+				}
+
+				CPU_SET(cpu, &cpu_set);
+				pinned = !pthread_setaffinity_np(threads[i].native_handle(), sizeof(cpu_set), &cpu_set) && pinned;
+#else
+				pinned = false;
+#endif
+			}
+
+			return pinned;
+		}
+
+		void Submit(Task task)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				auto &queue = *queues[CurrentPool() == this ? CurrentQueue() : next_queue++ % queues.size()];
+
+				// Workers never take the pool mutex while holding a queue mutex
+				std::lock_guard<std::mutex> queue_lock(queue.mutex);
+				queue.tasks.push_back(std::move(task));
+
+				++num_queued;
+				++num_unfinished;
+			}
+
+			work_available.notify_one();
+		}
+
+		/*
+			Blocks until all the submitted tasks, including the ones they submit,
+			have finished. Rethrows the first exception thrown by a task. Must not
+			be called from a worker.
+		*/
+		void Wait()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			all_done.wait(lock, [this]() { return num_unfinished == 0; });
+
+			if (error) {
+				auto rethrown = error;
+				error = nullptr;
+				std::rethrow_exception(rethrown);
+			}
+		}
+	};
+
+	/*
+		Counts down the tasks of one caller of a ThreadPool, which waits for those
+		only, unlike ThreadPool::Wait. A task which fails records its exception,
+		which Wait rethrows, and still counts down.
+	*/
+	class Latch
+	{
+		std::mutex mutex;
+		std::condition_variable done;
+		int count;
+		std::exception_ptr error;
+
+	public:
+		explicit Latch(int count) : count(count) {}
+
+		Latch(const Latch&) = delete;
+		Latch& operator=(const Latch&) = delete;
+
+		void CountDown()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			// Notified under the lock, as the latch can go out of scope once Wait returns
+			if (--count == 0) {
+				done.notify_all();
+			}
+		}
+
+		// Keeps the first exception.
+		void Fail(std::exception_ptr exception)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (!error) {
+				error = exception;
+			}
+		}
+
+		void Wait()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			done.wait(lock, [this]() { return count <= 0; });
+
+			if (error) {
+				std::rethrow_exception(error);
+			}
+		}
+	};
+
+	// Counting semaphore, which a thread waits on instead of polling a queue.
+	class Semaphore
+	{
+		std::mutex mutex;
+		std::condition_variable available;
+		int count = 0;
+
+	public:
+		Semaphore() {}
+
+		Semaphore(const Semaphore&) = delete;
+		Semaphore& operator=(const Semaphore&) = delete;
+
+		void Release(int n = 1)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				count += n;
+			}
+
+			if (n == 1) {
+				available.notify_one();
+			}
+			else {
+				available.notify_all();
+			}
+		}
+
+		void Acquire()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			available.wait(lock, [this]() { return count > 0; });
+			--count;
+		}
+
+		bool TryAcquire()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (count > 0) {
+				--count;
+				return true;
+			}
+
+			return false;
+		}
+	};
+
+	// CPU numbers of a Linux cpulist, e.g. "0-3,8,10-11".
+	inline std::vector<int> ParseCpuList(const std::string &cpu_list)
+	{
+		std::vector<int> cpus;
+		const char *p = cpu_list.c_str();
+
+		while (*p) {
+			int first, last, length = 0;
+
+			if (std::sscanf(p, "%d-%d%n", &first, &last, &length) == 2 && length) {
+				p += length;
+			}
+			else if (std::sscanf(p, "%d%n", &first, &length) == 1 && length) {
+				last = first;
+				p += length;
+			}
+			else {
+				break;
+			}
+
+			for (int cpu = first; cpu <= last; ++cpu) {
+				cpus.push_back(cpu);
+			}
+
+			while (*p == ',' || *p == '\n' || *p == ' ') {
+				++p;
+			}
+		}
+
+		return cpus;
+	}
+
+	/*
+		CPUs of every NUMA node as listed in /sys on Linux. Elsewhere, or if the
+		list is not available, all the hardware threads as a single node.
+	*/
+	inline std::vector<std::vector<int>> NumaNodeCpus()
+	{
+		std::vector<std::vector<int>> nodes;
+
+#if defined(__linux__)
+		auto read_list = [](const std::string &path) {
+			char list[4096] = { 0 };
+			std::FILE *file = std::fopen(path.c_str(), "r");
+
+			if (!file) {
+				return std::vector<int>();
+			}
+
+			size_t size = std::fread(list, 1, sizeof(list) - 1, file);
+			std::fclose(file);
+
+			return ParseCpuList(std::string(list, size));
+		};
+
+		// The node numbers can have gaps
+		for (int node : read_list("/sys/devices/system/node/online")) {
+			auto cpus = read_list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+
+			if (!cpus.empty()) {
+				nodes.push_back(std::move(cpus));
+			}
+		}
+#endif
+
+		if (nodes.empty()) {
+			nodes.emplace_back(std::max(1u, std::thread::hardware_concurrency()));
+
+			for (int cpu = 0; cpu < nodes[0].size(); ++cpu) {
+				nodes[0][cpu] = cpu;
+			}
+		}
+
+		return nodes;
+	}
+}
+
+#endif
@@ -10,6 +10,7 @@
 
 #include <cmath>
 #include <queue>
+#include <atomic>
 #include <random>
 #include <limits>
 #include <vector>
@@ -224,9 +225,49 @@ namespace utils
 		return min + sqrtf(u * (max - min) * (mode - min));
 	}
 
-	CustomRandom<> rng = CustomRandom<>();
+	// Seed of the last call to set_seed, -1 if it was random, and the number of seeded threads.
+	inline std::atomic<int>& base_seed()
+	{
+		static std::atomic<int> seed(-1);
+		return seed;
+	}
+
+	inline std::atomic<int>& num_seeded_threads()
+	{
+		static std::atomic<int> num_threads(0);
+		return num_threads;
+	}
+
+	/*
+		Generator of a thread which has not called set_seed, seeded on its first use
+		from the last seed passed to set_seed and the order the threads got seeded
+		in, or randomly if that seed was -1.
+	*/
+	inline CustomRandom<> thread_random()
+	{
+		CustomRandom<> thread_rng;
+		int seed = base_seed();
+
+		if (seed != -1) {
+			thread_rng.init({ seed, ++num_seeded_threads() });
+		}
+		else {
+			thread_rng.init();
+		}
+
+		return thread_rng;
+	}
+
+	/*
+		Every thread has its own generator, i.e. GAs running on separate threads
+		do not share the random sequence. A thread which uses it before calling
+		set_seed, e.g. a worker of a thread pool, gets one from thread_random.
+	*/
+	thread_local CustomRandom<> rng = thread_random();
 
 	inline void set_seed(int seed = -1) {
+		base_seed() = seed;
+
 		if (seed != -1) {
 			rng.init({ seed });
 		}
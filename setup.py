@@ -39,6 +39,16 @@ if __name__ == "__main__":
                     language='c++',
                     extra_compile_args=extra_compile_args
                 ),
+                Extension(
+                    '*', [ 'biopharma_scheduling/metrics.pyx' ],
+                    language='c++',
+                    extra_compile_args=extra_compile_args
+                ),
+                Extension(
+                    '*', [ 'biopharma_scheduling/history.pyx' ],
+                    language='c++',
+                    extra_compile_args=extra_compile_args
+                ),
                 # Extension(
                 #     '*', [ 'biopharma_scheduling/single_site/stochastic.pyx' ],
                 #     language='c++',
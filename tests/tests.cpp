@@ -5,8 +5,20 @@
 #include <unordered_map>
 
 #include "../biopharma_scheduling/gene.h"
+#include "../biopharma_scheduling/batch_runner.h"
+#include "../biopharma_scheduling/evaluation.h"
+#include "../biopharma_scheduling/executor.h"
+#include "../biopharma_scheduling/heuristics.h"
+#include "../biopharma_scheduling/history.h"
+#include "../biopharma_scheduling/lock_free_queue.h"
+#include "../biopharma_scheduling/loader.h"
+#include "../biopharma_scheduling/metrics.h"
 #include "../biopharma_scheduling/nsgaii.h"
+#include "../biopharma_scheduling/protocol.h"
+#include "../biopharma_scheduling/records.h"
+#include "../biopharma_scheduling/result_cache.h"
 #include "../biopharma_scheduling/single_objective_ga.h"
+#include "../biopharma_scheduling/small_vector.h"
 #include "../biopharma_scheduling/scheduling_models.h"
 
 
@@ -115,6 +127,14 @@ SCENARIO("deterministic::SingleSiteMultiSuiteModel::CreateSchedule test")
 			single_site_multi_suite_model.CreateSchedule(i, schedule);
 
 			REQUIRE(schedule.objectives[deterministic::TOTAL_PROFIT] == Approx(518.0));
+
+			types::ScheduleRecords records;
+			types::MakeRecords(schedule, records);
+
+			REQUIRE(records.campaigns.size() == schedule.suites[0].size() + schedule.suites[1].size() + schedule.suites[2].size() + schedule.suites[3].size());
+			REQUIRE(records.campaigns[0].suite_num == 1);
+			REQUIRE(records.batches.size() == 34);
+			REQUIRE(records.waste.size() == 3 * records.num_periods);
 		}
 	}
 
@@ -385,6 +405,15 @@ SCENARIO("deterministic::SingleSiteSimpleModel known solution test")
 	REQUIRE( schedule.objectives[deterministic::TOTAL_KG_INVENTORY_DEFICIT] == Approx(194.6) );
 	REQUIRE( schedule.objectives[deterministic::TOTAL_KG_BACKLOG] == Approx(0.0) );
 	REQUIRE( schedule.objectives[deterministic::TOTAL_KG_WASTE] == Approx(0.0) );
+
+	types::ScheduleRecords records;
+	types::MakeRecords(schedule, records);
+
+	REQUIRE( records.campaigns.size() == schedule.campaigns.size() );
+	REQUIRE( records.campaigns.back().first_batch_num + records.campaigns.back().num_batches == records.batches.size() );
+	REQUIRE( records.inventory.size() == records.num_products * records.num_periods );
+	REQUIRE( records.inventory[records.num_periods + 1] == schedule.kg_inventory[1][1] );
+	REQUIRE( records.batches.back().campaign_num == records.campaigns.size() - 1 );
 }
 
 SCENARIO("deterministic::SingleSiteMultiSuiteModel Single-Objective Example 1 test")
@@ -796,6 +825,92 @@ SCENARIO("deterministic::SingleSiteSimpleModel Single-Objective test")
 	REQUIRE( schedule.objectives[deterministic::TOTAL_KG_INVENTORY_DEFICIT] == Approx(472.2) );
 	REQUIRE( schedule.objectives[deterministic::TOTAL_KG_BACKLOG] == Approx(0.0) );
 	REQUIRE( schedule.objectives[deterministic::TOTAL_KG_WASTE] == Approx(0.0) );
+
+	// Warm start from the best solution, with a campaign of a product which is no longer made
+	auto seed_solution = solution;
+	seed_solution.genes.insert(seed_solution.genes.begin(), seed_solution.genes[0]);
+	seed_solution.genes[0].product_num = num_products + 1;
+
+	ga.Init(
+		popsize,
+		std::vector<types::SingleObjectiveChromosome<types::SingleSiteSimpleGene>>{ seed_solution },
+
+		//Individual Params + GeneParams
+		starting_length,
+		p_xo,
+		p_gene_swap,
+
+		//GeneParams 
+		num_products,
+		p_product_mut,
+		p_plus_batch_mut,
+		p_minus_batch_mut
+	);
+
+	REQUIRE( ga.Top().constraints == Approx(0.0) );
+	REQUIRE( ga.Top().objective <= Approx(solution.objective) );
+
+	// Heuristic seeds are kept in the initial population
+	auto heuristic_seeds = heuristics::Seeds<types::SingleObjectiveChromosome<types::SingleSiteSimpleGene>>(input_data);
+	REQUIRE( heuristic_seeds.size() > 0 );
+
+	double best_seed_objective = std::numeric_limits<double>::max();
+	for (auto &heuristic_seed : heuristic_seeds) {
+		deterministic_fitness(heuristic_seed);
+		if (heuristic_seed.constraints == Approx(0.0)) {
+			best_seed_objective = std::min(best_seed_objective, heuristic_seed.objective);
+		}
+	}
+
+	ga.Init(
+		popsize,
+		heuristic_seeds,
+
+		//Individual Params + GeneParams
+		starting_length,
+		p_xo,
+		p_gene_swap,
+
+		//GeneParams 
+		num_products,
+		p_product_mut,
+		p_plus_batch_mut,
+		p_minus_batch_mut
+	);
+
+	REQUIRE( ga.Top().objective <= best_seed_objective );
+	REQUIRE( ga.Parents().size() == popsize );
+
+	// Lots fit in the storage, and seeds in different suites are different
+	std::vector<double> kg_storage;
+	for (double kg : input_data.kg_yield_per_batch) {
+		kg_storage.push_back(2.5 * kg);
+	}
+
+	auto lots = heuristics::DemandLots(
+		input_data.kg_demand,
+		input_data.kg_yield_per_batch,
+		input_data.kg_opening_stock,
+		kg_storage,
+		input_data.min_batches_per_campaign,
+		input_data.max_batches_per_campaign,
+		std::vector<int>(input_data.num_products, 1),
+		12
+	);
+	REQUIRE( lots.size() > 0 );
+	for (const auto &lot : lots) {
+		REQUIRE( lot.num_batches <= 2 );
+	}
+
+	types::SingleSiteMultiSuiteGene suite_1, suite_2;
+	suite_1.product_num = suite_2.product_num = 1;
+	suite_1.num_batches = suite_2.num_batches = 3;
+	suite_1.usp_suite_num = 1;
+	suite_2.usp_suite_num = 2;
+	REQUIRE( !heuristics::SameGene(suite_1, suite_2) );
+
+	REQUIRE_THROWS_AS( ga.SetSeededRatio(1.5), std::invalid_argument );
+	REQUIRE_THROWS_AS( ga.SetSeededRatio(-0.1), std::invalid_argument );
 }
 
 SCENARIO("deterministic::SingleSiteSimpleModel Multi-Objective test")
@@ -958,6 +1073,40 @@ SCENARIO("deterministic::SingleSiteSimpleModel Multi-Objective test")
 	REQUIRE( schedule_y.objectives[deterministic::TOTAL_KG_INVENTORY_DEFICIT] == Approx(479.9) );
 	REQUIRE( schedule_y.objectives[deterministic::TOTAL_KG_BACKLOG] == Approx(1.0) );
 	REQUIRE( schedule_y.objectives[deterministic::TOTAL_KG_WASTE] == Approx(0.0) );	
+
+	metrics::Point ref = { -590.0, 500.0 };
+	metrics::Points points;
+
+	for (const auto &solution : solutions) {
+		points.push_back(solution.objectives);
+	}
+
+	REQUIRE( metrics::Hypervolume(solutions, ref) > 0.0 );
+	REQUIRE( metrics::Hypervolume(solutions, ref) == Approx(metrics::Hypervolume(points, ref)) );
+	REQUIRE( metrics::IGD(solutions, points) == Approx(0.0) );
+	REQUIRE( metrics::Epsilon(solutions, points) == Approx(0.0) );
+
+	algorithms::NSGAII<types::NSGAChromosome<types::SingleSiteSimpleGene>, deterministic::SingleSiteSimpleModel> archive_nsgaii(
+		deterministic_fitness,
+		seed,
+		num_threads
+	);
+
+	archive_nsgaii.UseArchive(true);
+
+	archive_nsgaii.Init(popsize, starting_length, p_xo, p_gene_swap, num_products, p_product_mut, p_plus_batch_mut, p_minus_batch_mut);
+
+	for (int gen = 0; gen < 10; ++gen) {
+		archive_nsgaii.Update();
+	}
+
+	auto archived = archive_nsgaii.Archive();
+	auto top_front = archive_nsgaii.TopFront();
+
+	REQUIRE( !archived.empty() );
+	REQUIRE( archive_nsgaii.TopFront(archived).size() == archived.size() );
+	REQUIRE( archived[0].constraints == Approx(top_front[0].constraints) );
+	REQUIRE( metrics::Epsilon(archived, top_front) <= 0.0 );
 }
 
 SCENARIO("stochastic::SingleSiteSimpleModel::CreateSchedule test") 
@@ -1133,4 +1282,1452 @@ SCENARIO("stochastic::SingleSiteSimpleModel::CreateSchedule test")
 	REQUIRE( schedule.objectives[stochastic::TOTAL_KG_INVENTORY_DEFICIT_MEAN] == Approx(194.6) );
 	REQUIRE( schedule.objectives[stochastic::TOTAL_KG_BACKLOG_MEAN] == Approx(0.0) );
 	REQUIRE( schedule.objectives[stochastic::TOTAL_KG_WASTE_MEAN] == Approx(0.0) );
-}
\ No newline at end of file
+
+	// Prefixes of the solution, longest first, in one reused workspace
+	std::vector<types::NSGAChromosome<types::SingleSiteSimpleGene>> prefixes;
+
+	for (int c = i.genes.size(); c > 0; --c) {
+		prefixes.push_back(i);
+		prefixes.back().genes.resize(c);
+	}
+
+	stochastic::SingleSiteSimpleModel::Workspace workspace;
+	single_site_simple_model.EvaluateBatch(prefixes.data(), prefixes.data() + prefixes.size(), workspace);
+
+	for (auto prefix : prefixes) {
+		auto batch_prefix = prefix;
+		single_site_simple_model(prefix);
+
+		REQUIRE( batch_prefix.objectives == prefix.objectives );
+		REQUIRE( batch_prefix.constraints == prefix.constraints );
+	}
+}
+
+SCENARIO("types::SingleSiteMultiSuiteGene and types::SingleSiteSimpleGene test")
+{
+	REQUIRE( sizeof(types::SingleSiteMultiSuiteGene) <= 16 );
+	REQUIRE( sizeof(types::SingleSiteSimpleGene) <= 16 );
+
+	types::SingleSiteMultiSuiteGene gene(3, 2, 1.0, 1.0, 1.0, 0.0), other(3, 2, 1.0, 1.0, 1.0, 0.0);
+	types::SingleSiteMultiSuiteGene different(3, 2, 0.5, 1.0, 1.0, 0.0);
+
+	// Genes with the same parameters share the config
+	REQUIRE( &gene.GetConfig() == &other.GetConfig() );
+	REQUIRE( &gene.GetConfig() == &gene.make_new().GetConfig() );
+	REQUIRE( &gene.GetConfig() != &different.GetConfig() );
+	REQUIRE( different.GetConfig().p_product_mut == 0.5 );
+
+	int product_num = gene.product_num, usp_suite_num = gene.usp_suite_num;
+	gene.Mutate();
+
+	REQUIRE( gene.IsValid() );
+	REQUIRE( gene.product_num != product_num );
+	REQUIRE( gene.usp_suite_num != usp_suite_num );
+	REQUIRE( gene.num_batches == 2 );
+
+	gene.num_batches = INT16_MAX;
+	gene.Mutate();
+	REQUIRE( gene.num_batches == INT16_MAX );
+
+	types::SingleSiteSimpleGene seed;
+	seed.product_num = 4;
+	seed.num_batches = 0;
+
+	REQUIRE_FALSE( types::SingleSiteSimpleGene(seed, 3, 0.0, 0.0, 0.0).IsValid() );
+	REQUIRE( types::SingleSiteSimpleGene(seed, 4, 0.0, 0.0, 0.0).IsValid() );
+	REQUIRE( types::SingleSiteSimpleGene(seed, 4, 0.0, 0.0, 0.0).num_batches == 1 );
+
+	// Values from outside the GA are checked instead of truncated
+	REQUIRE( types::GeneField(INT16_MAX) == INT16_MAX );
+	REQUIRE_THROWS_AS( types::GeneField(INT16_MAX + 1), std::out_of_range );
+	REQUIRE_THROWS_AS( types::GeneField(INT16_MIN - 1), std::out_of_range );
+
+	int fields[] = { 2, 40000 };
+	REQUIRE_THROWS_AS( io::SetFields(seed, fields), std::out_of_range );
+}
+
+SCENARIO("utils::SmallVector test")
+{
+	utils::SmallVector<int, 4> v = { 1, 2, 3 };
+
+	REQUIRE( v.is_inline() );
+
+	v.push_back(4);
+	v.push_back(v[0]);
+
+	REQUIRE( !v.is_inline() );
+	REQUIRE( std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 1, 2, 3, 4, 1 } );
+
+	v.insert(v.begin(), v.back());
+	v.erase(v.begin() + 2, v.begin() + 4);
+	REQUIRE( std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 1, 1, 4, 1 } );
+
+	utils::SmallVector<int, 4> copy(v), moved(std::move(copy));
+	REQUIRE( copy.empty() );
+	REQUIRE( moved.size() == 4 );
+	REQUIRE( std::equal(v.begin(), v.end(), moved.begin(), moved.end()) );
+
+	v.resize(2);
+	copy = v;
+	moved = std::move(copy);
+	REQUIRE( moved.size() == 2 );
+	REQUIRE( moved.back() == 1 );
+
+	// Same results as with std::vector genes for the same seed
+	std::string data_dir(__FILE__);
+	data_dir = (data_dir.rfind('/') == std::string::npos ? "." : data_dir.substr(0, data_dir.rfind('/'))) + "/data/";
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+
+	auto simple = io::LoadSingleSiteSimple(data_dir + "deterministic_single_site_simple", "2016-12-01", objectives);
+	deterministic::SingleSiteSimpleModel model(simple.input_data);
+
+	algorithms::GAParams params;
+	params.popsize = 20;
+
+	typedef types::SingleObjectiveChromosome<types::SingleSiteSimpleGene> Chromosome;
+	typedef types::SingleObjectiveChromosome<types::SingleSiteSimpleGene, utils::SmallVector<types::SingleSiteSimpleGene, 4>> SmallChromosome;
+
+	// Each GA re-seeds the random number generator
+	algorithms::SingleObjectiveGA<Chromosome, deterministic::SingleSiteSimpleModel> ga(model, 7, 1);
+	algorithms::InitPopulation(ga, params, simple.input_data);
+
+	for (int gen = 0; gen < 20; ++gen) {
+		ga.Update();
+	}
+
+	auto top = ga.Top();
+
+	algorithms::SingleObjectiveGA<SmallChromosome, deterministic::SingleSiteSimpleModel> small_ga(model, 7, 1);
+	algorithms::InitPopulation(small_ga, params, simple.input_data);
+
+	for (int gen = 0; gen < 20; ++gen) {
+		small_ga.Update();
+	}
+
+	auto small_top = small_ga.Top();
+
+	REQUIRE( top.objective == small_top.objective );
+	REQUIRE( top.genes.size() == small_top.genes.size() );
+}
+
+SCENARIO("types::FixedNSGAChromosome test")
+{
+	std::string data_dir(__FILE__);
+	data_dir = (data_dir.rfind('/') == std::string::npos ? "." : data_dir.substr(0, data_dir.rfind('/'))) + "/data/";
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+
+	auto simple = io::LoadSingleSiteSimple(data_dir + "deterministic_single_site_simple", "2016-12-01", objectives);
+	deterministic::SingleSiteSimpleModel model(simple.input_data);
+
+	algorithms::GAParams params;
+	params.popsize = 20;
+
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+	typedef types::FixedNSGAChromosome<types::SingleSiteSimpleGene, 2> FixedChromosome;
+
+	// Each GA re-seeds the random number generator
+	algorithms::NSGAII<Chromosome, deterministic::SingleSiteSimpleModel> nsgaii(model, 7, 1);
+	algorithms::InitPopulation(nsgaii, params, simple.input_data);
+
+	for (int gen = 0; gen < 20; ++gen) {
+		nsgaii.Update();
+	}
+
+	auto front = nsgaii.TopFront();
+
+	algorithms::NSGAII<FixedChromosome, deterministic::SingleSiteSimpleModel> fixed_nsgaii(model, 7, 1);
+	algorithms::InitPopulation(fixed_nsgaii, params, simple.input_data);
+
+	for (int gen = 0; gen < 20; ++gen) {
+		fixed_nsgaii.Update();
+	}
+
+	auto fixed_front = fixed_nsgaii.TopFront();
+
+	REQUIRE( front.size() == fixed_front.size() );
+
+	for (int i = 0; i < front.size(); ++i) {
+		REQUIRE( front[i].objectives[0] == fixed_front[i].objectives[0] );
+		REQUIRE( front[i].objectives[1] == fixed_front[i].objectives[1] );
+	}
+
+	std::vector<double> values;
+	io::GetObjectives(fixed_front[0], values);
+	REQUIRE( values.size() == 2 );
+
+	REQUIRE_THROWS( io::SetObjectives(fixed_front[0], std::vector<double>{ 1.0, 2.0, 3.0 }) );
+}
+
+SCENARIO("algorithms::CompareBlock test")
+{
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+
+	utils::set_seed(1);
+
+	// Ties, constraints equal within utils::Approx and infinities
+	std::vector<Chromosome> R(37);
+	double constraints[] = { 0.0, 0.0, 1.0, 1.0 + 1E-6, 2.0, std::numeric_limits<double>::infinity() };
+
+	for (int i = 0; i < R.size(); ++i) {
+		R[i].constraints = constraints[utils::random_int(0, 5)];
+		R[i].objectives = { (double)utils::random_int(0, 3), (double)utils::random_int(0, 3), utils::random() };
+	}
+
+	R[5].objectives = R[6].objectives;
+
+	algorithms::DominancePoints points;
+	points.Assign(R);
+
+	std::vector<algorithms::CompareBlockFunction> kernels = { algorithms::CompareBlockScalar };
+
+#if defined(__DOMINANCE_SIMD__)
+	if (__builtin_cpu_supports("avx2")) {
+		kernels.push_back(algorithms::CompareBlockAVX2);
+	}
+
+	if (__builtin_cpu_supports("avx512f")) {
+		kernels.push_back(algorithms::CompareBlockAVX512);
+	}
+#endif
+
+	for (int p = 0; p < R.size(); ++p) {
+		for (int begin = 0; begin < R.size(); begin += algorithms::DOMINANCE_BLOCK) {
+			uint32_t expected_dominates = 0, expected_dominated = 0;
+
+			for (int q = begin; q < begin + algorithms::DOMINANCE_BLOCK && q < R.size(); ++q) {
+				int flag = 0;
+
+				if (R[p].constraints != utils::Approx(R[q].constraints)) {
+					flag = R[p].constraints < R[q].constraints ? 1 : -1;
+				}
+				else {
+					bool p_better = false, q_better = false;
+
+					for (int m = 0; m < 3; ++m) {
+						p_better |= R[p].objectives[m] < R[q].objectives[m];
+						q_better |= R[p].objectives[m] > R[q].objectives[m];
+					}
+
+					flag = p_better && !q_better ? 1 : (q_better && !p_better ? -1 : 0);
+				}
+
+				expected_dominates |= (uint32_t)(flag == 1) << (q - begin);
+				expected_dominated |= (uint32_t)(flag == -1) << (q - begin);
+			}
+
+			for (auto kernel : kernels) {
+				uint32_t dominates, dominated;
+				kernel(points, p, begin, dominates, dominated);
+
+				if (dominates != expected_dominates || dominated != expected_dominated) {
+					FAIL( "Different masks of solution " << p << " and the block at " << begin );
+				}
+			}
+		}
+	}
+
+	REQUIRE( kernels.size() >= 1 );
+}
+
+SCENARIO("algorithms::PoolExecutor test")
+{
+	std::string data_dir(__FILE__);
+	data_dir = (data_dir.rfind('/') == std::string::npos ? "." : data_dir.substr(0, data_dir.rfind('/'))) + "/data/";
+
+	auto executor = std::make_shared<algorithms::PoolExecutor>(4, 2);
+
+	// Every task runs once, whatever its cost
+	std::vector<double> costs = { 1.0, 40.0, 2.0, 2.0, 0.0, 17.0, 1.0, 3.0, 5.0, 40.0, 1.0 };
+	std::vector<std::atomic<int>> num_runs(costs.size());
+
+	for (auto &n : num_runs) {
+		n = 0;
+	}
+
+	executor->Run(costs.size(), costs, [&num_runs](int i) { ++num_runs[i]; });
+
+	for (int i = 0; i < num_runs.size(); ++i) {
+		REQUIRE( num_runs[i] == 1 );
+	}
+
+	executor->Run(0, {}, [](int) { FAIL( "No tasks to run" ); });
+
+	REQUIRE( executor->LastStats().num_threads == 4 );
+	REQUIRE( executor->LastStats().Utilization() <= 1.0 );
+
+	REQUIRE_THROWS( executor->Run(3, {}, [](int i) { if (i == 1) throw std::runtime_error("Task failed"); }) );
+
+	// Calls from several threads, e.g. GAs sharing the executor, keep their tasks apart
+	std::vector<std::atomic<int>> first_runs(100), second_runs(100);
+
+	for (int i = 0; i < 100; ++i) {
+		first_runs[i] = second_runs[i] = 0;
+	}
+
+	std::thread other([&executor, &second_runs]() {
+		for (int r = 0; r < 20; ++r) {
+			executor->Run(second_runs.size(), {}, [&second_runs](int i) { ++second_runs[i]; });
+		}
+	});
+
+	for (int r = 0; r < 20; ++r) {
+		executor->Run(first_runs.size(), {}, [&first_runs](int i) { ++first_runs[i]; });
+	}
+
+	other.join();
+
+	for (int i = 0; i < 100; ++i) {
+		REQUIRE( first_runs[i] == 20 );
+		REQUIRE( second_runs[i] == 20 );
+	}
+
+	// The same front as with the OpenMP loop, as the evaluations are independent
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+
+	auto simple = io::LoadSingleSiteSimple(data_dir + "deterministic_single_site_simple", "2016-12-01", objectives);
+	deterministic::SingleSiteSimpleModel model(simple.input_data);
+
+	algorithms::GAParams params;
+	params.popsize = 20;
+
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+
+	algorithms::NSGAII<Chromosome, deterministic::SingleSiteSimpleModel> nsgaii(model, 7, 1);
+	algorithms::InitPopulation(nsgaii, params, simple.input_data);
+
+	for (int gen = 0; gen < 20; ++gen) {
+		nsgaii.Update();
+	}
+
+	auto front = nsgaii.TopFront();
+
+	algorithms::NSGAII<Chromosome, deterministic::SingleSiteSimpleModel> pool_nsgaii(model, 7, 1);
+	pool_nsgaii.SetExecutor(executor);
+	algorithms::InitPopulation(pool_nsgaii, params, simple.input_data);
+
+	for (int gen = 0; gen < 20; ++gen) {
+		pool_nsgaii.Update();
+	}
+
+	auto pool_front = pool_nsgaii.TopFront();
+
+	REQUIRE( front.size() == pool_front.size() );
+
+	for (int i = 0; i < front.size(); ++i) {
+		REQUIRE( front[i].objectives[0] == pool_front[i].objectives[0] );
+		REQUIRE( front[i].objectives[1] == pool_front[i].objectives[1] );
+	}
+
+	REQUIRE( executor->TotalStats().busy_seconds > 0.0 );
+}
+
+SCENARIO("utils::NumaNodeCpus and per-GA thread pools test")
+{
+	REQUIRE( utils::ParseCpuList("0-3,8,10-11\n") == std::vector<int>({ 0, 1, 2, 3, 8, 10, 11 }) );
+	REQUIRE( utils::ParseCpuList("").empty() );
+
+	auto nodes = utils::NumaNodeCpus();
+	REQUIRE( nodes.size() >= 1 );
+
+	for (const auto &cpus : nodes) {
+		REQUIRE( cpus.size() >= 1 );
+	}
+
+#if defined(__linux__)
+	// To a CPU the process may run on, the nodes can list others
+	cpu_set_t allowed;
+	REQUIRE( sched_getaffinity(0, sizeof(allowed), &allowed) == 0 );
+
+	int cpu = 0;
+
+	while (!CPU_ISSET(cpu, &allowed)) {
+		++cpu;
+	}
+
+	algorithms::PoolExecutor pinned(2, 4, { cpu });
+	REQUIRE( pinned.Pinned() );
+
+	std::atomic<int> num_runs(0);
+	pinned.Run(10, {}, [&num_runs](int) { ++num_runs; });
+	REQUIRE( num_runs == 10 );
+#endif
+
+	// The GAs leave the OpenMP settings of the process alone
+	deterministic::SingleSiteSimpleModel model;
+	int num_omp_threads = omp_get_max_threads();
+
+	algorithms::NSGAII<types::NSGAChromosome<types::SingleSiteSimpleGene>, deterministic::SingleSiteSimpleModel> serial(model, 1, 1);
+	algorithms::NSGAII<types::NSGAChromosome<types::SingleSiteSimpleGene>, deterministic::SingleSiteSimpleModel> parallel(model, 1, 2);
+
+	REQUIRE( omp_get_max_threads() == num_omp_threads );
+	REQUIRE( serial.GetExecutor() == nullptr );
+	REQUIRE( (parallel.GetExecutor() != nullptr) == (std::thread::hardware_concurrency() > 1) );
+
+	// 0, as -1, uses all the hardware threads
+	algorithms::NSGAII<types::NSGAChromosome<types::SingleSiteSimpleGene>, deterministic::SingleSiteSimpleModel> all(model, 1, 0);
+	REQUIRE( (all.GetExecutor() != nullptr) == (std::thread::hardware_concurrency() > 1) );
+
+	if (all.GetExecutor()) {
+		REQUIRE( all.GetExecutor()->NumThreads() == std::thread::hardware_concurrency() );
+	}
+}
+
+SCENARIO("utils::LockFreeQueue test")
+{
+	utils::LockFreeQueue<int> queue(3);
+	int value;
+
+	REQUIRE( queue.Capacity() == 4 );
+	REQUIRE( !queue.TryPop(value) );
+
+	for (int i = 0; i < 4; ++i) {
+		REQUIRE( queue.TryPush(i) );
+	}
+
+	REQUIRE( !queue.TryPush(4) );
+
+	for (int i = 0; i < 4; ++i) {
+		REQUIRE( queue.TryPop(value) );
+		REQUIRE( value == i );
+	}
+
+	// Every value pushed by the producers is popped once by the consumers
+	utils::LockFreeQueue<int> shared(64);
+	std::atomic<long long> sum(0);
+	std::atomic<int> num_popped(0);
+	std::vector<std::thread> threads;
+	int num_values = 10000;
+
+	for (int t = 0; t < 2; ++t) {
+		threads.emplace_back([&shared, num_values, t]() {
+			for (int i = t * num_values; i < (t + 1) * num_values; ++i) {
+				while (!shared.TryPush(i)) {
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		threads.emplace_back([&shared, &sum, &num_popped, num_values]() {
+			int popped;
+
+			while (num_popped < 2 * num_values) {
+				if (shared.TryPop(popped)) {
+					sum += popped;
+					++num_popped;
+				}
+				else {
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	REQUIRE( num_popped == 2 * num_values );
+	REQUIRE( sum == (long long)(2 * num_values) * (2 * num_values - 1) / 2 );
+}
+
+// Throws on the 'num_calls'th call, shared by the copies
+struct FailingModel
+{
+	deterministic::SingleSiteSimpleModel model;
+	std::shared_ptr<std::atomic<int>> num_calls;
+
+	template<class Chromosome>
+	void operator()(Chromosome &individual)
+	{
+		if (--*num_calls == 0) {
+			throw std::runtime_error("Evaluation failed");
+		}
+
+		model(individual);
+	}
+};
+
+SCENARIO("algorithms::SingleObjectiveGA::UpdateAsync and algorithms::NSGAII::UpdateAsync test")
+{
+	std::string data_dir(__FILE__);
+	data_dir = (data_dir.rfind('/') == std::string::npos ? "." : data_dir.substr(0, data_dir.rfind('/'))) + "/data/";
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+
+	std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> constraints;
+	constraints.emplace(deterministic::TOTAL_KG_BACKLOG, std::make_pair(-1, 0));
+
+	auto simple = io::LoadSingleSiteSimple(data_dir + "deterministic_single_site_simple", "2016-12-01", objectives, &constraints);
+	deterministic::SingleSiteSimpleModel model(simple.input_data);
+
+	algorithms::GAParams params;
+	params.popsize = 20;
+
+	typedef types::SingleObjectiveChromosome<types::SingleSiteSimpleGene> Chromosome;
+
+	// In the calling thread the runs are repeatable, and the parents only get better
+	algorithms::SingleObjectiveGA<Chromosome, deterministic::SingleSiteSimpleModel> ga(model, 3, 1);
+	algorithms::InitPopulation(ga, params, simple.input_data);
+	auto initial_top = ga.Top();
+
+	ga.UpdateAsync(400);
+	auto top = ga.Top();
+
+	REQUIRE( ga.Parents().size() == params.popsize );
+	REQUIRE( top.constraints <= initial_top.constraints );
+
+	if (top.constraints == utils::Approx(initial_top.constraints)) {
+		REQUIRE( top.objective <= initial_top.objective );
+	}
+
+	algorithms::SingleObjectiveGA<Chromosome, deterministic::SingleSiteSimpleModel> repeated_ga(model, 3, 1);
+	algorithms::InitPopulation(repeated_ga, params, simple.input_data);
+	repeated_ga.UpdateAsync(400);
+
+	REQUIRE( repeated_ga.Top().objective == top.objective );
+	REQUIRE( repeated_ga.Top().constraints == top.constraints );
+
+	// With a pool, after generational updates and with the archive
+	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+	auto multi = io::LoadSingleSiteSimple(data_dir + "deterministic_single_site_simple", "2016-12-01", objectives);
+	deterministic::SingleSiteSimpleModel multi_model(multi.input_data);
+
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> NSGAChromosome;
+
+	auto executor = std::make_shared<algorithms::PoolExecutor>(2);
+	algorithms::NSGAII<NSGAChromosome, deterministic::SingleSiteSimpleModel> nsgaii(multi_model, 3, 1);
+	nsgaii.SetExecutor(executor);
+	nsgaii.UseArchive(true);
+	algorithms::InitPopulation(nsgaii, params, multi.input_data);
+
+	nsgaii.Update();
+	nsgaii.UpdateAsync(400);
+
+	REQUIRE( nsgaii.Parents().size() == params.popsize );
+	REQUIRE( executor->LastStats().num_threads == 2 );
+	REQUIRE( executor->LastStats().busy_seconds > 0.0 );
+
+	auto front = nsgaii.TopFront();
+	auto archive = nsgaii.Archive();
+
+	REQUIRE( front.size() >= 1 );
+
+	// Every solution of the front is in the archive or dominated by one there
+	for (const auto &solution : front) {
+		bool covered = false;
+
+		for (const auto &archived : archive) {
+			covered |= archived.objectives[0] <= solution.objectives[0] + 1E-9 && archived.objectives[1] <= solution.objectives[1] + 1E-9;
+		}
+
+		REQUIRE( covered );
+	}
+
+	// A failed evaluation stops the workers and is rethrown
+	FailingModel failing = { multi_model, std::make_shared<std::atomic<int>>(params.popsize + 50) };
+	algorithms::NSGAII<NSGAChromosome, FailingModel> failing_nsgaii(failing, 3, 1);
+	failing_nsgaii.SetExecutor(executor);
+	algorithms::InitPopulation(failing_nsgaii, params, multi.input_data);
+
+	REQUIRE_THROWS( failing_nsgaii.UpdateAsync(400) );
+}
+
+SCENARIO("algorithms::NSGAII::UseCutoff and algorithms::SingleObjectiveGA::UseCutoff test")
+{
+	std::string data_dir(__FILE__);
+	data_dir = (data_dir.rfind('/') == std::string::npos ? "." : data_dir.substr(0, data_dir.rfind('/'))) + "/data/";
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+
+	std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> constraints;
+	constraints.emplace(deterministic::TOTAL_KG_BACKLOG, std::make_pair(-1, 0));
+
+	auto simple = io::LoadSingleSiteSimple(data_dir + "deterministic_single_site_simple", "2016-12-01", objectives, &constraints);
+	deterministic::SingleSiteSimpleModel model(simple.input_data);
+
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+
+	// A single short campaign leaves a backlog early in the horizon
+	Chromosome short_plan;
+	short_plan.genes.push_back(types::SingleSiteSimpleGene());
+	short_plan.genes.back().product_num = 1;
+	short_plan.genes.back().num_batches = 3;
+
+	Chromosome full_plan = short_plan;
+	model(full_plan);
+
+	deterministic::SingleSiteSimpleModel::Workspace workspace;
+	workspace.cutoff.constraints = 0.0;
+	model.EvaluateBatch(&short_plan, &short_plan + 1, workspace);
+
+	int num_periods = simple.input_data.num_products * simple.input_data.num_periods;
+
+	REQUIRE( short_plan.truncated );
+	REQUIRE( !full_plan.truncated );
+	REQUIRE( short_plan.constraints > 0.0 );
+	REQUIRE( short_plan.constraints <= full_plan.constraints );
+	REQUIRE( workspace.stats.num_evaluations == 1 );
+	REQUIRE( workspace.stats.num_cut_off == 1 );
+	REQUIRE( workspace.stats.num_periods_saved > 0 );
+	REQUIRE( workspace.stats.num_periods + workspace.stats.num_periods_saved == num_periods );
+
+	// The survivors of a deterministic model are the same with the cutoff
+	algorithms::GAParams params;
+	params.popsize = 20;
+
+	algorithms::NSGAII<Chromosome, deterministic::SingleSiteSimpleModel> nsgaii(model, 5, 1);
+	nsgaii.UseArchive(true);
+	algorithms::InitPopulation(nsgaii, params, simple.input_data);
+
+	for (int gen = 0; gen < 20; ++gen) {
+		nsgaii.Update();
+	}
+
+	algorithms::NSGAII<Chromosome, deterministic::SingleSiteSimpleModel> cutoff_nsgaii(model, 5, 1);
+	cutoff_nsgaii.SetExecutor(std::make_shared<algorithms::PoolExecutor>(2));
+	cutoff_nsgaii.UseCutoff(true);
+	cutoff_nsgaii.UseArchive(true);
+	algorithms::InitPopulation(cutoff_nsgaii, params, simple.input_data);
+
+	for (int gen = 0; gen < 20; ++gen) {
+		cutoff_nsgaii.Update();
+	}
+
+	auto parents = nsgaii.Parents(), cutoff_parents = cutoff_nsgaii.Parents();
+	const auto &stats = cutoff_nsgaii.GetCutoffStats();
+
+	REQUIRE( parents.size() == cutoff_parents.size() );
+
+	for (int i = 0; i < parents.size(); ++i) {
+		REQUIRE( !cutoff_parents[i].truncated );
+		REQUIRE( parents[i].objectives == cutoff_parents[i].objectives );
+		REQUIRE( parents[i].constraints == cutoff_parents[i].constraints );
+	}
+
+	// The archive is offered the fully evaluated offspring only
+	auto archived = nsgaii.Archive(), cutoff_archived = cutoff_nsgaii.Archive();
+
+	REQUIRE( archived.size() == cutoff_archived.size() );
+
+	for (int i = 0; i < archived.size(); ++i) {
+		REQUIRE( !cutoff_archived[i].truncated );
+		REQUIRE( archived[i].objectives == cutoff_archived[i].objectives );
+	}
+
+	REQUIRE( nsgaii.GetCutoffStats().num_cut_off == 0 );
+	REQUIRE( stats.num_evaluations == (1 + 20) * params.popsize ); // With the initial population
+	REQUIRE( stats.num_cut_off > 0 );
+	REQUIRE( stats.num_periods + stats.num_periods_saved == stats.num_evaluations * num_periods );
+	REQUIRE( stats.SavedFraction() > 0.0 );
+
+	// With a minimised objective, which the worst parent bounds once it is feasible
+	std::unordered_map<deterministic::OBJECTIVES, int> deficit;
+	deficit.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+
+	auto deficit_simple = io::LoadSingleSiteSimple(data_dir + "deterministic_single_site_simple", "2016-12-01", deficit);
+	deterministic::SingleSiteSimpleModel deficit_model(deficit_simple.input_data);
+
+	typedef types::SingleObjectiveChromosome<types::SingleSiteSimpleGene> SingleObjectiveChromosome;
+
+	algorithms::SingleObjectiveGA<SingleObjectiveChromosome, deterministic::SingleSiteSimpleModel> ga(deficit_model, 5, 1);
+	algorithms::InitPopulation(ga, params, deficit_simple.input_data);
+
+	for (int gen = 0; gen < 20; ++gen) {
+		ga.Update();
+	}
+
+	algorithms::SingleObjectiveGA<SingleObjectiveChromosome, deterministic::SingleSiteSimpleModel> cutoff_ga(deficit_model, 5, 1);
+	cutoff_ga.UseCutoff(true);
+	algorithms::InitPopulation(cutoff_ga, params, deficit_simple.input_data);
+
+	for (int gen = 0; gen < 20; ++gen) {
+		cutoff_ga.Update();
+	}
+
+	auto ga_parents = ga.Parents(), cutoff_ga_parents = cutoff_ga.Parents();
+
+	for (int i = 0; i < ga_parents.size(); ++i) {
+		REQUIRE( ga_parents[i].objective == cutoff_ga_parents[i].objective );
+	}
+
+	REQUIRE( cutoff_ga.GetCutoffStats().num_cut_off > 0 );
+}
+
+SCENARIO("metrics known values test")
+{
+	metrics::Points front_2d = { { 1, 3 }, { 2, 2 }, { 3, 1 }, { 3, 3 }, { 5, 0 } };
+	metrics::Points front_3d = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 1, 1, 1 }, { 3, 0, 0 } };
+
+	REQUIRE( metrics::Hypervolume(front_2d, { 4, 4 }) == Approx(6.0) );
+	REQUIRE( metrics::Hypervolume(front_3d, { 2, 2, 2 }) == Approx(7.0) );
+	REQUIRE( metrics::Hypervolume(metrics::Points{ { 1 }, { 2 } }, { 4 }) == Approx(3.0) );
+
+	REQUIRE( metrics::IGD(metrics::Points{ { -1, 1 } }, metrics::Points{ { 0, 0 } }) == Approx(std::sqrt(2.0)) );
+	REQUIRE( metrics::IGDPlus(metrics::Points{ { -1, 1 } }, metrics::Points{ { 0, 0 } }) == Approx(1.0) );
+	REQUIRE( metrics::Epsilon(metrics::Points{ { 1, 2 } }, metrics::Points{ { 0, 0 }, { 1, 1 } }) == Approx(2.0) );
+
+	metrics::Points uniform = { { 0, 2 }, { 1, 1 }, { 2, 0 } };
+	REQUIRE( metrics::Spread(uniform, uniform) == Approx(0.0) );
+	REQUIRE( metrics::Spread(metrics::Points{ { 0, 2 }, { 0.1, 1.9 }, { 2, 0 } }) > 0.0 );
+}
+
+SCENARIO("algorithms::NDTreeArchive test")
+{
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+
+	auto solution = [](std::vector<double> objectives, double constraints) {
+		Chromosome c;
+		c.objectives = objectives;
+		c.constraints = constraints;
+		return c;
+	};
+
+	auto contains = [](const std::vector<Chromosome> &front, std::vector<double> objectives) {
+		for (const auto &c : front) {
+			if (c.objectives[0] == objectives[0] && c.objectives[1] == objectives[1]) {
+				return true;
+			}
+		}
+
+		return false;
+	};
+
+	// Leaves of at most 4 solutions, split into 3 children
+	algorithms::NDTreeArchive<Chromosome> archive(4);
+
+	for (int i = 0; i <= 12; ++i) {
+		REQUIRE( archive.Update(solution({ (double)i, 12.0 - i }, 1.0)) );
+	}
+
+	REQUIRE( archive.Size() == 13 );
+
+	auto front = archive.Front();
+	REQUIRE( front.size() == 13 );
+
+	for (int i = 0; i < front.size(); ++i) {
+		REQUIRE( front[i].objectives[0] == 12.0 - i );
+	}
+
+	// Dominated and equal within utils::Approx
+	REQUIRE( !archive.Update(solution({ 3.0, 10.0 }, 1.0)) );
+	REQUIRE( !archive.Update(solution({ 3.0, 9.0 + 1E-9 }, 1.0)) );
+	REQUIRE( archive.Size() == 13 );
+
+	// Dominates (3, 9), (4, 8), (5, 7) and (6, 6)
+	REQUIRE( archive.Update(solution({ 2.5, 5.5 }, 1.0)) );
+	REQUIRE( archive.Size() == 10 );
+
+	front = archive.Front();
+	REQUIRE( front.size() == 10 );
+	REQUIRE( contains(front, { 2.5, 5.5 }) );
+	REQUIRE( contains(front, { 2.0, 10.0 }) );
+	REQUIRE( contains(front, { 7.0, 5.0 }) );
+
+	for (int i = 3; i <= 6; ++i) {
+		REQUIRE( !contains(front, { (double)i, 12.0 - i }) );
+	}
+
+	// A copy keeps its own tree
+	auto copy = archive;
+
+	// Worse constraints are rejected, better ones replace the whole archive
+	REQUIRE( !archive.Update(solution({ -1.0, -1.0 }, 2.0)) );
+	REQUIRE( archive.Update(solution({ 20.0, 20.0 }, 0.5)) );
+	REQUIRE( archive.Size() == 1 );
+	REQUIRE( archive.Front()[0].constraints == 0.5 );
+
+	REQUIRE( copy.Size() == 10 );
+
+	// Dominates every solution across the leaves
+	REQUIRE( copy.Update(solution({ -1.0, -1.0 }, 1.0)) );
+	REQUIRE( copy.Size() == 1 );
+	REQUIRE( copy.Front().size() == 1 );
+
+	// Random points against all the pairs
+	utils::set_seed(3);
+
+	std::vector<Chromosome> points;
+	algorithms::NDTreeArchive<Chromosome> random_archive(4);
+
+	for (int i = 0; i < 300; ++i) {
+		points.push_back(solution({ utils::random(), utils::random(), utils::random() }, 0.0));
+		random_archive.Update(points.back());
+	}
+
+	int expected_size = 0;
+
+	for (const auto &p : points) {
+		bool dominated = false;
+
+		for (const auto &q : points) {
+			bool q_better = false, p_better = false;
+
+			for (int m = 0; m < 3; ++m) {
+				q_better |= q.objectives[m] < p.objectives[m];
+				p_better |= p.objectives[m] < q.objectives[m];
+			}
+
+			dominated |= q_better && !p_better;
+		}
+
+		expected_size += !dominated;
+	}
+
+	REQUIRE( random_archive.Size() == expected_size );
+	REQUIRE( random_archive.Front().size() == expected_size );
+}
+
+SCENARIO("io::HistoryWriter and io::HistoryReader test")
+{
+	typedef types::NSGAChromosome<types::SingleSiteMultiSuiteGene> Chromosome;
+
+	const char *path = "history_test.bin";
+
+	{
+		io::HistoryWriter<Chromosome> writer(path, { "total_profit", "total_backlog_penalty" });
+
+		for (int run = 0; run < 2; ++run) {
+			for (int gen = 0; gen < 10; ++gen) {
+				std::vector<Chromosome> front(3);
+
+				for (int i = 0; i < front.size(); ++i) {
+					front[i].objectives = { -100.0 * gen - i, 0.5 * run };
+					front[i].constraints = run;
+					front[i].genes.resize(i);
+
+					for (int g = 0; g < i; ++g) {
+						front[i].genes[g].product_num = g + 1;
+						front[i].genes[g].usp_suite_num = 2;
+						front[i].genes[g].num_batches = 1000 * gen + g;
+					}
+				}
+
+				writer.Write(run, gen, front);
+			}
+		}
+	}
+
+	{
+		io::HistoryReader reader(path);
+
+		REQUIRE( reader.NumFrames() == 20 );
+		REQUIRE( reader.NumRuns() == 2 );
+		REQUIRE( reader.NumGens(1) == 10 );
+		REQUIRE( reader.ObjectiveNames()[1] == "total_backlog_penalty" );
+		REQUIRE_THROWS( reader.Frame(2, 0) );
+
+		auto front = reader.Front<Chromosome>(1, 7);
+
+		REQUIRE( front.size() == 3 );
+		REQUIRE( front[0].genes.empty() );
+		REQUIRE( front[2].genes.size() == 2 );
+		REQUIRE( front[2].genes[1].usp_suite_num == 2 );
+		REQUIRE( front[2].genes[1].num_batches == 7001 );
+		REQUIRE( front[2].objectives[0] == Approx(-702.0) );
+		REQUIRE( front[2].constraints == Approx(1.0) );
+	}
+
+	std::remove(path);
+}
+
+
+SCENARIO("io::MessageBuffer and io::PayloadReader test")
+{
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+
+	std::vector<Chromosome> front(2);
+	front[0].objectives = { -574.4, 194.6 };
+	front[0].constraints = 0.0;
+	front[0].genes.resize(2);
+	front[0].genes[0].product_num = 1;
+	front[0].genes[0].num_batches = 15;
+	front[0].genes[1].product_num = 3;
+	front[0].genes[1].num_batches = 9;
+	front[1].objectives = { -600.0, 300.0 };
+	front[1].constraints = 1.5;
+
+	std::string frame, body, payload;
+	io::EncodeFrame(1, 20, front, frame, body);
+	io::WriteString("settings", payload);
+	io::WriteZigZag(-3, payload);
+	io::WriteDouble(0.25, payload);
+	payload += frame;
+
+	std::string stream = io::EncodeMessage(io::FRONT_REPLY, 300, payload) + io::EncodeMessage(io::DONE_REPLY, 7, "");
+
+	// Arrives one byte at a time
+	io::MessageBuffer buffer;
+	std::vector<io::Message> messages;
+	io::Message message;
+
+	for (char byte : stream) {
+		buffer.Append(&byte, 1);
+
+		while (buffer.Next(message)) {
+			messages.push_back(message);
+		}
+	}
+
+	REQUIRE( messages.size() == 2 );
+	REQUIRE( messages[0].type == io::FRONT_REPLY );
+	REQUIRE( messages[0].job_id == 300 );
+	REQUIRE( messages[1].type == io::DONE_REPLY );
+	REQUIRE( messages[1].payload.empty() );
+
+	io::PayloadReader reader(messages[0].payload);
+
+	REQUIRE( reader.String() == "settings" );
+	REQUIRE( reader.ZigZag() == -3 );
+	REQUIRE( reader.Double() == 0.25 );
+
+	auto decoded = reader.Frame();
+
+	REQUIRE( reader.AtEnd() );
+	REQUIRE( decoded.run == 1 );
+	REQUIRE( decoded.gen == 20 );
+	REQUIRE( decoded.num_fields == 2 );
+	REQUIRE( decoded.objectives[1][1] == Approx(300.0) );
+	REQUIRE( decoded.constraints[1] == Approx(1.5) );
+	REQUIRE( decoded.fields[0] == std::vector<int>({ 1, 15, 3, 9 }) );
+	REQUIRE( decoded.fields[1].empty() );
+	REQUIRE_THROWS( reader.Varint() );
+
+	io::MessageBuffer corrupted;
+	std::string too_large;
+	io::WriteVarint(io::MAX_MESSAGE_SIZE + 1, too_large);
+	corrupted.Append(too_large.data(), too_large.size());
+
+	REQUIRE_THROWS( corrupted.Next(message) );
+}
+
+
+SCENARIO("io::ResultCache test")
+{
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+
+	std::string data_dir(__FILE__);
+	data_dir = (data_dir.rfind('/') == std::string::npos ? "." : data_dir.substr(0, data_dir.rfind('/'))) + "/data/";
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+
+	auto simple = io::LoadSingleSiteSimple(data_dir + "deterministic_single_site_simple", "2016-12-01", objectives);
+	auto changed = simple;
+	changed.input_data.kg_demand[0][5] += 0.1;
+
+	std::vector<Chromosome> seeds(1), solutions(3), population(5);
+	seeds[0].genes.resize(1);
+	seeds[0].genes[0].product_num = 2;
+	seeds[0].genes[0].num_batches = 4;
+
+	for (int i = 0; i < population.size(); ++i) {
+		population[i].objectives = { -1.0 * i, 2.0 * i };
+		population[i].constraints = 0.5 * i;
+		population[i].genes = seeds[0].genes;
+		population[i].genes[0].num_batches = i;
+	}
+
+	std::copy(population.begin(), population.begin() + 3, solutions.begin());
+
+	auto key = io::FitKey(simple.input_data, "(10, 100, 7)", seeds);
+
+	REQUIRE( key == io::FitKey(simple.input_data, "(10, 100, 7)", seeds) );
+	REQUIRE( key != io::FitKey(changed.input_data, "(10, 100, 7)", seeds) );
+	REQUIRE( key != io::FitKey(simple.input_data, "(10, 100, 8)", seeds) );
+	REQUIRE( key != io::FitKey(simple.input_data, "(10, 100, 7)", std::vector<Chromosome>()) );
+
+	const char *dir = "result_cache_test";
+	std::vector<Chromosome> cached_solutions, cached_population;
+
+	{
+		io::ResultCache cache(dir);
+
+		REQUIRE( !cache.Load(key, cached_solutions, cached_population) );
+
+		cache.Store(key, solutions, population);
+
+		REQUIRE( cache.Load(key, cached_solutions, cached_population) );
+		REQUIRE( cached_solutions.size() == 3 );
+		REQUIRE( cached_population.size() == 5 );
+		REQUIRE( cached_solutions[2].objectives == solutions[2].objectives );
+		REQUIRE( cached_population[4].constraints == Approx(2.0) );
+		REQUIRE( cached_population[4].genes[0].product_num == 2 );
+		REQUIRE( cached_population[4].genes[0].num_batches == 4 );
+	}
+
+	{
+		// Room for a single entry, the older one is evicted
+		io::ResultCache cache(dir, 1);
+		auto other_key = io::FitKey(changed.input_data, "(10, 100, 7)", seeds);
+
+		cache.Store(other_key, solutions, population);
+
+		REQUIRE( cache.Load(other_key, cached_solutions, cached_population) );
+		REQUIRE( !cache.Load(key, cached_solutions, cached_population) );
+
+		std::remove((std::string(dir) + "/" + [&other_key]() {
+			char name[32];
+			std::snprintf(name, sizeof(name), "%016llx.fit", (unsigned long long)io::HashKey(other_key));
+			return std::string(name);
+		}()).c_str());
+	}
+
+	rmdir(dir);
+}
+
+
+SCENARIO("io::LoadSingleSiteSimple and io::LoadSingleSiteMultiSuite test")
+{
+	std::string data_dir(__FILE__);
+	data_dir = (data_dir.rfind('/') == std::string::npos ? "." : data_dir.substr(0, data_dir.rfind('/'))) + "/data/";
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+
+	std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> constraints;
+	constraints.emplace(deterministic::TOTAL_KG_BACKLOG, std::make_pair(-1, 0));
+	constraints.emplace(deterministic::TOTAL_KG_WASTE, std::make_pair(-1, 0));
+
+	auto simple = io::LoadSingleSiteSimple(
+		data_dir + "deterministic_single_site_simple", 
+		"2016-12-01", 
+		objectives, 
+		&constraints
+	);
+
+	REQUIRE( simple.product_labels == std::vector<std::string>({ "A", "B", "C", "D" }) );
+	REQUIRE( simple.due_dates.front() == "2017-01-01" );
+	REQUIRE( simple.input_data.num_periods == 36 );
+	REQUIRE( simple.input_data.days_per_period[2] == 28 );
+	REQUIRE( simple.input_data.kg_yield_per_batch == std::vector<double>({ 3.1, 6.2, 4.9, 5.5 }) );
+	REQUIRE( simple.input_data.kg_inventory_target.size() == 4 );
+
+	// Same solution as in the known solution test
+	types::NSGAChromosome<types::SingleSiteSimpleGene> i;
+
+	int genes[11][2] = { { 4, 15 }, { 3, 9 }, { 1, 28 }, { 2, 2 }, { 4, 15 }, { 3, 8 }, { 1, 10 }, { 3, 3 }, { 2, 2 }, { 1, 3 }, { 4, 29 } };
+
+	for (const auto &gene : genes) {
+		i.genes.push_back(types::SingleSiteSimpleGene());
+		i.genes.back().product_num = gene[0];
+		i.genes.back().num_batches = gene[1];
+	}
+
+	deterministic::SingleSiteSimpleModel deterministic_fitness(simple.input_data);
+	types::SingleSiteSimpleSchedule schedule;
+
+	deterministic_fitness.CreateSchedule(i, schedule);
+
+	REQUIRE( schedule.objectives[deterministic::TOTAL_KG_THROUGHPUT] == Approx(574.4) );
+	REQUIRE( schedule.objectives[deterministic::TOTAL_KG_INVENTORY_DEFICIT] == Approx(194.6) );
+
+	auto multi_suite = io::LoadSingleSiteMultiSuite(
+		data_dir + "deterministic_single_site_multi_suite_ex1", 
+		"2016-11-02", 
+		objectives, 
+		2, 
+		2
+	);
+
+	REQUIRE( multi_suite.product_labels.size() == multi_suite.input_data.num_products );
+	REQUIRE( multi_suite.input_data.usp_days[1] == Approx(22.2) );
+	REQUIRE( multi_suite.input_data.dsp_changeovers[2][0] == Approx(12.5) );
+
+	REQUIRE_THROWS( io::LoadSingleSiteSimple(data_dir + "deterministic_single_site_multi_suite_ex1", "2016-12-01", objectives) );
+	REQUIRE_THROWS( io::LoadSingleSiteMultiSuite(data_dir + "deterministic_single_site_multi_suite_ex1", "2016-12", objectives, 2, 2) );
+	REQUIRE_THROWS( io::CSVTable(data_dir + "missing.csv") );
+}
+
+
+SCENARIO("deterministic::SingleSiteSimpleModel::EvaluateBatch and deterministic::SingleSiteMultiSuiteModel::EvaluateBatch test")
+{
+	std::string data_dir(__FILE__);
+	data_dir = (data_dir.rfind('/') == std::string::npos ? "." : data_dir.substr(0, data_dir.rfind('/'))) + "/data/";
+
+	utils::set_seed(7);
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+
+	auto simple = io::LoadSingleSiteSimple(data_dir + "deterministic_single_site_simple", "2016-12-01", objectives);
+	deterministic::SingleSiteSimpleModel simple_model(simple.input_data);
+
+	// Mixed lengths, so that a schedule is reused after a longer one
+	std::vector<types::NSGAChromosome<types::SingleSiteSimpleGene>> simple_chromosomes(30);
+
+	for (auto &chromosome : simple_chromosomes) {
+		int num_genes = utils::random_int(1, 15);
+
+		for (int g = 0; g < num_genes; ++g) {
+			chromosome.genes.push_back(types::SingleSiteSimpleGene());
+			chromosome.genes.back().product_num = utils::random_int(1, simple.input_data.num_products);
+			chromosome.genes.back().num_batches = utils::random_int(1, 30);
+		}
+	}
+
+	auto batch_simple_chromosomes = simple_chromosomes;
+	auto parallel_simple_chromosomes = simple_chromosomes;
+
+	deterministic::SingleSiteSimpleModel::Workspace simple_workspace;
+	simple_model.EvaluateBatch(batch_simple_chromosomes.data(), batch_simple_chromosomes.data() + batch_simple_chromosomes.size(), simple_workspace);
+
+	for (int c = 0; c < simple_chromosomes.size(); ++c) {
+		simple_model(simple_chromosomes[c]);
+
+		REQUIRE( batch_simple_chromosomes[c].objectives == simple_chromosomes[c].objectives );
+		REQUIRE( batch_simple_chromosomes[c].constraints == simple_chromosomes[c].constraints );
+	}
+
+	// The same in parallel, a workspace per thread
+	deterministic::EvaluateBatch(simple_model, parallel_simple_chromosomes);
+
+	for (int c = 0; c < simple_chromosomes.size(); ++c) {
+		REQUIRE( parallel_simple_chromosomes[c].objectives == simple_chromosomes[c].objectives );
+	}
+
+	std::unordered_map<deterministic::OBJECTIVES, int> multi_suite_objectives;
+	multi_suite_objectives.emplace(deterministic::TOTAL_PROFIT, 1);
+
+	auto multi_suite = io::LoadSingleSiteMultiSuite(data_dir + "deterministic_single_site_multi_suite_ex1", "2016-11-02", multi_suite_objectives, 2, 2);
+	deterministic::SingleSiteMultiSuiteModel multi_suite_model(multi_suite.input_data);
+
+	types::SingleSiteMultiSuiteGene::Config config = { multi_suite.input_data.num_products, multi_suite.input_data.num_usp_suites, 0, 0, 0, 0 };
+	std::vector<types::SingleObjectiveChromosome<types::SingleSiteMultiSuiteGene>> multi_suite_chromosomes(30);
+
+	for (auto &chromosome : multi_suite_chromosomes) {
+		int num_genes = utils::random_int(1, 10);
+
+		for (int g = 0; g < num_genes; ++g) {
+			chromosome.genes.push_back(types::SingleSiteMultiSuiteGene(&config));
+			chromosome.genes.back().num_batches = utils::random_int(1, 5);
+		}
+	}
+
+	auto batch_multi_suite_chromosomes = multi_suite_chromosomes;
+
+	deterministic::SingleSiteMultiSuiteModel::Workspace multi_suite_workspace;
+	multi_suite_model.EvaluateBatch(batch_multi_suite_chromosomes.data(), batch_multi_suite_chromosomes.data() + batch_multi_suite_chromosomes.size(), multi_suite_workspace);
+
+	for (int c = 0; c < multi_suite_chromosomes.size(); ++c) {
+		multi_suite_model(multi_suite_chromosomes[c]);
+
+		REQUIRE( batch_multi_suite_chromosomes[c].objective == multi_suite_chromosomes[c].objective );
+		REQUIRE( batch_multi_suite_chromosomes[c].constraints == multi_suite_chromosomes[c].constraints );
+	}
+}
+
+SCENARIO("deterministic::SingleSiteSimpleModel::UseDelta and algorithms::NSGAII::UseDelta test")
+{
+	std::string data_dir(__FILE__);
+	data_dir = (data_dir.rfind('/') == std::string::npos ? "." : data_dir.substr(0, data_dir.rfind('/'))) + "/data/";
+
+	utils::set_seed(13);
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+
+	std::unordered_map<deterministic::OBJECTIVES, std::pair<int, double>> constraints;
+	constraints.emplace(deterministic::TOTAL_KG_BACKLOG, std::make_pair(-1, 0));
+
+	auto simple = io::LoadSingleSiteSimple(data_dir + "deterministic_single_site_simple", "2016-12-01", objectives, &constraints);
+	deterministic::SingleSiteSimpleModel model(simple.input_data), delta_model = model;
+	delta_model.UseDelta(true);
+
+	typedef types::NSGAChromosome<types::SingleSiteSimpleGene> Chromosome;
+
+	std::vector<Chromosome> parents(10);
+
+	for (auto &parent : parents) {
+		for (int g = 0; g < 15; ++g) {
+			parent.genes.push_back(types::SingleSiteSimpleGene());
+			parent.genes.back().product_num = utils::random_int(1, simple.input_data.num_products);
+			parent.genes.back().num_batches = utils::random_int(1, 30);
+		}
+	}
+
+	deterministic::SingleSiteSimpleModel::Workspace workspace;
+	delta_model.EvaluateBatch(parents.data(), parents.data() + parents.size(), workspace);
+
+	REQUIRE( workspace.delta_stats.num_evaluations == parents.size() );
+	REQUIRE( workspace.delta_stats.num_with_parent == 0 );
+
+	// A late gene of every other offspring changes, the others are the same as their parents
+	std::vector<Chromosome> offspring;
+
+	for (int p = 0; p < parents.size(); ++p) {
+		REQUIRE( parents[p].snapshot );
+
+		offspring.push_back(parents[p]);
+
+		if (p % 2) {
+			auto &gene = offspring.back().genes[offspring.back().genes.size() - 1 - utils::random_int(0, 2)];
+			gene.num_batches = gene.num_batches > 3 ? gene.num_batches - 3 : gene.num_batches + 3;
+		}
+	}
+
+	auto delta_offspring = offspring;
+
+	workspace.delta_stats = types::DeltaStats();
+	delta_model.EvaluateBatch(delta_offspring.data(), delta_offspring.data() + delta_offspring.size(), workspace);
+
+	for (int c = 0; c < offspring.size(); ++c) {
+		model(offspring[c]);
+
+		REQUIRE( delta_offspring[c].objectives == offspring[c].objectives );
+		REQUIRE( delta_offspring[c].constraints == offspring[c].constraints );
+		REQUIRE( delta_offspring[c].genes.size() == offspring[c].genes.size() );
+		REQUIRE( delta_offspring[c].snapshot != parents[c].snapshot );
+	}
+
+	const auto &stats = workspace.delta_stats;
+	int num_products = simple.input_data.num_products;
+
+	REQUIRE( stats.num_evaluations == offspring.size() );
+	REQUIRE( stats.num_with_parent == offspring.size() );
+	REQUIRE( stats.num_products == offspring.size() * num_products );
+	REQUIRE( stats.num_products_reused >= offspring.size() / 2 * num_products ); // All of the unchanged offspring
+	REQUIRE( stats.ReusedFraction() > 0.0 );
+
+	// The snapshots of another model are not used
+	deterministic::SingleSiteSimpleModel other_model(simple.input_data);
+	other_model.UseDelta(true);
+
+	deterministic::SingleSiteSimpleModel::Workspace other_workspace;
+	other_model.EvaluateBatch(offspring.data(), offspring.data() + offspring.size(), other_workspace);
+
+	REQUIRE( other_workspace.delta_stats.num_with_parent == 0 );
+
+	// The survivors are the same with the snapshots
+	algorithms::GAParams params;
+	params.popsize = 20;
+
+	algorithms::NSGAII<Chromosome, deterministic::SingleSiteSimpleModel> nsgaii(model, 5, 1);
+	algorithms::InitPopulation(nsgaii, params, simple.input_data);
+
+	for (int gen = 0; gen < 20; ++gen) {
+		nsgaii.Update();
+	}
+
+	algorithms::NSGAII<Chromosome, deterministic::SingleSiteSimpleModel> delta_nsgaii(model, 5, 1);
+	delta_nsgaii.UseDelta(true);
+	algorithms::InitPopulation(delta_nsgaii, params, simple.input_data);
+
+	for (int gen = 0; gen < 20; ++gen) {
+		delta_nsgaii.Update();
+	}
+
+	auto nsgaii_parents = nsgaii.Parents(), delta_parents = delta_nsgaii.Parents();
+
+	REQUIRE( nsgaii_parents.size() == delta_parents.size() );
+
+	for (int i = 0; i < nsgaii_parents.size(); ++i) {
+		REQUIRE( nsgaii_parents[i].objectives == delta_parents[i].objectives );
+		REQUIRE( nsgaii_parents[i].constraints == delta_parents[i].constraints );
+	}
+
+	REQUIRE( nsgaii.GetDeltaStats().num_evaluations == 0 );
+	REQUIRE( delta_nsgaii.GetDeltaStats().num_evaluations == (1 + 20) * params.popsize ); // With the initial population
+	REQUIRE( delta_nsgaii.GetDeltaStats().num_with_parent > 0 );
+
+	// The individuals handed out of the GA do not keep the snapshots alive
+	delta_nsgaii.UseArchive(true);
+	delta_nsgaii.Update();
+
+	for (const auto &solutions : { delta_nsgaii.Parents(), delta_nsgaii.TopFront(), delta_nsgaii.Archive() }) {
+		REQUIRE( !solutions.empty() );
+
+		for (const auto &solution : solutions) {
+			REQUIRE( !solution.snapshot );
+		}
+	}
+}
+
+SCENARIO("deterministic::EvaluateObjectives and deterministic::CreateRecords test")
+{
+	std::string data_dir(__FILE__);
+	data_dir = (data_dir.rfind('/') == std::string::npos ? "." : data_dir.substr(0, data_dir.rfind('/'))) + "/data/";
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_KG_INVENTORY_DEFICIT, -1);
+	objectives.emplace(deterministic::TOTAL_KG_THROUGHPUT, 1);
+
+	auto simple = io::LoadSingleSiteSimple(data_dir + "deterministic_single_site_simple", "2016-12-01", objectives);
+	deterministic::SingleSiteSimpleModel model(simple.input_data);
+
+	// Known solution and its prefixes of 1 to 11 campaigns
+	int genes[11][2] = { { 4, 15 }, { 3, 9 }, { 1, 28 }, { 2, 2 }, { 4, 15 }, { 3, 8 }, { 1, 10 }, { 3, 3 }, { 2, 2 }, { 1, 3 }, { 4, 29 } };
+	std::vector<types::NSGAChromosome<types::SingleSiteSimpleGene>> chromosomes(11);
+
+	for (int c = 0; c < chromosomes.size(); ++c) {
+		for (int g = 0; g <= c; ++g) {
+			chromosomes[c].genes.push_back(types::SingleSiteSimpleGene());
+			chromosomes[c].genes.back().product_num = genes[g][0];
+			chromosomes[c].genes.back().num_batches = genes[g][1];
+		}
+	}
+
+	std::vector<std::vector<double>> batch_objectives;
+	std::vector<types::ScheduleRecords> records(chromosomes.size());
+	std::vector<types::ScheduleRecords*> records_ptrs;
+
+	for (auto &record : records) {
+		records_ptrs.push_back(&record);
+	}
+
+	deterministic::EvaluateObjectives<types::SingleSiteSimpleSchedule>(model, chromosomes, batch_objectives);
+	deterministic::CreateRecords<types::SingleSiteSimpleSchedule>(model, chromosomes, records_ptrs);
+	deterministic::EvaluateBatch(model, chromosomes);
+
+	REQUIRE( batch_objectives.size() == chromosomes.size() );
+	REQUIRE( batch_objectives.back()[deterministic::TOTAL_KG_THROUGHPUT] == Approx(574.4) );
+	REQUIRE( batch_objectives.back()[deterministic::TOTAL_KG_INVENTORY_DEFICIT] == Approx(194.6) );
+
+	// The same objectives with a single thread
+	std::vector<std::vector<double>> serial_objectives;
+	deterministic::EvaluateObjectives<types::SingleSiteSimpleSchedule>(model, chromosomes, serial_objectives, 1);
+	REQUIRE( serial_objectives == batch_objectives );
+
+	for (int c = 0; c < chromosomes.size(); ++c) {
+		types::SingleSiteSimpleSchedule schedule;
+		model.CreateSchedule(chromosomes[c], schedule);
+
+		REQUIRE( batch_objectives[c] == schedule.objectives );
+		REQUIRE( records[c].objectives == schedule.objectives );
+		REQUIRE( records[c].campaigns.size() == schedule.campaigns.size() );
+
+		for (int o = 0; o < simple.input_data.objectives.size(); ++o) {
+			const auto &objective = simple.input_data.objectives[o];
+			REQUIRE( -chromosomes[c].objectives[o] == Approx(objective.second * schedule.objectives[objective.first]) );
+		}
+	}
+}
+
+
+SCENARIO("algorithms::BatchRunner scenario sweep test")
+{
+	typedef types::SingleObjectiveChromosome<types::SingleSiteMultiSuiteGene> Chromosome;
+	typedef algorithms::BatchRunner<
+		algorithms::SingleObjectiveGA, 
+		Chromosome, 
+		deterministic::SingleSiteMultiSuiteModel, 
+		deterministic::SingleSiteMultiSuiteInputData
+	> Runner;
+
+	std::string data_dir(__FILE__);
+	data_dir = (data_dir.rfind('/') == std::string::npos ? "." : data_dir.substr(0, data_dir.rfind('/'))) + "/data/";
+
+	std::unordered_map<deterministic::OBJECTIVES, int> objectives;
+	objectives.emplace(deterministic::TOTAL_PROFIT, 1);
+
+	auto base = std::make_shared<const deterministic::SingleSiteMultiSuiteInputData>(
+		io::LoadSingleSiteMultiSuite(data_dir + "deterministic_single_site_multi_suite_ex1", "2016-11-02", objectives, 2, 2).input_data
+	);
+
+	algorithms::GAParams params;
+	params.num_runs = 3;
+	params.num_gens = 30;
+	params.popsize = 20;
+
+	std::vector<algorithms::Scenario<deterministic::SingleSiteMultiSuiteInputData>> scenarios(3);
+
+	scenarios[0].name = "base";
+	scenarios[1].name = "demand +20%";
+	scenarios[1].modify = [](deterministic::SingleSiteMultiSuiteInputData &input_data) {
+		for (auto &row : input_data.demand) {
+			for (auto &demand : row) demand = std::lround(demand * 1.2);
+		}
+	};
+	scenarios[2].name = "extra USP suite";
+	scenarios[2].modify = [](deterministic::SingleSiteMultiSuiteInputData &input_data) {
+		++input_data.num_usp_suites;
+	};
+
+	for (auto &scenario : scenarios) {
+		scenario.input_data = base;
+		scenario.params = params;
+	}
+
+	std::vector<std::string> finished;
+
+	utils::ThreadPool pool(4);
+	auto results = Runner(pool).Run(scenarios, [&finished](const algorithms::ScenarioResult<Chromosome> &result) {
+		finished.push_back(result.name);
+	});
+
+	REQUIRE( finished.size() == 3 );
+	REQUIRE( results[1].name == "demand +20%" );
+	REQUIRE( results[2].num_evaluations == 3 * 20 * 31 );
+	REQUIRE( base->num_usp_suites == 2 );
+
+	for (const auto &result : results) {
+		REQUIRE( result.solutions.size() == 1 );
+	}
+
+	// The results do not depend on the number of threads
+	utils::ThreadPool single_thread_pool(1);
+	auto serial_results = Runner(single_thread_pool).Run(scenarios);
+
+	for (int s = 0; s < results.size(); ++s) {
+		REQUIRE( serial_results[s].solutions[0].objective == Approx(results[s].solutions[0].objective) );
+	}
+
+	// A scenario without runs has an empty result, and a sweep waits for and
+	// rethrows the exceptions of its own tasks only
+	scenarios[2].params.num_runs = 0;
+	finished.clear();
+
+	pool.Submit([]() { throw std::runtime_error("task of another caller"); });
+
+	REQUIRE_NOTHROW(
+		results = Runner(pool).Run(scenarios, [&finished](const algorithms::ScenarioResult<Chromosome> &result) {
+			finished.push_back(result.name);
+		})
+	);
+
+	REQUIRE( finished.size() == 3 );
+	REQUIRE( finished[0] == "extra USP suite" );
+	REQUIRE( results[2].solutions.empty() );
+	REQUIRE( results[2].num_evaluations == 0 );
+	REQUIRE_THROWS( pool.Wait() );
+
+	int sum = 0;
+	std::mutex mutex;
+
+	for (int i = 1; i <= 100; ++i) {
+		pool.Submit([i, &sum, &mutex]() { std::lock_guard<std::mutex> lock(mutex); sum += i; });
+	}
+
+	pool.Submit([]() { throw std::runtime_error("failed task"); });
+
+	REQUIRE_THROWS( pool.Wait() );
+	REQUIRE( sum == 5050 );
+
+	// Workers which never call utils::set_seed get a seeded generator of their own
+	utils::ThreadPool unseeded_pool(2);
+	std::vector<double> numbers(8);
+
+	for (int i = 0; i < numbers.size(); ++i) {
+		unseeded_pool.Submit([i, &numbers]() { numbers[i] = utils::random(); });
+	}
+
+	REQUIRE_NOTHROW( unseeded_pool.Wait() );
+
+	for (double number : numbers) {
+		REQUIRE( number >= 0.0 );
+		REQUIRE( number < 1.0 );
+	}
+}